@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <print>
+#include <string_view>
+
+/**
+ * @namespace gps_lib::bench
+ * @brief Minimal timing helpers shared by the benchmark executables.
+ */
+namespace gps_lib::bench {
+/**
+ * @brief Keeps the compiler from discarding a value that is never read.
+ * @param value The value to keep.
+ * @return  void    This function does not return a value.
+ */
+template <typename T> void keep(const T &value) {
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Runs a workload several times and returns the fastest run, which
+ * is the least disturbed by the rest of the system.
+ * @param runs The number of runs.
+ * @param run The workload.
+ * @return  std::chrono::nanoseconds    The duration of the fastest run.
+ */
+template <typename Run>
+std::chrono::nanoseconds best_of(std::size_t runs, Run &&run) {
+  auto best = std::chrono::nanoseconds::max();
+
+  for (std::size_t i = 0; i < runs; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start));
+  }
+
+  return best;
+}
+
+/**
+ * @brief Prints the time per item and the throughput of a run.
+ * @param name The name of the measurement.
+ * @param items The number of items processed by the run.
+ * @param elapsed The duration of the run.
+ * @return  void    This function does not return a value.
+ */
+inline void report(std::string_view name, std::size_t items,
+                   std::chrono::nanoseconds elapsed) {
+  double ns = static_cast<double>(elapsed.count());
+  double count = static_cast<double>(items);
+
+  std::println("{:<32} {:>10} items {:>10.1f} ms {:>9.1f} ns/item "
+               "{:>8.2f} M/s",
+               name, items, ns / 1e6, ns / count, count / ns * 1e3);
+}
+} // namespace gps_lib::bench
@@ -0,0 +1,70 @@
+#include <cstddef>
+#include <fstream>
+#include <print>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "bench.h"
+#include "compact.h"
+#include "parse.h"
+
+int main() {
+  constexpr std::size_t COPIES{100}; ///< Copies of the sample log.
+  constexpr double CACHE_LINE{64.0};
+
+  std::vector<gps_lib::Sample> samples;
+  gps_lib::CompactBatch batch;
+  gps_lib::ParseContext context;
+
+  for (std::size_t copy = 0; copy < COPIES; ++copy) {
+    std::ifstream file{"data/samples.txt"};
+    for (std::string line; std::getline(file, line);) {
+      if (auto result = gps_lib::parse(line, context)) {
+        batch.push_back(*result);
+        samples.push_back(std::move(*result));
+      }
+    }
+  }
+
+  std::println("{:<32} {:>4} bytes {:>6.2f} samples/cache line", "Sample",
+               sizeof(gps_lib::Sample),
+               CACHE_LINE / sizeof(gps_lib::Sample));
+  std::println("{:<32} {:>4} bytes {:>6.2f} samples/cache line",
+               "CompactSample", sizeof(gps_lib::CompactSample),
+               CACHE_LINE / sizeof(gps_lib::CompactSample));
+
+  // The scan reads the latitude of every fix, as a track filter would.
+  double sum = 0.0;
+  auto elapsed = gps_lib::bench::best_of(5, [&] {
+    sum = 0.0;
+    for (const gps_lib::Sample &sample : samples) {
+      std::visit(
+          [&](const auto &data) {
+            using T = std::decay_t<decltype(data)>;
+            if constexpr (std::is_same_v<T, gps_lib::RMC> ||
+                          std::is_same_v<T, gps_lib::GLL>) {
+              sum += data.latitude.value;
+            }
+          },
+          sample);
+    }
+    gps_lib::bench::keep(sum);
+  });
+  gps_lib::bench::report("scan, Sample", samples.size(), elapsed);
+
+  double compact_sum = 0.0;
+  elapsed = gps_lib::bench::best_of(5, [&] {
+    compact_sum = 0.0;
+    for (const gps_lib::CompactSample &sample : batch.samples()) {
+      if (sample.header.type == gps_lib::SentenceType::RMC) {
+        compact_sum += sample.rmc.latitude / gps_lib::COMPACT_DEGREES;
+      } else if (sample.header.type == gps_lib::SentenceType::GLL) {
+        compact_sum += sample.gll.latitude / gps_lib::COMPACT_DEGREES;
+      }
+    }
+    gps_lib::bench::keep(compact_sum);
+  });
+  gps_lib::bench::report("scan, CompactSample", batch.size(), elapsed);
+}
@@ -0,0 +1,54 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "geofence.h"
+
+int main() {
+  constexpr std::size_t FENCES{5'000};
+  constexpr std::size_t SIDES{12};
+  constexpr std::size_t QUERIES{2'000'000};
+
+  // Twelve-sided fences of 100 m to 1 km scattered over a 1 degree square.
+  std::mt19937_64 random{42};
+  std::uniform_real_distribution<double> position{0.0, 1.0};
+  std::uniform_real_distribution<double> radius{0.001, 0.01};
+  gps_lib::GeofenceIndex index;
+  std::vector<gps_lib::Vertex> polygon(SIDES);
+
+  for (std::uint32_t id = 0; id < FENCES; ++id) {
+    double latitude = 40.0 + position(random);
+    double longitude = -4.0 + position(random);
+    double r = radius(random);
+    for (std::size_t side = 0; side < SIDES; ++side) {
+      double angle = 2.0 * std::numbers::pi * static_cast<double>(side) /
+                     static_cast<double>(SIDES);
+      polygon[side] = {latitude + r * std::sin(angle),
+                       longitude + r * std::cos(angle)};
+    }
+    index.add(id, polygon);
+  }
+  index.build();
+
+  std::vector<gps_lib::Vertex> queries(QUERIES);
+  for (gps_lib::Vertex &query : queries) {
+    query = {40.0 + position(random), -4.0 + position(random)};
+  }
+
+  std::size_t hits = 0;
+  auto elapsed = gps_lib::bench::best_of(5, [&] {
+    hits = 0;
+    for (const gps_lib::Vertex &query : queries) {
+      index.query(query.latitude, query.longitude,
+                  [&](std::uint32_t) { ++hits; });
+    }
+    gps_lib::bench::keep(hits);
+  });
+
+  gps_lib::bench::report("GeofenceIndex::query", QUERIES, elapsed);
+  std::println("{} of the queries fall inside a fence", hits);
+}
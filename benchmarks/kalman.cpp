@@ -0,0 +1,36 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "kalman.h"
+
+int main() {
+  constexpr std::size_t RECEIVERS{10'000};
+  constexpr std::size_t UPDATES{1'000'000};
+
+  // One fix per receiver per second, each a random step around Madrid.
+  std::mt19937_64 random{42};
+  std::normal_distribution<double> step{0.0, 1e-5};
+  std::vector<gps_lib::KalmanMeasurement> measurements;
+  std::vector<double> latitude(RECEIVERS, 40.4165);
+  std::vector<double> longitude(RECEIVERS, -3.7038);
+
+  measurements.reserve(UPDATES);
+  for (std::size_t i = 0; i < UPDATES; ++i) {
+    std::size_t receiver = i % RECEIVERS;
+    latitude[receiver] += step(random);
+    longitude[receiver] += step(random);
+    measurements.push_back({receiver, static_cast<double>(i / RECEIVERS),
+                            latitude[receiver], longitude[receiver], 1.2});
+  }
+
+  std::vector<gps_lib::KalmanEstimate> estimates(UPDATES);
+  auto elapsed = gps_lib::bench::best_of(5, [&] {
+    gps_lib::KalmanBank bank{RECEIVERS};
+    bank.update(measurements, estimates);
+    gps_lib::bench::keep(estimates);
+  });
+
+  gps_lib::bench::report("KalmanBank::update", UPDATES, elapsed);
+}
@@ -0,0 +1,55 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench.h"
+#include "uring.h"
+
+int main() {
+  constexpr std::size_t FILES{64};
+  constexpr std::size_t COPIES{10}; ///< Copies of the samples per file.
+
+  std::ifstream samples{"data/samples.txt"};
+  std::stringstream contents;
+  contents << samples.rdbuf();
+
+  std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "gps_lib_read_files";
+  std::filesystem::create_directories(directory);
+  std::vector<std::filesystem::path> paths;
+
+  for (std::size_t i = 0; i < FILES; ++i) {
+    paths.push_back(directory / ("log" + std::to_string(i) + ".nmea"));
+    std::ofstream log{paths.back()};
+    for (std::size_t copy = 0; copy < COPIES; ++copy) {
+      log << contents.str();
+    }
+  }
+
+  for (gps_lib::IoBackend backend :
+       {gps_lib::IoBackend::Posix, gps_lib::IoBackend::Uring}) {
+    gps_lib::IoStats stats;
+    auto elapsed = gps_lib::bench::best_of(3, [&] {
+      auto result = gps_lib::read_files(
+          paths, [](std::size_t, std::string_view, const gps_lib::Sample &) {},
+          backend);
+      if (result) {
+        stats = *result;
+      }
+    });
+
+    std::string_view name = stats.backend == gps_lib::IoBackend::Uring
+                                ? "read_files, io_uring"
+                                : "read_files, read()";
+    gps_lib::bench::report(name, stats.sentences, elapsed);
+    std::println("{:<32} {:.5f} syscalls/sentence", "",
+                 static_cast<double>(stats.syscalls) /
+                     static_cast<double>(stats.sentences));
+  }
+
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,129 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <netinet/in.h>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "detail/file_descriptor.h"
+#include "detail/socket.h"
+#include "server.h"
+#include "uring.h"
+
+namespace {
+constexpr std::size_t SENDERS{4'000};    ///< Simulated receivers.
+constexpr std::size_t DATAGRAMS{50};     ///< Datagrams per sender.
+constexpr std::size_t SENDER_THREADS{4}; ///< Threads driving the senders.
+constexpr std::size_t IN_FLIGHT{4'096};  ///< Datagrams sent ahead of reads.
+
+/**
+ * @brief Counts the sentences a server dispatches.
+ */
+struct Counter {
+  std::atomic<std::size_t> *sentences;
+
+  void operator()(std::uint64_t, std::string_view,
+                  const gps_lib::Sample &) const {
+    sentences->fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief Opens one UDP socket per simulated receiver, each on its own
+ * loopback address so the server sees thousands of distinct sources.
+ */
+std::vector<gps_lib::detail::FileDescriptor> open_senders() {
+  std::vector<gps_lib::detail::FileDescriptor> senders;
+
+  for (std::size_t i = 0; i < SENDERS; ++i) {
+    auto source = gps_lib::detail::make_address(
+        "127.0." + std::to_string(i / 250) + "." + std::to_string(i % 250 + 1),
+        0);
+    gps_lib::detail::FileDescriptor sender{::socket(AF_INET, SOCK_DGRAM, 0)};
+    ::bind(sender.get(), reinterpret_cast<const sockaddr *>(&*source),
+           sizeof(*source));
+    senders.push_back(std::move(sender));
+  }
+
+  return senders;
+}
+
+/**
+ * @brief Starts a server, sends DATAGRAMS sentences from every sender to it
+ * and reports the throughput and system calls per sentence.
+ */
+template <template <typename> typename Server>
+void run(const std::vector<gps_lib::detail::FileDescriptor> &senders) {
+  static constexpr std::string_view SENTENCE{
+      "$GNRMC,211041.00,A,4024.98796,N,00340.22512,W,0.027,,010218,,,D*7B\r\n"};
+
+  gps_lib::ServerOptions options;
+  options.port = 0;
+  options.threads = 2;
+  options.tcp = false;
+  options.receive_buffer = 8 << 20;
+
+  std::atomic<std::size_t> sentences{0};
+  Server<Counter> server{options, Counter{&sentences}};
+  if (!server.start()) {
+    std::println("Could not start the server.");
+    return;
+  }
+
+  auto address = gps_lib::detail::make_address("127.0.0.1", server.port());
+  std::atomic<std::size_t> sent{0};
+  std::size_t total = SENDERS * DATAGRAMS;
+  auto start = std::chrono::steady_clock::now();
+
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t t = 0; t < SENDER_THREADS; ++t) {
+      threads.emplace_back([&, t] {
+        for (std::size_t round = 0; round < DATAGRAMS; ++round) {
+          for (std::size_t i = t; i < SENDERS; i += SENDER_THREADS) {
+            // Keep at most IN_FLIGHT datagrams queued so none are dropped.
+            while (sent.load(std::memory_order_relaxed) >=
+                   sentences.load(std::memory_order_relaxed) + IN_FLIGHT) {
+              std::this_thread::yield();
+            }
+            ::sendto(senders[i].get(), SENTENCE.data(), SENTENCE.size(), 0,
+                     reinterpret_cast<const sockaddr *>(&*address),
+                     sizeof(*address));
+            sent.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+  while (sentences.load() < total &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  gps_lib::ServerStats stats = server.stats();
+
+  std::string_view name = server.backend() == gps_lib::IoBackend::Uring
+                              ? "UDP ingest, io_uring"
+                              : "UDP ingest, epoll";
+  gps_lib::bench::report(name, stats.sentences, elapsed);
+  std::println("{:<32} {:.3f} syscalls/sentence, {} lost, {} evictions", "",
+               static_cast<double>(stats.syscalls) /
+                   static_cast<double>(stats.sentences),
+               total - stats.sentences, stats.evictions);
+}
+} // namespace
+
+int main() {
+  std::vector<gps_lib::detail::FileDescriptor> senders = open_senders();
+
+  run<gps_lib::IngestServer>(senders);
+  run<gps_lib::UringIngestServer>(senders);
+}
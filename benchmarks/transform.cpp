@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "transform.h"
+
+int main() {
+  constexpr std::size_t POINTS{1'000'000};
+  constexpr std::size_t RUNS{5};
+
+  // Positions within about 50 km of Madrid, all in UTM zone 30N.
+  std::mt19937_64 random{42};
+  std::uniform_real_distribution<double> offset{-0.5, 0.5};
+  std::uniform_real_distribution<double> height{500.0, 800.0};
+  gps_lib::GeodeticBatch batch;
+
+  for (std::size_t i = 0; i < POINTS; ++i) {
+    batch.push_back(40.4165 + offset(random), -3.7038 + offset(random),
+                    height(random));
+  }
+
+  std::vector<double> x(POINTS), y(POINTS), z(POINTS);
+  std::vector<double> latitude(POINTS), longitude(POINTS), h(POINTS);
+
+  auto elapsed = gps_lib::bench::best_of(RUNS, [&] {
+    gps_lib::geodetic_to_ecef(batch.latitude, batch.longitude, batch.height,
+                              x, y, z);
+    gps_lib::bench::keep(x);
+  });
+  gps_lib::bench::report("geodetic_to_ecef", POINTS, elapsed);
+
+  elapsed = gps_lib::bench::best_of(RUNS, [&] {
+    gps_lib::ecef_to_geodetic(x, y, z, latitude, longitude, h);
+    gps_lib::bench::keep(latitude);
+  });
+  gps_lib::bench::report("ecef_to_geodetic", POINTS, elapsed);
+
+  gps_lib::EnuFrame frame{40.4165, -3.7038, 650.0};
+  elapsed = gps_lib::bench::best_of(RUNS, [&] {
+    frame.from_geodetic(batch, x, y, z);
+    gps_lib::bench::keep(x);
+  });
+  gps_lib::bench::report("EnuFrame::from_geodetic", POINTS, elapsed);
+
+  gps_lib::UtmZone zone = gps_lib::UtmZone::containing(40.4165, -3.7038);
+  elapsed = gps_lib::bench::best_of(RUNS, [&] {
+    zone.forward(batch.latitude, batch.longitude, x, y);
+    gps_lib::bench::keep(x);
+  });
+  gps_lib::bench::report("UtmZone::forward", POINTS, elapsed);
+
+  elapsed = gps_lib::bench::best_of(RUNS, [&] {
+    zone.inverse(x, y, latitude, longitude);
+    gps_lib::bench::keep(latitude);
+  });
+  gps_lib::bench::report("UtmZone::inverse", POINTS, elapsed);
+
+  double error = 0.0;
+  for (std::size_t i = 0; i < POINTS; ++i) {
+    error = std::max({error, std::abs(latitude[i] - batch.latitude[i]),
+                      std::abs(longitude[i] - batch.longitude[i])});
+  }
+  std::println("UTM round trip error: {:.2e} degrees", error);
+}
@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <print>
+#include <string>
+#include <string_view>
+
+#include "bench.h"
+#include "fix.h"
+#include "framer.h"
+#include "parse.h"
+#include "tools.h"
+#include "ubx.h"
+
+namespace {
+/**
+ * @brief Builds the UBX-NAV-PVT payload a receiver would send for a fix.
+ * @param fix The fix.
+ * @return  std::string     The payload.
+ */
+std::string nav_pvt_payload(const gps_lib::Fix &fix) {
+  using namespace std::chrono;
+
+  std::string payload(gps_lib::UbxNavPvt::SIZE, '\0');
+  auto put = [&](std::size_t offset, auto value) {
+    auto bits = static_cast<std::uint64_t>(value);
+    for (std::size_t i = 0; i < sizeof(value); ++i) {
+      payload[offset + i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+  };
+
+  sys_days day = floor<days>(fix.utc_time);
+  year_month_day date{day};
+  hh_mm_ss time{fix.utc_time - day};
+
+  put(4, static_cast<std::uint16_t>(static_cast<int>(date.year())));
+  put(6, static_cast<std::uint8_t>(static_cast<unsigned>(date.month())));
+  put(7, static_cast<std::uint8_t>(static_cast<unsigned>(date.day())));
+  put(8, static_cast<std::uint8_t>(time.hours().count()));
+  put(9, static_cast<std::uint8_t>(time.minutes().count()));
+  put(10, static_cast<std::uint8_t>(time.seconds().count()));
+  put(11, std::uint8_t{0x03}); // validDate and validTime
+  put(16, static_cast<std::int32_t>(
+              duration_cast<nanoseconds>(time.subseconds()).count()));
+  put(20, std::uint8_t{3}); // 3D fix
+  put(21, std::uint8_t{1}); // gnssFixOK
+  put(24, static_cast<std::int32_t>(std::lround(fix.longitude * 1e7)));
+  put(28, static_cast<std::int32_t>(std::lround(fix.latitude * 1e7)));
+  if (!std::isnan(fix.speed)) {
+    put(60, static_cast<std::int32_t>(std::lround(fix.speed * 1e3)));
+  }
+
+  return payload;
+}
+} // namespace
+
+int main() {
+  constexpr std::size_t ROUNDS{100}; ///< Passes over each stream per run.
+
+  // The same fixes, once as the NMEA sentences of the sample log and once
+  // as the UBX-NAV-PVT frames a receiver would send instead.
+  std::ifstream file{"data/samples.txt"};
+  gps_lib::ParseContext context;
+  std::string nmea;
+  std::string ubx;
+
+  for (std::string line; std::getline(file, line);) {
+    auto sample = gps_lib::parse(line, context);
+    if (!sample) {
+      continue;
+    }
+    if (auto fix = gps_lib::to_fix(*sample)) {
+      nmea.append(line).append("\r\n");
+      gps_lib::encode_ubx(ubx, gps_lib::UBX_CLASS_NAV,
+                          gps_lib::UBX_ID_NAV_PVT, nav_pvt_payload(*fix));
+    }
+  }
+
+  // Both sides pay for framing: SentenceFramer then parse() for NMEA, and
+  // MixedFramer, whose decode_ubx() checks each frame, then UbxNavPvt for
+  // UBX.
+  std::size_t fixes = 0;
+  auto elapsed = gps_lib::bench::best_of(5, [&] {
+    gps_lib::SentenceFramer<> framer;
+    gps_lib::ParseContext stream;
+    fixes = 0;
+
+    for (std::size_t round = 0; round < ROUNDS; ++round) {
+      framer.push(nmea, [&](std::string_view sentence) {
+        auto sample = gps_lib::parse(sentence, stream);
+        if (sample && gps_lib::to_fix(*sample)) {
+          ++fixes;
+        }
+      });
+    }
+    gps_lib::bench::keep(fixes);
+  });
+  gps_lib::bench::report("fixes, NMEA", fixes, elapsed);
+  std::println("{:<32} {:.1f} bytes/fix", "",
+               static_cast<double>(nmea.size() * ROUNDS) /
+                   static_cast<double>(fixes));
+
+  std::size_t ubx_fixes = 0;
+  elapsed = gps_lib::bench::best_of(5, [&] {
+    gps_lib::MixedFramer<> framer;
+    ubx_fixes = 0;
+
+    for (std::size_t round = 0; round < ROUNDS; ++round) {
+      framer.push(ubx, gps_lib::overloaded{
+                           [](std::string_view) {},
+                           [&](const gps_lib::UbxFrame &frame) {
+                             auto pvt = gps_lib::UbxNavPvt::from(frame);
+                             if (pvt && gps_lib::to_fix(*pvt)) {
+                               ++ubx_fixes;
+                             }
+                           }});
+    }
+    gps_lib::bench::keep(ubx_fixes);
+  });
+  gps_lib::bench::report("fixes, UBX-NAV-PVT", ubx_fixes, elapsed);
+  std::println("{:<32} {:.1f} bytes/fix", "",
+               static_cast<double>(ubx.size() * ROUNDS) /
+                   static_cast<double>(ubx_fixes));
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Replaces the global operator new and delete with versions that
+ * count the allocations of each thread, read with allocation_count().
+ *
+ * Use it once, at namespace scope, in the translation unit holding main():
+ * a program may replace the global allocation functions only once.
+ */
+#define GPS_LIB_COUNT_ALLOCATIONS()                                            \
+  void *operator new(std::size_t size) {                                       \
+    return ::gps_lib::detail::counted_allocate(size);                          \
+  }                                                                            \
+  void *operator new(std::size_t size, std::align_val_t alignment) {           \
+    return ::gps_lib::detail::counted_allocate(                                \
+        size, static_cast<std::size_t>(alignment));                            \
+  }                                                                            \
+  void operator delete(void *pointer) noexcept { std::free(pointer); }         \
+  void operator delete(void *pointer, std::size_t) noexcept {                  \
+    std::free(pointer);                                                        \
+  }                                                                            \
+  void operator delete(void *pointer, std::align_val_t) noexcept {             \
+    std::free(pointer);                                                        \
+  }                                                                            \
+  void operator delete(void *pointer, std::size_t,                             \
+                       std::align_val_t) noexcept {                            \
+    std::free(pointer);                                                        \
+  }                                                                            \
+  static_assert(true, "")
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Heap allocations made through operator new.
+ */
+struct AllocationCount {
+  std::size_t allocations{0}; ///< Number of allocations.
+  std::size_t bytes{0};       ///< Bytes requested.
+};
+
+namespace detail {
+/**
+ * @brief Returns the allocation counters of the calling thread.
+ * @return  AllocationCount&    The counters.
+ */
+inline AllocationCount &thread_allocations() {
+  thread_local AllocationCount count;
+  return count;
+}
+
+/**
+ * @brief Allocates memory for the replaced operator new and counts it.
+ * @param size The number of bytes requested.
+ * @param alignment The alignment required.
+ * @return  void*   The memory.
+ * @throws std::bad_alloc If the memory cannot be allocated.
+ */
+inline void *
+counted_allocate(std::size_t size,
+                 std::size_t alignment = alignof(std::max_align_t)) {
+  AllocationCount &count = thread_allocations();
+  ++count.allocations;
+  count.bytes += size;
+
+  // aligned_alloc needs a non-zero multiple of the alignment.
+  std::size_t rounded = (std::max<std::size_t>(size, 1) + alignment - 1) /
+                        alignment * alignment;
+  void *pointer = alignment <= alignof(std::max_align_t)
+                      ? std::malloc(rounded)
+                      : std::aligned_alloc(alignment, rounded);
+
+  if (pointer == nullptr) {
+    throw std::bad_alloc{};
+  }
+  return pointer;
+}
+} // namespace detail
+
+/**
+ * @brief Returns the allocations the calling thread has made so far.
+ *
+ * Only counts once GPS_LIB_COUNT_ALLOCATIONS() has replaced operator new;
+ * otherwise it stays at zero.
+ *
+ * @return  AllocationCount     The counters of the calling thread.
+ */
+inline AllocationCount allocation_count() {
+  return detail::thread_allocations();
+}
+
+/**
+ * @brief Counts the allocations the calling thread makes while running a
+ * function.
+ * @param function The function to run.
+ * @return  AllocationCount     The allocations made by the function.
+ */
+template <typename Function>
+AllocationCount count_allocations(Function &&function) {
+  AllocationCount before = allocation_count();
+  std::forward<Function>(function)();
+  AllocationCount after = allocation_count();
+
+  return {after.allocations - before.allocations, after.bytes - before.bytes};
+}
+} // namespace gps_lib
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief A monotonic arena that holds a batch of parsed samples.
+ *
+ * Pointing a ParseContext at the arena makes every string and vector of the
+ * parsed sentences allocate from one growing block list instead of the
+ * global heap. Frees are no-ops, and reset() releases the whole batch at
+ * once. The first block is kept across resets, so a daemon that parses
+ * batches of similar size stops allocating once it is warm.
+ *
+ * @code
+ * SampleArena arena;
+ * ParseContext context{.resource = arena.resource()};
+ *
+ * for (const std::string &line : lines) {
+ *   if (auto sample = parse(line, context)) {
+ *     arena.samples().push_back(std::move(*sample));
+ *   }
+ * }
+ * consume(arena.samples());
+ * arena.reset();
+ * @endcode
+ */
+class SampleArena {
+public:
+  /**
+   * @brief Default size of the first block, which holds a batch of about a
+   * thousand sentences without going to the default resource.
+   */
+  static constexpr std::size_t DEFAULT_SIZE{1024 * 1024};
+
+  /**
+   * @brief Constructs an arena.
+   * @param size The size in bytes of the first block. Further blocks are
+   * taken from the default resource as the batch grows.
+   */
+  explicit SampleArena(std::size_t size = DEFAULT_SIZE)
+      : buffer_{std::make_unique_for_overwrite<std::byte[]>(size)},
+        resource_{buffer_.get(), size}, samples_{&resource_} {}
+
+  SampleArena(const SampleArena &) = delete;
+  SampleArena &operator=(const SampleArena &) = delete;
+
+  /**
+   * @brief Returns the memory resource to parse into.
+   * @return  std::pmr::memory_resource*  The arena.
+   */
+  std::pmr::memory_resource *resource() { return &resource_; }
+
+  /**
+   * @brief Returns the samples of the batch. They, and anything else
+   * allocated from the arena, are valid until reset().
+   * @return  std::pmr::vector<Sample>&   The samples, stored in the arena.
+   */
+  std::pmr::vector<Sample> &samples() { return samples_; }
+
+  /**
+   * @brief Releases the batch. Objects allocated from the arena outside of
+   * samples() must be destroyed first.
+   * @return  void    This function does not return a value.
+   */
+  void reset() {
+    // Swapping in an empty vector drops the storage before it is released.
+    std::pmr::vector<Sample>{&resource_}.swap(samples_);
+    resource_.release();
+  }
+
+private:
+  std::unique_ptr<std::byte[]> buffer_;          ///< First block.
+  std::pmr::monotonic_buffer_resource resource_; ///< Block list.
+  std::pmr::vector<Sample> samples_;             ///< Samples of the batch.
+};
+} // namespace gps_lib
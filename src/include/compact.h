@@ -0,0 +1,1131 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "detail/parse_number.h"
+#include "intern.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Marks a numeric field of a compact record as empty.
+ * @tparam T The type of the field.
+ */
+template <typename T>
+constexpr T COMPACT_MISSING{std::numeric_limits<T>::max()};
+
+/**
+ * @brief Scale of compact latitudes and longitudes, in units per degree.
+ */
+constexpr double COMPACT_DEGREES{1e7};
+
+/**
+ * @brief Mode indicators a compact GNS record can hold; code 0 ends the list
+ * and code i stands for GNS_MODES[i - 1].
+ */
+constexpr std::string_view GNS_MODES{"NADPRFEMS"};
+
+/**
+ * @brief The fields every compact record starts with.
+ */
+struct CompactHeader {
+  SentenceType type;          ///< Sentence type.
+  std::array<char, 2> talker; ///< Talker identifier, e.g. "GP".
+};
+
+/**
+ * @brief Compact GGA record. Times are the day since the epoch plus the
+ * milliseconds into it, coordinates are in 1e-7 degrees, heights in mm and
+ * dilutions in hundredths.
+ */
+struct CompactGGA {
+  SentenceType type;            ///< Always SentenceType::GGA.
+  std::array<char, 2> talker;   ///< Talker identifier.
+  char quality;                 ///< GPS fix quality indicator.
+  std::uint16_t day;            ///< UTC day since 1970-01-01.
+  std::uint16_t dgps_station;   ///< Differential reference station.
+  std::uint32_t milliseconds;   ///< UTC time of day.
+  std::int32_t latitude;        ///< Latitude, negative south.
+  std::int32_t longitude;       ///< Longitude, negative west.
+  std::int32_t altitude;        ///< Altitude.
+  std::int32_t separation;      ///< Geoidal separation.
+  std::uint16_t hdop;           ///< Horizontal dilution of precision.
+  std::uint8_t satellites_used; ///< Satellites used for the fix.
+  std::uint8_t reserved;        ///< Padding, always zero.
+};
+
+/**
+ * @brief Compact GLL record.
+ */
+struct CompactGLL {
+  SentenceType type;          ///< Always SentenceType::GLL.
+  std::array<char, 2> talker; ///< Talker identifier.
+  char status;                ///< 'A' for active, 'V' for void.
+  std::uint16_t day;          ///< UTC day since 1970-01-01.
+  std::uint16_t reserved;     ///< Padding, always zero.
+  std::uint32_t milliseconds; ///< UTC time of day.
+  std::int32_t latitude;      ///< Latitude in 1e-7 degrees, negative south.
+  std::int32_t longitude;     ///< Longitude in 1e-7 degrees, negative west.
+};
+
+/**
+ * @brief Compact GSA record. The satellites are stored out of line, see
+ * CompactBatch::satellites().
+ */
+struct CompactGSA {
+  SentenceType type;          ///< Always SentenceType::GSA.
+  std::array<char, 2> talker; ///< Talker identifier.
+  char mode;                  ///< Selection mode.
+  char fix_type;              ///< '1' = no fix, '2' = 2D fix, '3' = 3D fix.
+  std::uint8_t count;         ///< Number of satellites used.
+  std::uint16_t pdop;         ///< Position dilution in hundredths.
+  std::uint16_t hdop;         ///< Horizontal dilution in hundredths.
+  std::uint16_t vdop;         ///< Vertical dilution in hundredths.
+  std::uint32_t first;        ///< Index of the first satellite.
+};
+
+/**
+ * @brief Compact GSV record. The satellites are stored out of line, see
+ * CompactBatch::satellites().
+ */
+struct CompactGSV {
+  SentenceType type;               ///< Always SentenceType::GSV.
+  std::array<char, 2> talker;      ///< Talker identifier.
+  std::uint8_t number_of_messages; ///< Total number of messages.
+  std::uint8_t sequence_number;    ///< Sequence number of this message.
+  std::uint8_t satellites_in_view; ///< Number of satellites in view.
+  std::uint8_t count;              ///< Number of satellites in this message.
+  std::uint8_t reserved;           ///< Padding, always zero.
+  std::uint32_t first;             ///< Index of the first satellite.
+};
+
+/**
+ * @brief Compact RMC record. The speed is in thousandths of a knot and the
+ * course in hundredths of a degree.
+ */
+struct CompactRMC {
+  SentenceType type;          ///< Always SentenceType::RMC.
+  std::array<char, 2> talker; ///< Talker identifier.
+  char status;                ///< 'A' for active, 'V' for void.
+  std::uint16_t day;          ///< UTC day since 1970-01-01.
+  char mode;                  ///< Mode indicator.
+  std::uint8_t reserved;      ///< Padding, always zero.
+  std::uint32_t milliseconds; ///< UTC time of day.
+  std::int32_t latitude;      ///< Latitude in 1e-7 degrees, negative south.
+  std::int32_t longitude;     ///< Longitude in 1e-7 degrees, negative west.
+  std::int32_t speed;         ///< Speed over ground.
+  std::uint16_t course;       ///< Course over ground.
+  std::uint16_t reserved2;    ///< Padding, always zero.
+};
+
+/**
+ * @brief Compact VTG record.
+ */
+struct CompactVTG {
+  SentenceType type;             ///< Always SentenceType::VTG.
+  std::array<char, 2> talker;    ///< Talker identifier.
+  char mode;                     ///< Mode indicator.
+  std::uint16_t course;          ///< True course in hundredths of a degree.
+  std::uint16_t course_magnetic; ///< Magnetic course, likewise.
+  std::int32_t speed_kn;         ///< Speed in thousandths of a knot.
+  std::int32_t speed_kh;         ///< Speed in thousandths of a km/h.
+};
+
+/**
+ * @brief Compact ZDA record.
+ */
+struct CompactZDA {
+  SentenceType type;               ///< Always SentenceType::ZDA.
+  std::array<char, 2> talker;      ///< Talker identifier.
+  std::uint8_t reserved;           ///< Padding, always zero.
+  std::uint16_t day;               ///< UTC day since 1970-01-01.
+  std::int8_t local_zone_hours;    ///< Local zone hours.
+  std::uint8_t local_zone_minutes; ///< Local zone minutes.
+  std::uint32_t milliseconds;      ///< UTC time of day.
+};
+
+/**
+ * @brief Compact GST record. Errors are in mm, up to 65 m, and the orientation
+ * in hundredths of a degree.
+ */
+struct CompactGST {
+  SentenceType type;             ///< Always SentenceType::GST.
+  std::array<char, 2> talker;    ///< Talker identifier.
+  std::uint8_t reserved;         ///< Padding, always zero.
+  std::uint16_t day;             ///< UTC day since 1970-01-01.
+  std::uint16_t rms;             ///< RMS of the pseudorange residuals.
+  std::uint32_t milliseconds;    ///< UTC time of day.
+  std::uint16_t semi_major;      ///< Error ellipse semi-major axis.
+  std::uint16_t semi_minor;      ///< Error ellipse semi-minor axis.
+  std::uint16_t orientation;     ///< Error ellipse orientation.
+  std::uint16_t latitude_error;  ///< Latitude standard deviation.
+  std::uint16_t longitude_error; ///< Longitude standard deviation.
+  std::uint16_t altitude_error;  ///< Altitude standard deviation.
+};
+
+/**
+ * @brief Compact GBS record. Errors and the bias are in cm and the
+ * probability in ten-thousandths.
+ */
+struct CompactGBS {
+  SentenceType type;             ///< Always SentenceType::GBS.
+  std::array<char, 2> talker;    ///< Talker identifier.
+  std::uint8_t reserved;         ///< Padding, always zero.
+  std::uint16_t day;             ///< UTC day since 1970-01-01.
+  std::uint16_t failed;          ///< ID of the likely failed one, or 0.
+  std::uint32_t milliseconds;    ///< UTC time of day.
+  std::uint16_t latitude_error;  ///< Expected latitude error.
+  std::uint16_t longitude_error; ///< Expected longitude error.
+  std::uint16_t altitude_error;  ///< Expected altitude error.
+  std::uint16_t probability;     ///< Probability of missed detection.
+  std::int16_t bias;             ///< Estimated bias of the satellite.
+  std::uint16_t bias_deviation;  ///< Standard deviation of the bias.
+  char system_id;                ///< GNSS system ID, '\0' if not reported.
+  char signal_id;                ///< GNSS signal ID, '\0' if not reported.
+  std::uint16_t reserved2;       ///< Padding, always zero.
+};
+
+/**
+ * @brief Compact GNS record, scaled like CompactGGA.
+ */
+struct CompactGNS {
+  SentenceType type;            ///< Always SentenceType::GNS.
+  std::array<char, 2> talker;   ///< Talker identifier.
+  std::uint8_t satellites_used; ///< Satellites used for the fix.
+  std::uint16_t day;            ///< UTC day since 1970-01-01.
+  std::uint16_t hdop;           ///< Horizontal dilution of precision.
+  std::uint32_t milliseconds;   ///< UTC time of day.
+  std::int32_t latitude;        ///< Latitude, negative south.
+  std::int32_t longitude;       ///< Longitude, negative west.
+  std::int32_t altitude;        ///< Altitude.
+  std::int32_t separation;      ///< Geoidal separation.
+  std::uint16_t mode;           ///< Mode indicators, see GNS_MODES.
+  std::uint16_t dgps_station;   ///< Differential reference station.
+};
+
+/**
+ * @brief Compact RMB record. Distances are in hundredths of a nautical mile,
+ * the bearing in hundredths of a degree and the velocity in hundredths of a
+ * knot. The waypoint IDs are stored out of line, see CompactBatch::origin()
+ * and CompactBatch::destination().
+ */
+struct CompactRMB {
+  SentenceType type;             ///< Always SentenceType::RMB.
+  std::array<char, 2> talker;    ///< Talker identifier.
+  char status;                   ///< 'A' for valid, 'V' for warning.
+  char steer;                    ///< Direction to steer ('L' or 'R').
+  char arrival;                  ///< 'A' if arrived, 'V' otherwise.
+  char mode;                     ///< Mode indicator.
+  std::uint8_t reserved;         ///< Padding, always zero.
+  std::uint16_t cross_track;     ///< Cross-track error.
+  std::uint16_t bearing;         ///< True bearing to the destination.
+  std::int32_t latitude;         ///< Destination latitude in 1e-7 degrees.
+  std::int32_t longitude;        ///< Destination longitude in 1e-7 degrees.
+  std::uint32_t range;           ///< Range to the destination.
+  std::int16_t closing_velocity; ///< Closing velocity.
+  std::uint8_t origin_size;      ///< Characters of the origin ID.
+  std::uint8_t destination_size; ///< Characters of the destination ID.
+  std::uint32_t first;           ///< Index of the origin ID, then the other.
+};
+
+/**
+ * @brief Compact HDT record.
+ */
+struct CompactHDT {
+  SentenceType type;          ///< Always SentenceType::HDT.
+  std::array<char, 2> talker; ///< Talker identifier.
+  std::uint8_t reserved;      ///< Padding, always zero.
+  std::uint16_t heading;      ///< True heading in hundredths of a degree.
+  std::uint16_t reserved2;    ///< Padding, always zero.
+};
+
+/**
+ * @brief A satellite of a compact GSA or GSV record. GSA records only set
+ * the identifier.
+ */
+struct CompactSatellite {
+  std::uint16_t id;       ///< Satellite ID, 0 if empty.
+  std::uint16_t azimuth;  ///< Azimuth in degrees.
+  std::uint8_t elevation; ///< Elevation in degrees.
+  std::uint8_t snr;       ///< Signal-to-noise ratio in dB-Hz.
+};
+
+/**
+ * @brief A parsed sentence as a fixed-size, trivially copyable record.
+ *
+ * Every record starts with the fields of CompactHeader, so header.type tells
+ * which member is active. Two records fit in a cache line, against less than
+ * one Sample.
+ */
+union CompactSample {
+  CompactHeader header; ///< Type and talker, valid for every record.
+  CompactGGA gga;       ///< Active if header.type is SentenceType::GGA.
+  CompactGLL gll;       ///< Active if header.type is SentenceType::GLL.
+  CompactGSA gsa;       ///< Active if header.type is SentenceType::GSA.
+  CompactGSV gsv;       ///< Active if header.type is SentenceType::GSV.
+  CompactRMC rmc;       ///< Active if header.type is SentenceType::RMC.
+  CompactVTG vtg;       ///< Active if header.type is SentenceType::VTG.
+  CompactZDA zda;       ///< Active if header.type is SentenceType::ZDA.
+  CompactGST gst;       ///< Active if header.type is SentenceType::GST.
+  CompactGBS gbs;       ///< Active if header.type is SentenceType::GBS.
+  CompactGNS gns;       ///< Active if header.type is SentenceType::GNS.
+  CompactRMB rmb;       ///< Active if header.type is SentenceType::RMB.
+  CompactHDT hdt;       ///< Active if header.type is SentenceType::HDT.
+};
+
+static_assert(std::is_trivially_copyable_v<CompactSample> &&
+                  std::is_standard_layout_v<CompactSample>,
+              "Compact samples must be plain data");
+static_assert(sizeof(CompactSample) == 32 && alignof(CompactSample) == 4,
+              "Two compact samples must share a cache line");
+static_assert(sizeof(CompactSatellite) == 6,
+              "Compact satellites must stay packed");
+static_assert(static_cast<std::size_t>(SentenceType::HDT) + 1 ==
+                  std::variant_size_v<Sample>,
+              "Every Sample alternative needs a compact record");
+
+namespace detail {
+/**
+ * @brief Converts a numeric field to fixed point.
+ * @param field The field.
+ * @param scale Units per unit of the field.
+ * @return  T       The scaled value, or COMPACT_MISSING<T> if the field is
+ * empty, not numeric or out of range.
+ */
+template <typename T> T pack(std::string_view field, double scale = 1.0) {
+  std::optional<double> value = parse_number(field);
+  if (!value) {
+    return COMPACT_MISSING<T>;
+  }
+
+  double scaled = std::round(*value * scale);
+  if (!(scaled >= static_cast<double>(std::numeric_limits<T>::min()) &&
+        scaled < static_cast<double>(COMPACT_MISSING<T>))) {
+    return COMPACT_MISSING<T>;
+  }
+
+  return static_cast<T>(scaled);
+}
+
+/**
+ * @brief Formats a fixed-point value as a numeric field.
+ * @param buffer The storage of the text.
+ * @param value The scaled value.
+ * @param decimals Decimal digits of the scale, which is 10^decimals.
+ * @return  std::string_view    The field, in the buffer; empty for
+ * COMPACT_MISSING<T>.
+ */
+template <typename T>
+std::string_view format_fixed(std::array<char, 32> &buffer, T value,
+                              int decimals) {
+  if (value == COMPACT_MISSING<T>) {
+    return {};
+  }
+
+  auto [end, error] = std::to_chars(
+      buffer.data(), buffer.data() + buffer.size(),
+      static_cast<double>(value) / std::pow(10.0, decimals),
+      std::chars_format::fixed, decimals);
+  return {buffer.data(), end};
+}
+
+/**
+ * @brief Converts a fixed-point value back to a numeric field.
+ * @param field The field to overwrite.
+ * @param value The scaled value.
+ * @param decimals Decimal digits of the scale, which is 10^decimals.
+ * @return  void    This function does not return a value.
+ */
+template <typename T>
+void unpack(std::pmr::string &field, T value, int decimals = 0) {
+  std::array<char, 32> buffer;
+  field.assign(format_fixed(buffer, value, decimals));
+}
+
+/**
+ * @brief Returns the first character of a field, or '\0' if it is empty.
+ * @param field The field.
+ * @return  char    The character.
+ */
+inline char pack_char(std::string_view field) {
+  return field.empty() ? '\0' : field.front();
+}
+
+/**
+ * @brief Converts a character back to a field.
+ * @param field The field to overwrite.
+ * @param value The character, '\0' for an empty field.
+ * @return  void    This function does not return a value.
+ */
+inline void unpack_char(std::pmr::string &field, char value) {
+  field.assign(value == '\0' ? 0u : 1u, value);
+}
+
+/**
+ * @brief Splits a timestamp into a day and a time of day.
+ * @param time The timestamp.
+ * @param day Receives the day since 1970-01-01.
+ * @param milliseconds Receives the milliseconds into the day.
+ * @return  void    This function does not return a value.
+ */
+inline void pack_time(Timestamp time, std::uint16_t &day,
+                      std::uint32_t &milliseconds) {
+  auto date = std::chrono::floor<std::chrono::days>(time);
+  day = static_cast<std::uint16_t>(date.time_since_epoch().count());
+  milliseconds = static_cast<std::uint32_t>((time - date).count());
+}
+
+/**
+ * @brief Joins a day and a time of day into a timestamp.
+ * @param day The day since 1970-01-01.
+ * @param milliseconds The milliseconds into the day.
+ * @return  Timestamp       The timestamp.
+ */
+inline Timestamp unpack_time(std::uint16_t day, std::uint32_t milliseconds) {
+  return std::chrono::sys_days{std::chrono::days{day}} +
+         std::chrono::milliseconds{milliseconds};
+}
+
+/**
+ * @brief Converts a coordinate to 1e-7 degrees.
+ * @param degrees The coordinate in decimal degrees.
+ * @return  std::int32_t    The coordinate in 1e-7 degrees.
+ */
+inline std::int32_t pack_degrees(double degrees) {
+  return static_cast<std::int32_t>(std::lround(degrees * COMPACT_DEGREES));
+}
+
+/**
+ * @brief Returns the talker identifier of a sentence address.
+ * @param type The address.
+ * @return  std::array<char, 2>     The talker, e.g. "GP" or "BD".
+ */
+inline std::array<char, 2> pack_talker(Address type) {
+  std::string_view name = talker_name(type);
+  return {name[0], name[1]};
+}
+
+/**
+ * @brief Packs the mode indicators of a GNS sentence, one per constellation,
+ * as 4-bit codes. Indicators past the fourth, or outside GNS_MODES, are
+ * dropped.
+ * @param modes The mode field, e.g. "AAN".
+ * @return  std::uint16_t   The codes, the first in the low bits.
+ */
+inline std::uint16_t pack_modes(std::string_view modes) {
+  std::uint16_t packed = 0;
+
+  for (std::size_t i = 0; i < 4 && i < modes.size(); ++i) {
+    std::size_t code = GNS_MODES.find(modes[i]);
+    if (code == std::string_view::npos) {
+      break;
+    }
+    packed |= static_cast<std::uint16_t>((code + 1) << (4 * i));
+  }
+
+  return packed;
+}
+
+/**
+ * @brief Converts packed GNS mode indicators back to a field.
+ * @param modes The field to overwrite.
+ * @param packed The codes from pack_modes().
+ * @return  void    This function does not return a value.
+ */
+inline void unpack_modes(std::pmr::string &modes, std::uint16_t packed) {
+  modes.clear();
+
+  for (; (packed & 0xF) != 0; packed >>= 4) {
+    modes.push_back(GNS_MODES[(packed & 0xF) - 1]);
+  }
+}
+} // namespace detail
+
+/**
+ * @brief A batch of compact samples with their satellites.
+ *
+ * Samples are converted on insertion: numeric fields become fixed point,
+ * single-character codes are kept as is, the GNS mode indicators become
+ * 4-bit codes, and the satellite lists of GSA and GSV sentences and the
+ * waypoint IDs of RMB sentences go to shared arrays, so scanning the samples
+ * touches 32 bytes per sentence.
+ * expand() turns a record back into a Sample, with its numbers reformatted.
+ */
+class CompactBatch {
+public:
+  /**
+   * @brief Converts a sample and appends it.
+   * @param sample The sample.
+   * @return  void    This function does not return a value.
+   */
+  void push_back(const Sample &sample) {
+    CompactSample compact{};
+
+    std::visit(
+        [&](const auto &data) {
+          using T = std::decay_t<decltype(data)>;
+          if constexpr (std::is_same_v<T, GGA>) {
+            compact.gga = pack_gga(data);
+          } else if constexpr (std::is_same_v<T, GLL>) {
+            compact.gll = pack_gll(data);
+          } else if constexpr (std::is_same_v<T, GSA>) {
+            compact.gsa = pack_gsa(data);
+          } else if constexpr (std::is_same_v<T, GSV>) {
+            compact.gsv = pack_gsv(data);
+          } else if constexpr (std::is_same_v<T, RMC>) {
+            compact.rmc = pack_rmc(data);
+          } else if constexpr (std::is_same_v<T, VTG>) {
+            compact.vtg = pack_vtg(data);
+          } else if constexpr (std::is_same_v<T, ZDA>) {
+            compact.zda = pack_zda(data);
+          } else if constexpr (std::is_same_v<T, GST>) {
+            compact.gst = pack_gst(data);
+          } else if constexpr (std::is_same_v<T, GBS>) {
+            compact.gbs = pack_gbs(data);
+          } else if constexpr (std::is_same_v<T, GNS>) {
+            compact.gns = pack_gns(data);
+          } else if constexpr (std::is_same_v<T, RMB>) {
+            compact.rmb = pack_rmb(data);
+          } else if constexpr (std::is_same_v<T, HDT>) {
+            compact.hdt = pack_hdt(data);
+          }
+        },
+        sample);
+
+    samples_.push_back(compact);
+  }
+
+  /**
+   * @brief Returns the samples.
+   * @return  std::span<const CompactSample>  The samples, in insertion order.
+   */
+  std::span<const CompactSample> samples() const { return samples_; }
+
+  /**
+   * @brief Returns the satellites of a GSA or GSV record.
+   * @param sample A sample of the batch.
+   * @return  std::span<const CompactSatellite>   The satellites, empty for
+   * other sentence types.
+   */
+  std::span<const CompactSatellite>
+  satellites(const CompactSample &sample) const {
+    std::span<const CompactSatellite> all{satellites_};
+
+    if (sample.header.type == SentenceType::GSA) {
+      return all.subspan(sample.gsa.first, sample.gsa.count);
+    } else if (sample.header.type == SentenceType::GSV) {
+      return all.subspan(sample.gsv.first, sample.gsv.count);
+    }
+    return {};
+  }
+
+  /**
+   * @brief Returns the origin waypoint ID of an RMB record.
+   * @param sample A sample of the batch.
+   * @return  std::string_view    The ID, empty for other sentence types.
+   */
+  std::string_view origin(const CompactSample &sample) const {
+    if (sample.header.type != SentenceType::RMB) {
+      return {};
+    }
+    return {waypoints_.data() + sample.rmb.first, sample.rmb.origin_size};
+  }
+
+  /**
+   * @brief Returns the destination waypoint ID of an RMB record.
+   * @param sample A sample of the batch.
+   * @return  std::string_view    The ID, empty for other sentence types.
+   */
+  std::string_view destination(const CompactSample &sample) const {
+    if (sample.header.type != SentenceType::RMB) {
+      return {};
+    }
+    return {waypoints_.data() + sample.rmb.first + sample.rmb.origin_size,
+            sample.rmb.destination_size};
+  }
+
+  /**
+   * @brief Converts a sample of the batch back to a Sample.
+   * @param index The position of the sample.
+   * @return  Sample  The sample, with numeric fields reformatted from their
+   * fixed-point values.
+   */
+  Sample expand(std::size_t index) const {
+    const CompactSample &compact = samples_[index];
+
+    switch (compact.header.type) {
+    case SentenceType::GGA:
+      return expand_gga(compact.gga);
+    case SentenceType::GLL:
+      return expand_gll(compact.gll);
+    case SentenceType::GSA:
+      return expand_gsa(compact);
+    case SentenceType::GSV:
+      return expand_gsv(compact);
+    case SentenceType::RMC:
+      return expand_rmc(compact.rmc);
+    case SentenceType::VTG:
+      return expand_vtg(compact.vtg);
+    case SentenceType::ZDA:
+      return expand_zda(compact.zda);
+    case SentenceType::GST:
+      return expand_gst(compact.gst);
+    case SentenceType::GBS:
+      return expand_gbs(compact.gbs);
+    case SentenceType::GNS:
+      return expand_gns(compact.gns);
+    case SentenceType::RMB:
+      return expand_rmb(compact);
+    case SentenceType::HDT:
+      return expand_hdt(compact.hdt);
+    }
+    std::unreachable();
+  }
+
+  /**
+   * @brief Returns the number of samples.
+   * @return  std::size_t     The number of samples.
+   */
+  std::size_t size() const { return samples_.size(); }
+
+  /**
+   * @brief Removes every sample, keeping the capacity.
+   * @return  void    This function does not return a value.
+   */
+  void clear() {
+    samples_.clear();
+    satellites_.clear();
+    waypoints_.clear();
+  }
+
+private:
+  /**
+   * @brief Packs a GGA sentence.
+   * @param data The sentence.
+   * @return  CompactGGA      The record.
+   */
+  static CompactGGA pack_gga(const GGA &data) {
+    CompactGGA gga{};
+    gga.type = SentenceType::GGA;
+    gga.talker = detail::pack_talker(data.type);
+    gga.quality = data.quality;
+    detail::pack_time(data.utc_time, gga.day, gga.milliseconds);
+    gga.dgps_station = detail::pack<std::uint16_t>(data.dgps);
+    gga.latitude = detail::pack_degrees(data.latitude.value);
+    gga.longitude = detail::pack_degrees(data.longitude.value);
+    gga.altitude = detail::pack<std::int32_t>(data.altitude, 1e3);
+    gga.separation = detail::pack<std::int32_t>(data.geoidal_separation, 1e3);
+    gga.hdop = detail::pack<std::uint16_t>(data.hdop, 1e2);
+    gga.satellites_used = detail::pack<std::uint8_t>(data.satellites_used);
+    return gga;
+  }
+
+  /**
+   * @brief Packs a GLL sentence.
+   * @param data The sentence.
+   * @return  CompactGLL      The record.
+   */
+  static CompactGLL pack_gll(const GLL &data) {
+    CompactGLL gll{};
+    gll.type = SentenceType::GLL;
+    gll.talker = detail::pack_talker(data.type);
+    gll.status = data.status;
+    detail::pack_time(data.utc_time, gll.day, gll.milliseconds);
+    gll.latitude = detail::pack_degrees(data.latitude.value);
+    gll.longitude = detail::pack_degrees(data.longitude.value);
+    return gll;
+  }
+
+  /**
+   * @brief Packs a GSA sentence, storing its non-empty satellites.
+   * @param data The sentence.
+   * @return  CompactGSA      The record.
+   */
+  CompactGSA pack_gsa(const GSA &data) {
+    CompactGSA gsa{};
+    gsa.type = SentenceType::GSA;
+    gsa.talker = detail::pack_talker(data.type);
+    gsa.mode = data.mode;
+    gsa.fix_type = data.fix_type;
+    gsa.pdop = detail::pack<std::uint16_t>(data.pdop, 1e2);
+    gsa.hdop = detail::pack<std::uint16_t>(data.hdop, 1e2);
+    gsa.vdop = detail::pack<std::uint16_t>(data.vdop, 1e2);
+    gsa.first = static_cast<std::uint32_t>(satellites_.size());
+
+    for (std::uint16_t id : data.satellites) {
+      if (id != 0) {
+        satellites_.push_back({id, COMPACT_MISSING<std::uint16_t>,
+                               COMPACT_MISSING<std::uint8_t>,
+                               COMPACT_MISSING<std::uint8_t>});
+      }
+    }
+
+    gsa.count = static_cast<std::uint8_t>(satellites_.size() - gsa.first);
+    return gsa;
+  }
+
+  /**
+   * @brief Packs a GSV sentence, storing its satellites.
+   * @param data The sentence.
+   * @return  CompactGSV      The record.
+   */
+  CompactGSV pack_gsv(const GSV &data) {
+    CompactGSV gsv{};
+    gsv.type = SentenceType::GSV;
+    gsv.talker = detail::pack_talker(data.type);
+    gsv.number_of_messages =
+        detail::pack<std::uint8_t>(data.number_of_messages);
+    gsv.sequence_number = detail::pack<std::uint8_t>(data.sequence_number);
+    gsv.satellites_in_view =
+        detail::pack<std::uint8_t>(data.satellites_in_view);
+    gsv.first = static_cast<std::uint32_t>(satellites_.size());
+
+    for (const Satellite &satellite : data.satellites) {
+      satellites_.push_back({satellite.id,
+                             detail::pack<std::uint16_t>(satellite.azimuth),
+                             detail::pack<std::uint8_t>(satellite.elevation),
+                             detail::pack<std::uint8_t>(satellite.snr)});
+    }
+
+    gsv.count = static_cast<std::uint8_t>(satellites_.size() - gsv.first);
+    return gsv;
+  }
+
+  /**
+   * @brief Packs an RMC sentence.
+   * @param data The sentence.
+   * @return  CompactRMC      The record.
+   */
+  static CompactRMC pack_rmc(const RMC &data) {
+    CompactRMC rmc{};
+    rmc.type = SentenceType::RMC;
+    rmc.talker = detail::pack_talker(data.type);
+    rmc.status = data.status;
+    detail::pack_time(data.utc_time, rmc.day, rmc.milliseconds);
+    rmc.mode = data.mode;
+    rmc.latitude = detail::pack_degrees(data.latitude.value);
+    rmc.longitude = detail::pack_degrees(data.longitude.value);
+    rmc.speed = detail::pack<std::int32_t>(data.speed, 1e3);
+    rmc.course = detail::pack<std::uint16_t>(data.course, 1e2);
+    return rmc;
+  }
+
+  /**
+   * @brief Packs a VTG sentence.
+   * @param data The sentence.
+   * @return  CompactVTG      The record.
+   */
+  static CompactVTG pack_vtg(const VTG &data) {
+    CompactVTG vtg{};
+    vtg.type = SentenceType::VTG;
+    vtg.talker = detail::pack_talker(data.type);
+    vtg.mode = data.mode;
+    vtg.course = detail::pack<std::uint16_t>(data.course, 1e2);
+    vtg.course_magnetic =
+        detail::pack<std::uint16_t>(data.course_magnetic, 1e2);
+    vtg.speed_kn = detail::pack<std::int32_t>(data.speed_kn, 1e3);
+    vtg.speed_kh = detail::pack<std::int32_t>(data.speed_kh, 1e3);
+    return vtg;
+  }
+
+  /**
+   * @brief Packs a ZDA sentence.
+   * @param data The sentence.
+   * @return  CompactZDA      The record.
+   */
+  static CompactZDA pack_zda(const ZDA &data) {
+    CompactZDA zda{};
+    zda.type = SentenceType::ZDA;
+    zda.talker = detail::pack_talker(data.type);
+    detail::pack_time(data.utc_time, zda.day, zda.milliseconds);
+    zda.local_zone_hours = detail::pack<std::int8_t>(data.local_zone_hours);
+    zda.local_zone_minutes =
+        detail::pack<std::uint8_t>(data.local_zone_minutes);
+    return zda;
+  }
+
+  /**
+   * @brief Packs a GST sentence.
+   * @param data The sentence.
+   * @return  CompactGST      The record.
+   */
+  static CompactGST pack_gst(const GST &data) {
+    CompactGST gst{};
+    gst.type = SentenceType::GST;
+    gst.talker = detail::pack_talker(data.type);
+    detail::pack_time(data.utc_time, gst.day, gst.milliseconds);
+    gst.rms = detail::pack<std::uint16_t>(data.rms, 1e3);
+    gst.semi_major = detail::pack<std::uint16_t>(data.semi_major_error, 1e3);
+    gst.semi_minor = detail::pack<std::uint16_t>(data.semi_minor_error, 1e3);
+    gst.orientation = detail::pack<std::uint16_t>(data.orientation, 1e2);
+    gst.latitude_error = detail::pack<std::uint16_t>(data.latitude_error, 1e3);
+    gst.longitude_error =
+        detail::pack<std::uint16_t>(data.longitude_error, 1e3);
+    gst.altitude_error = detail::pack<std::uint16_t>(data.altitude_error, 1e3);
+    return gst;
+  }
+
+  /**
+   * @brief Packs a GBS sentence.
+   * @param data The sentence.
+   * @return  CompactGBS      The record.
+   */
+  static CompactGBS pack_gbs(const GBS &data) {
+    CompactGBS gbs{};
+    gbs.type = SentenceType::GBS;
+    gbs.talker = detail::pack_talker(data.type);
+    detail::pack_time(data.utc_time, gbs.day, gbs.milliseconds);
+    gbs.failed = data.failed_satellite;
+    gbs.latitude_error = detail::pack<std::uint16_t>(data.latitude_error, 1e2);
+    gbs.longitude_error =
+        detail::pack<std::uint16_t>(data.longitude_error, 1e2);
+    gbs.altitude_error = detail::pack<std::uint16_t>(data.altitude_error, 1e2);
+    gbs.probability = detail::pack<std::uint16_t>(data.probability, 1e4);
+    gbs.bias = detail::pack<std::int16_t>(data.bias, 1e2);
+    gbs.bias_deviation = detail::pack<std::uint16_t>(data.bias_deviation, 1e2);
+    gbs.system_id = detail::pack_char(data.system_id);
+    gbs.signal_id = detail::pack_char(data.signal_id);
+    return gbs;
+  }
+
+  /**
+   * @brief Packs a GNS sentence.
+   * @param data The sentence.
+   * @return  CompactGNS      The record.
+   */
+  static CompactGNS pack_gns(const GNS &data) {
+    CompactGNS gns{};
+    gns.type = SentenceType::GNS;
+    gns.talker = detail::pack_talker(data.type);
+    gns.satellites_used = detail::pack<std::uint8_t>(data.satellites_used);
+    detail::pack_time(data.utc_time, gns.day, gns.milliseconds);
+    gns.hdop = detail::pack<std::uint16_t>(data.hdop, 1e2);
+    gns.latitude = detail::pack_degrees(data.latitude.value);
+    gns.longitude = detail::pack_degrees(data.longitude.value);
+    gns.altitude = detail::pack<std::int32_t>(data.altitude, 1e3);
+    gns.separation = detail::pack<std::int32_t>(data.geoidal_separation, 1e3);
+    gns.mode = detail::pack_modes(data.mode);
+    gns.dgps_station = detail::pack<std::uint16_t>(data.dgps);
+    return gns;
+  }
+
+  /**
+   * @brief Packs an RMB sentence, storing its waypoint IDs. IDs longer than
+   * 255 characters are cut.
+   * @param data The sentence.
+   * @return  CompactRMB      The record.
+   */
+  CompactRMB pack_rmb(const RMB &data) {
+    CompactRMB rmb{};
+    rmb.type = SentenceType::RMB;
+    rmb.talker = detail::pack_talker(data.type);
+    rmb.status = data.status;
+    rmb.steer = data.steer;
+    rmb.arrival = data.arrival;
+    rmb.mode = data.mode;
+    rmb.cross_track = detail::pack<std::uint16_t>(data.cross_track_error, 1e2);
+    rmb.bearing = detail::pack<std::uint16_t>(data.bearing, 1e2);
+    rmb.latitude = detail::pack_degrees(data.destination_latitude.value);
+    rmb.longitude = detail::pack_degrees(data.destination_longitude.value);
+    rmb.range = detail::pack<std::uint32_t>(data.range, 1e2);
+    rmb.closing_velocity =
+        detail::pack<std::int16_t>(data.closing_velocity, 1e2);
+    rmb.first = static_cast<std::uint32_t>(waypoints_.size());
+
+    auto store = [&](std::string_view id) {
+      id = id.substr(0, std::numeric_limits<std::uint8_t>::max());
+      waypoints_.insert(waypoints_.end(), id.begin(), id.end());
+      return static_cast<std::uint8_t>(id.size());
+    };
+    rmb.origin_size = store(data.origin);
+    rmb.destination_size = store(data.destination);
+    return rmb;
+  }
+
+  /**
+   * @brief Packs an HDT sentence.
+   * @param data The sentence.
+   * @return  CompactHDT      The record.
+   */
+  static CompactHDT pack_hdt(const HDT &data) {
+    CompactHDT hdt{};
+    hdt.type = SentenceType::HDT;
+    hdt.talker = detail::pack_talker(data.type);
+    hdt.heading = detail::pack<std::uint16_t>(data.heading, 1e2);
+    return hdt;
+  }
+
+  /**
+   * @brief Rebuilds the address field of a record.
+   * @param header The record header.
+   * @return  Address The address, e.g. "$GPGGA".
+   */
+  static Address expand_type(const CompactHeader &header) {
+    return address_of({header.talker.data(), header.talker.size()},
+                      header.type);
+  }
+
+  /**
+   * @brief Rebuilds a latitude.
+   * @param value The latitude in 1e-7 degrees.
+   * @return  Latitude        The latitude.
+   */
+  static Latitude expand_latitude(std::int32_t value) {
+    return {value / COMPACT_DEGREES, value < 0 ? 'S' : 'N'};
+  }
+
+  /**
+   * @brief Rebuilds a longitude.
+   * @param value The longitude in 1e-7 degrees.
+   * @return  Longitude       The longitude.
+   */
+  static Longitude expand_longitude(std::int32_t value) {
+    return {value / COMPACT_DEGREES, value < 0 ? 'W' : 'E'};
+  }
+
+  /**
+   * @brief Rebuilds a GGA sentence.
+   * @param gga The record.
+   * @return  GGA     The sentence.
+   */
+  static GGA expand_gga(const CompactGGA &gga) {
+    GGA data;
+    data.type = expand_type({gga.type, gga.talker});
+    data.utc_time = detail::unpack_time(gga.day, gga.milliseconds);
+    data.latitude = expand_latitude(gga.latitude);
+    data.longitude = expand_longitude(gga.longitude);
+    data.quality = gga.quality;
+    detail::unpack(data.satellites_used, gga.satellites_used);
+    detail::unpack(data.hdop, gga.hdop, 2);
+    detail::unpack(data.altitude, gga.altitude, 3);
+    detail::unpack(data.geoidal_separation, gga.separation, 3);
+    detail::unpack(data.dgps, gga.dgps_station);
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds a GLL sentence.
+   * @param gll The record.
+   * @return  GLL     The sentence.
+   */
+  static GLL expand_gll(const CompactGLL &gll) {
+    GLL data;
+    data.type = expand_type({gll.type, gll.talker});
+    data.latitude = expand_latitude(gll.latitude);
+    data.longitude = expand_longitude(gll.longitude);
+    data.utc_time = detail::unpack_time(gll.day, gll.milliseconds);
+    data.status = gll.status;
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds a GSA sentence, padding its satellites to twelve.
+   * @param compact The record.
+   * @return  GSA     The sentence.
+   */
+  GSA expand_gsa(const CompactSample &compact) const {
+    const CompactGSA &gsa = compact.gsa;
+    GSA data;
+    data.type = expand_type(compact.header);
+    data.mode = gsa.mode;
+    data.fix_type = gsa.fix_type;
+    detail::unpack(data.pdop, gsa.pdop, 2);
+    detail::unpack(data.hdop, gsa.hdop, 2);
+    detail::unpack(data.vdop, gsa.vdop, 2);
+
+    std::size_t i = 0;
+    for (const CompactSatellite &satellite : satellites(compact)) {
+      data.satellites[i++] = satellite.id;
+    }
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds a GSV sentence.
+   * @param compact The record.
+   * @return  GSV     The sentence.
+   */
+  GSV expand_gsv(const CompactSample &compact) const {
+    const CompactGSV &gsv = compact.gsv;
+    GSV data;
+    data.type = expand_type(compact.header);
+    detail::unpack(data.number_of_messages, gsv.number_of_messages);
+    detail::unpack(data.sequence_number, gsv.sequence_number);
+    detail::unpack(data.satellites_in_view, gsv.satellites_in_view);
+
+    for (const CompactSatellite &satellite : satellites(compact)) {
+      Satellite &expanded = data.satellites.emplace_back();
+      expanded.id = satellite.id;
+      detail::unpack(expanded.elevation, satellite.elevation);
+      detail::unpack(expanded.azimuth, satellite.azimuth);
+      detail::unpack(expanded.snr, satellite.snr);
+    }
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds an RMC sentence, with the speed in knots.
+   * @param rmc The record.
+   * @return  RMC     The sentence.
+   */
+  static RMC expand_rmc(const CompactRMC &rmc) {
+    RMC data;
+    data.type = expand_type({rmc.type, rmc.talker});
+    data.utc_time = detail::unpack_time(rmc.day, rmc.milliseconds);
+    data.status = rmc.status;
+    data.latitude = expand_latitude(rmc.latitude);
+    data.longitude = expand_longitude(rmc.longitude);
+    detail::unpack(data.speed, rmc.speed, 3);
+    detail::unpack(data.course, rmc.course, 2);
+    data.mode = rmc.mode;
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds a VTG sentence.
+   * @param vtg The record.
+   * @return  VTG     The sentence.
+   */
+  static VTG expand_vtg(const CompactVTG &vtg) {
+    VTG data;
+    data.type = expand_type({vtg.type, vtg.talker});
+    detail::unpack(data.course, vtg.course, 2);
+    detail::unpack(data.course_magnetic, vtg.course_magnetic, 2);
+    detail::unpack(data.speed_kn, vtg.speed_kn, 3);
+    detail::unpack(data.speed_kh, vtg.speed_kh, 3);
+    data.mode = vtg.mode;
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds a ZDA sentence.
+   * @param zda The record.
+   * @return  ZDA     The sentence.
+   */
+  static ZDA expand_zda(const CompactZDA &zda) {
+    ZDA data;
+    data.type = expand_type({zda.type, zda.talker});
+    data.utc_time = detail::unpack_time(zda.day, zda.milliseconds);
+    detail::unpack(data.local_zone_hours, zda.local_zone_hours);
+    detail::unpack(data.local_zone_minutes, zda.local_zone_minutes);
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds a GST sentence.
+   * @param gst The record.
+   * @return  GST     The sentence.
+   */
+  static GST expand_gst(const CompactGST &gst) {
+    GST data;
+    data.type = expand_type({gst.type, gst.talker});
+    data.utc_time = detail::unpack_time(gst.day, gst.milliseconds);
+    detail::unpack(data.rms, gst.rms, 3);
+    detail::unpack(data.semi_major_error, gst.semi_major, 3);
+    detail::unpack(data.semi_minor_error, gst.semi_minor, 3);
+    detail::unpack(data.orientation, gst.orientation, 2);
+    detail::unpack(data.latitude_error, gst.latitude_error, 3);
+    detail::unpack(data.longitude_error, gst.longitude_error, 3);
+    detail::unpack(data.altitude_error, gst.altitude_error, 3);
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds a GBS sentence.
+   * @param gbs The record.
+   * @return  GBS     The sentence.
+   */
+  static GBS expand_gbs(const CompactGBS &gbs) {
+    GBS data;
+    data.type = expand_type({gbs.type, gbs.talker});
+    data.utc_time = detail::unpack_time(gbs.day, gbs.milliseconds);
+    detail::unpack(data.latitude_error, gbs.latitude_error, 2);
+    detail::unpack(data.longitude_error, gbs.longitude_error, 2);
+    detail::unpack(data.altitude_error, gbs.altitude_error, 2);
+    data.failed_satellite = gbs.failed;
+    detail::unpack(data.probability, gbs.probability, 4);
+    detail::unpack(data.bias, gbs.bias, 2);
+    detail::unpack(data.bias_deviation, gbs.bias_deviation, 2);
+    detail::unpack_char(data.system_id, gbs.system_id);
+    detail::unpack_char(data.signal_id, gbs.signal_id);
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds a GNS sentence.
+   * @param gns The record.
+   * @return  GNS     The sentence.
+   */
+  static GNS expand_gns(const CompactGNS &gns) {
+    GNS data;
+    data.type = expand_type({gns.type, gns.talker});
+    data.utc_time = detail::unpack_time(gns.day, gns.milliseconds);
+    data.latitude = expand_latitude(gns.latitude);
+    data.longitude = expand_longitude(gns.longitude);
+    detail::unpack_modes(data.mode, gns.mode);
+    detail::unpack(data.satellites_used, gns.satellites_used);
+    detail::unpack(data.hdop, gns.hdop, 2);
+    detail::unpack(data.altitude, gns.altitude, 3);
+    detail::unpack(data.geoidal_separation, gns.separation, 3);
+    detail::unpack(data.dgps, gns.dgps_station);
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds an RMB sentence.
+   * @param compact The record.
+   * @return  RMB     The sentence.
+   */
+  RMB expand_rmb(const CompactSample &compact) const {
+    const CompactRMB &rmb = compact.rmb;
+    RMB data;
+    data.type = expand_type(compact.header);
+    data.status = rmb.status;
+    detail::unpack(data.cross_track_error, rmb.cross_track, 2);
+    data.steer = rmb.steer;
+    data.origin = origin(compact);
+    data.destination = destination(compact);
+    data.destination_latitude = expand_latitude(rmb.latitude);
+    data.destination_longitude = expand_longitude(rmb.longitude);
+    detail::unpack(data.range, rmb.range, 2);
+    detail::unpack(data.bearing, rmb.bearing, 2);
+    detail::unpack(data.closing_velocity, rmb.closing_velocity, 2);
+    data.arrival = rmb.arrival;
+    data.mode = rmb.mode;
+    return data;
+  }
+
+  /**
+   * @brief Rebuilds an HDT sentence.
+   * @param hdt The record.
+   * @return  HDT     The sentence.
+   */
+  static HDT expand_hdt(const CompactHDT &hdt) {
+    HDT data;
+    data.type = expand_type({hdt.type, hdt.talker});
+    detail::unpack(data.heading, hdt.heading, 2);
+    return data;
+  }
+
+  std::vector<CompactSample> samples_;       ///< Fixed-size records.
+  std::vector<CompactSatellite> satellites_; ///< Satellites of GSA and GSV.
+  std::vector<char> waypoints_;              ///< Waypoint IDs of RMB.
+};
+} // namespace gps_lib
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cerrno>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace gps_lib::detail {
+/**
+ * @brief Returns the error of the last failed system call.
+ * @return  std::error_code     The error code for errno.
+ */
+inline std::error_code last_error() {
+  return std::error_code{errno, std::system_category()};
+}
+
+/**
+ * @brief Owns a POSIX file descriptor and closes it on destruction.
+ */
+class FileDescriptor {
+public:
+  /**
+   * @brief Constructs an empty descriptor.
+   */
+  FileDescriptor() = default;
+
+  /**
+   * @brief Takes ownership of a file descriptor.
+   * @param fd The descriptor to own, or -1.
+   */
+  explicit FileDescriptor(int fd) : fd_{fd} {}
+
+  FileDescriptor(const FileDescriptor &) = delete;
+  FileDescriptor &operator=(const FileDescriptor &) = delete;
+
+  FileDescriptor(FileDescriptor &&other) noexcept
+      : fd_{std::exchange(other.fd_, -1)} {}
+
+  FileDescriptor &operator=(FileDescriptor &&other) noexcept {
+    if (this != &other) {
+      reset(std::exchange(other.fd_, -1));
+    }
+    return *this;
+  }
+
+  ~FileDescriptor() { reset(); }
+
+  /**
+   * @brief Closes the owned descriptor and takes ownership of another one.
+   * @param fd The new descriptor, or -1.
+   * @return  void    This function does not return a value.
+   */
+  void reset(int fd = -1) {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+    fd_ = fd;
+  }
+
+  /**
+   * @brief Returns the owned descriptor.
+   * @return  int     The descriptor, or -1 if empty.
+   */
+  int get() const { return fd_; }
+
+  /**
+   * @brief Checks whether a descriptor is owned.
+   * @return  bool    True if the descriptor is valid.
+   */
+  explicit operator bool() const { return fd_ >= 0; }
+
+private:
+  int fd_{-1}; ///< Owned descriptor, -1 if empty.
+};
+} // namespace gps_lib::detail
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cmath>
+#include <numbers>
+
+namespace gps_lib::detail {
+/**
+ * @brief This constant represents the mean Earth radius in meters.
+ */
+constexpr double EARTH_RADIUS{6371008.8};
+
+/**
+ * @brief This constant represents the conversion factor from degrees to
+ * radians.
+ */
+constexpr double DEGTORAD{std::numbers::pi / 180.0};
+
+/**
+ * @brief This struct represents a planar offset in meters from a reference
+ * point.
+ */
+struct Offset {
+  double east;  ///< Offset towards the east in meters.
+  double north; ///< Offset towards the north in meters.
+};
+
+/**
+ * @brief Projects a position onto the local tangent plane of a reference
+ * point using an equirectangular approximation.
+ * @param ref_latitude The reference latitude in decimal degrees.
+ * @param ref_longitude The reference longitude in decimal degrees.
+ * @param latitude The latitude to project in decimal degrees.
+ * @param longitude The longitude to project in decimal degrees.
+ * @return  Offset  The offset from the reference point in meters.
+ * @note Accurate to well under a meter for distances of a few kilometers,
+ * which is what the streaming filters work with.
+ */
+inline Offset local_offset(double ref_latitude, double ref_longitude,
+                           double latitude, double longitude) {
+  double delta_longitude = std::remainder(longitude - ref_longitude, 360.0);
+
+  return Offset{
+      EARTH_RADIUS * delta_longitude * DEGTORAD *
+          std::cos(ref_latitude * DEGTORAD),
+      EARTH_RADIUS * (latitude - ref_latitude) * DEGTORAD,
+  };
+}
+
+/**
+ * @brief Computes the great-circle distance between two positions.
+ * @param latitude1 The first latitude in decimal degrees.
+ * @param longitude1 The first longitude in decimal degrees.
+ * @param latitude2 The second latitude in decimal degrees.
+ * @param longitude2 The second longitude in decimal degrees.
+ * @return  double  The distance in meters.
+ */
+inline double haversine_distance(double latitude1, double longitude1,
+                                 double latitude2, double longitude2) {
+  double sin_latitude = std::sin((latitude2 - latitude1) * DEGTORAD / 2.0);
+  double sin_longitude = std::sin((longitude2 - longitude1) * DEGTORAD / 2.0);
+  double a = sin_latitude * sin_latitude +
+             std::cos(latitude1 * DEGTORAD) * std::cos(latitude2 * DEGTORAD) *
+                 sin_longitude * sin_longitude;
+
+  return 2.0 * EARTH_RADIUS * std::asin(std::sqrt(std::fmin(a, 1.0)));
+}
+} // namespace gps_lib::detail
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace gps_lib {
+/**
+ * @brief This enum represents the I/O mechanism used by an ingest component.
+ */
+enum class IoBackend {
+  Posix, ///< Plain system calls, with epoll for sockets.
+  Uring, ///< Completion-based I/O with io_uring.
+};
+} // namespace gps_lib
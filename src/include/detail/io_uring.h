@@ -0,0 +1,359 @@
+#pragma once
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) &&                 \
+    !defined(GPS_LIB_NO_IO_URING)
+#define GPS_LIB_HAS_IO_URING 1
+#else
+#define GPS_LIB_HAS_IO_URING 0
+#endif
+
+#if GPS_LIB_HAS_IO_URING
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <linux/io_uring.h>
+#include <span>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "file_descriptor.h"
+
+namespace gps_lib::detail {
+/**
+ * @brief Owns a memory mapping and unmaps it on destruction.
+ */
+class Mapping {
+public:
+  Mapping() = default;
+
+  /**
+   * @brief Maps a region of a file, or anonymous memory if fd is -1.
+   * @param fd The file descriptor to map, or -1.
+   * @param size The size of the region in bytes.
+   * @param offset The offset of the region in the file.
+   */
+  Mapping(int fd, std::size_t size, off_t offset)
+      : address_{::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                        fd < 0 ? MAP_PRIVATE | MAP_ANONYMOUS
+                               : MAP_SHARED | MAP_POPULATE,
+                        fd, offset)},
+        size_{size} {}
+
+  Mapping(const Mapping &) = delete;
+  Mapping &operator=(const Mapping &) = delete;
+
+  Mapping(Mapping &&other) noexcept
+      : address_{std::exchange(other.address_, MAP_FAILED)},
+        size_{other.size_} {}
+
+  Mapping &operator=(Mapping &&other) noexcept {
+    std::swap(address_, other.address_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  ~Mapping() {
+    if (address_ != MAP_FAILED) {
+      ::munmap(address_, size_);
+    }
+  }
+
+  /**
+   * @brief Returns a pointer into the mapping.
+   * @param offset The offset in bytes.
+   * @return  T*      The address at the offset.
+   */
+  template <typename T> T *at(std::size_t offset) const {
+    return reinterpret_cast<T *>(static_cast<std::byte *>(address_) + offset);
+  }
+
+  /**
+   * @brief Checks whether the mapping succeeded.
+   * @return  bool    True if the region is mapped.
+   */
+  explicit operator bool() const { return address_ != MAP_FAILED; }
+
+private:
+  void *address_{MAP_FAILED}; ///< Start of the mapping.
+  std::size_t size_{0};       ///< Size of the mapping in bytes.
+};
+
+/**
+ * @brief A minimal io_uring instance driven by raw system calls.
+ *
+ * Only what the ingest path needs is wrapped: queueing submissions,
+ * submitting and waiting in one call, draining completions and registering
+ * buffers. Every io_uring_enter is counted so backends can be compared by
+ * system calls per sentence.
+ */
+class Ring {
+public:
+  /**
+   * @brief Creates a ring.
+   * @param entries The submission queue size.
+   * @return  std::expected<Ring, std::error_code>   The ring, or the error if
+   * the kernel does not support io_uring or forbids it.
+   */
+  static std::expected<Ring, std::error_code> create(unsigned entries) {
+    io_uring_params params{};
+    params.flags = IORING_SETUP_COOP_TASKRUN;
+
+    int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0 && errno == EINVAL) {
+      params = {};
+      fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    }
+
+    if (fd < 0) {
+      return std::unexpected{last_error()};
+    }
+
+    Ring ring;
+    ring.fd_.reset(fd);
+
+    std::size_t sq_size =
+        params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    std::size_t cq_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+
+    if (single_mmap) {
+      sq_size = cq_size = std::max(sq_size, cq_size);
+    }
+
+    ring.sq_ring_ = Mapping{fd, sq_size, IORING_OFF_SQ_RING};
+    if (!single_mmap) {
+      ring.cq_ring_ = Mapping{fd, cq_size, IORING_OFF_CQ_RING};
+    }
+    ring.sqe_array_ = Mapping{fd, params.sq_entries * sizeof(io_uring_sqe),
+                              static_cast<off_t>(IORING_OFF_SQES)};
+
+    const Mapping &cq_ring = single_mmap ? ring.sq_ring_ : ring.cq_ring_;
+
+    if (!ring.sq_ring_ || !cq_ring || !ring.sqe_array_) {
+      return std::unexpected{last_error()};
+    }
+
+    ring.sq_head_ = ring.sq_ring_.at<unsigned>(params.sq_off.head);
+    ring.sq_tail_ = ring.sq_ring_.at<unsigned>(params.sq_off.tail);
+    ring.sq_mask_ = *ring.sq_ring_.at<unsigned>(params.sq_off.ring_mask);
+    ring.sq_entries_ = params.sq_entries;
+    ring.sqes_ = ring.sqe_array_.at<io_uring_sqe>(0);
+    ring.cq_head_ = cq_ring.at<unsigned>(params.cq_off.head);
+    ring.cq_tail_ = cq_ring.at<unsigned>(params.cq_off.tail);
+    ring.cq_mask_ = *cq_ring.at<unsigned>(params.cq_off.ring_mask);
+    ring.cqes_ = cq_ring.at<io_uring_cqe>(params.cq_off.cqes);
+
+    // Submission slots map one to one onto the SQE array.
+    unsigned *array = ring.sq_ring_.at<unsigned>(params.sq_off.array);
+    for (unsigned i = 0; i < params.sq_entries; ++i) {
+      array[i] = i;
+    }
+
+    ring.local_tail_ = *ring.sq_tail_;
+
+    return ring;
+  }
+
+  /**
+   * @brief Returns a cleared submission entry, submitting the queued ones
+   * first if the queue is full.
+   * @return  io_uring_sqe&   The entry to fill in.
+   */
+  io_uring_sqe &next_sqe() {
+    while (local_tail_ - std::atomic_ref{*sq_head_}.load(
+                             std::memory_order_acquire) >=
+           sq_entries_) {
+      submit();
+    }
+
+    io_uring_sqe &sqe = sqes_[local_tail_++ & sq_mask_];
+    sqe = {};
+
+    return sqe;
+  }
+
+  /**
+   * @brief Submits the queued entries and waits for completions.
+   * @param wait The number of completions to wait for, 0 to return at once.
+   * @return  int     The number of entries submitted, or a negative errno.
+   */
+  int submit(unsigned wait = 0) {
+    unsigned queued = local_tail_ - *sq_tail_;
+    std::atomic_ref{*sq_tail_}.store(local_tail_, std::memory_order_release);
+
+    ++syscalls_;
+    int result = static_cast<int>(
+        ::syscall(__NR_io_uring_enter, fd_.get(), queued, wait,
+                  wait > 0 ? IORING_ENTER_GETEVENTS : 0U, nullptr, 0));
+
+    return result < 0 ? -errno : result;
+  }
+
+  /**
+   * @brief Visits every available completion and releases it to the kernel.
+   * @param visit Callback invoked with each completion.
+   * @return  unsigned    The number of completions visited.
+   */
+  template <std::invocable<const io_uring_cqe &> Visit>
+  unsigned drain(Visit &&visit) {
+    unsigned head = *cq_head_;
+    unsigned tail = std::atomic_ref{*cq_tail_}.load(std::memory_order_acquire);
+
+    for (unsigned i = head; i != tail; ++i) {
+      visit(cqes_[i & cq_mask_]);
+    }
+
+    std::atomic_ref{*cq_head_}.store(tail, std::memory_order_release);
+
+    return tail - head;
+  }
+
+  /**
+   * @brief Registers fixed buffers for IORING_OP_READ_FIXED.
+   * @param buffers The buffers to register.
+   * @return  bool    True on success, false with errno set otherwise.
+   */
+  bool register_buffers(std::span<const iovec> buffers) {
+    return ::syscall(__NR_io_uring_register, fd_.get(), IORING_REGISTER_BUFFERS,
+                     buffers.data(), buffers.size()) == 0;
+  }
+
+  /**
+   * @brief Calls io_uring_register on the ring.
+   * @param opcode The registration opcode.
+   * @param argument The opcode argument.
+   * @param count The number of arguments.
+   * @return  bool    True on success, false with errno set otherwise.
+   */
+  bool register_raw(unsigned opcode, void *argument, unsigned count) {
+    return ::syscall(__NR_io_uring_register, fd_.get(), opcode, argument,
+                     count) == 0;
+  }
+
+  /**
+   * @brief Returns the number of io_uring_enter calls made so far.
+   * @return  std::size_t     The number of system calls.
+   */
+  std::size_t syscalls() const { return syscalls_; }
+
+private:
+  Ring() = default;
+
+  FileDescriptor fd_;           ///< Ring descriptor.
+  /// Submission ring, and completion ring with IORING_FEAT_SINGLE_MMAP.
+  Mapping sq_ring_;
+  Mapping cq_ring_;             ///< Completion ring, if mapped apart.
+  Mapping sqe_array_;           ///< Submission entries.
+  unsigned *sq_head_{nullptr};  ///< Kernel's submission head.
+  unsigned *sq_tail_{nullptr};  ///< Published submission tail.
+  unsigned sq_mask_{0};         ///< Submission index mask.
+  unsigned sq_entries_{0};      ///< Submission queue size.
+  unsigned local_tail_{0};      ///< Tail including unpublished entries.
+  io_uring_sqe *sqes_{nullptr}; ///< Submission entries.
+  unsigned *cq_head_{nullptr};  ///< Completion head.
+  unsigned *cq_tail_{nullptr};  ///< Kernel's completion tail.
+  unsigned cq_mask_{0};         ///< Completion index mask.
+  io_uring_cqe *cqes_{nullptr}; ///< Completion entries.
+  std::size_t syscalls_{0};     ///< io_uring_enter calls.
+};
+
+/**
+ * @brief A ring of kernel-selected receive buffers (IORING_REGISTER_PBUF_RING)
+ * for multishot receives.
+ *
+ * The kernel picks a free buffer for every completion and reports its id in
+ * the completion flags; the buffer belongs to the application until it is
+ * recycled. The ring must be destroyed after the io_uring instance it was
+ * registered with.
+ */
+class BufferRing {
+public:
+  /**
+   * @brief Allocates the buffers and registers them with a ring.
+   * @param ring The io_uring instance.
+   * @param group The buffer group id used in submissions.
+   * @param count The number of buffers, a power of two.
+   * @param size The size of each buffer in bytes.
+   * @return  std::expected<BufferRing, std::error_code>  The buffer ring, or
+   * the error if the kernel does not support provided buffer rings.
+   */
+  static std::expected<BufferRing, std::error_code>
+  create(Ring &ring, std::uint16_t group, std::uint16_t count,
+         std::uint32_t size) {
+    BufferRing buffers;
+    buffers.entries_ = Mapping{-1, count * sizeof(io_uring_buf), 0};
+    if (!buffers.entries_) {
+      return std::unexpected{last_error()};
+    }
+
+    buffers.ring_ = buffers.entries_.at<io_uring_buf_ring>(0);
+    buffers.data_.resize(static_cast<std::size_t>(count) * size);
+    buffers.mask_ = static_cast<std::uint16_t>(count - 1);
+    buffers.size_ = size;
+
+    io_uring_buf_reg registration{};
+    registration.ring_addr = reinterpret_cast<std::uintptr_t>(buffers.ring_);
+    registration.ring_entries = count;
+    registration.bgid = group;
+
+    if (!ring.register_raw(IORING_REGISTER_PBUF_RING, &registration, 1)) {
+      return std::unexpected{last_error()};
+    }
+
+    for (std::uint16_t id = 0; id < count; ++id) {
+      buffers.recycle(id);
+    }
+
+    return buffers;
+  }
+
+  /**
+   * @brief Returns the contents of a buffer picked by the kernel.
+   * @param id The buffer id from the completion flags.
+   * @return  char*   The start of the buffer.
+   */
+  char *buffer(std::uint16_t id) {
+    return data_.data() + static_cast<std::size_t>(id) * size_;
+  }
+
+  /**
+   * @brief Returns a buffer to the kernel.
+   * @param id The buffer id.
+   * @return  void    This function does not return a value.
+   */
+  void recycle(std::uint16_t id) {
+    // The descriptors start at the ring itself; in C++ the UAPI flexible
+    // array member is preceded by an empty struct and sits at an offset.
+    io_uring_buf &entry = *entries_.at<io_uring_buf>(
+        (tail_ & mask_) * sizeof(io_uring_buf));
+    entry.addr = reinterpret_cast<std::uintptr_t>(buffer(id));
+    entry.len = size_;
+    entry.bid = id;
+
+    std::atomic_ref{ring_->tail}.store(++tail_, std::memory_order_release);
+  }
+
+private:
+  BufferRing() = default;
+
+  Mapping entries_;                  ///< Page-aligned buffer descriptors.
+  io_uring_buf_ring *ring_{nullptr}; ///< Shared ring of descriptors.
+  std::vector<char> data_;           ///< Storage of all buffers.
+  std::uint16_t tail_{0};            ///< Next descriptor to publish.
+  std::uint16_t mask_{0};            ///< Descriptor index mask.
+  std::uint32_t size_{0};            ///< Size of each buffer.
+};
+} // namespace gps_lib::detail
+
+#endif
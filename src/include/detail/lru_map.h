@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace gps_lib::detail {
+/**
+ * @brief A map that holds at most a fixed number of entries, evicting the
+ * least recently used one to make room.
+ *
+ * Meant for per-source state keyed by something a peer controls, such as a
+ * UDP source address, so spoofed sources cannot grow it without bound. An
+ * evicted entry's node is reused for the new key.
+ *
+ * @tparam Key The key type, hashable.
+ * @tparam Value The value type, default constructible and assignable.
+ */
+template <typename Key, typename Value> class LruMap {
+public:
+  /**
+   * @brief Constructs an empty map.
+   * @param capacity The maximum number of entries, at least 1.
+   */
+  explicit LruMap(std::size_t capacity)
+      : capacity_{std::max<std::size_t>(capacity, 1)} {}
+
+  /**
+   * @brief Returns the value of a key, inserting a default value if it is
+   * missing, and marks it as the most recently used.
+   * @param key The key.
+   * @return  std::pair<Value &, bool>   The value, and true if another entry
+   * was evicted to make room for it.
+   */
+  std::pair<Value &, bool> acquire(const Key &key) {
+    if (auto found = index_.find(key); found != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, found->second);
+      return {found->second->second, false};
+    }
+
+    bool evicted = entries_.size() >= capacity_;
+
+    if (evicted) {
+      entries_.splice(entries_.begin(), entries_, std::prev(entries_.end()));
+      index_.erase(entries_.front().first);
+      entries_.front() = {key, Value{}};
+    } else {
+      entries_.emplace_front(key, Value{});
+    }
+
+    index_.emplace(key, entries_.begin());
+    return {entries_.front().second, evicted};
+  }
+
+  /**
+   * @brief Returns the number of entries.
+   * @return  std::size_t     The number of entries.
+   */
+  std::size_t size() const { return entries_.size(); }
+
+  /**
+   * @brief Returns the maximum number of entries.
+   * @return  std::size_t     The capacity.
+   */
+  std::size_t capacity() const { return capacity_; }
+
+private:
+  using Entries = std::list<std::pair<Key, Value>>;
+
+  std::size_t capacity_; ///< Maximum number of entries.
+  Entries entries_;      ///< Entries, most recently used first.
+  /// Position of every key in entries_.
+  std::unordered_map<Key, typename Entries::iterator> index_;
+};
+} // namespace gps_lib::detail
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <expected>
+#include <string_view>
+
+#include "types.h"
+
+namespace gps_lib::detail {
+/**
+ * @brief Parses a single-character field, such as a status or mode
+ * indicator.
+ * @param field The field to parse.
+ * @return  std::expected<char, ParseError>   The character, '\0' if the
+ * field is empty, or InvalidFormat if it holds more than one character.
+ */
+constexpr std::expected<char, ParseError> parse_char(std::string_view field) {
+  if (field.size() > 1) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  return field.empty() ? '\0' : field.front();
+}
+} // namespace gps_lib::detail
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+
+#include "parse_digits.h"
+#include "types.h"
+
+namespace gps_lib::detail {
+/**
+ * @brief Most integer digits of a coordinate field: DDDMM for longitudes.
+ */
+constexpr std::size_t MAX_DEGREES_MINUTES_DIGITS{5};
+
+/**
+ * @brief Converts an NMEA coordinate in the format [D]DDMM.mmmm to unsigned
+ * decimal degrees.
+ *
+ * The field is read as a single fixed-point integer, so degrees and minutes
+ * are split with integer arithmetic and only the final value is converted to
+ * double. This is the kernel shared by parse_latitude() and parse_longitude().
+ *
+ * @param field The coordinate field to convert.
+ * @return  std::expected<double, ParseError>  The coordinate in decimal
+ * degrees, MissingFields if the field is empty or InvalidFormat if it is
+ * malformed or has more digits than DDDMM.mmmmmmmmm.
+ */
+constexpr std::expected<double, ParseError>
+parse_degrees_minutes(std::string_view field) {
+  if (field.empty()) {
+    return std::unexpected(ParseError::MissingFields);
+  }
+
+  std::size_t point = field.find('.');
+  std::string_view whole = field.substr(0, point);
+  std::string_view fraction =
+      point == std::string_view::npos ? std::string_view{}
+                                      : field.substr(point + 1);
+
+  // Bounding both runs keeps the mantissa below 10^14, far from overflow.
+  if (whole.size() < 3 || whole.size() > MAX_DEGREES_MINUTES_DIGITS ||
+      fraction.size() >= POW10.size()) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  std::uint64_t mantissa = 0;
+  bool invalid = accumulate_digits(whole, mantissa);
+  invalid |= accumulate_digits(fraction, mantissa);
+
+  std::uint64_t scale = POW10[fraction.size()];
+  std::uint64_t degrees = mantissa / (100 * scale);
+  std::uint64_t minutes = mantissa - degrees * 100 * scale;
+  invalid |= minutes >= 60 * scale;
+
+  if (invalid) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  return static_cast<double>(degrees) +
+         static_cast<double>(minutes) / (60.0 * static_cast<double>(scale));
+}
+
+/**
+ * @brief Returns +1.0 or -1.0 depending on the hemisphere without branching.
+ * @param direction The hemisphere character.
+ * @param negative The hemisphere that maps to a negative value ('S' or 'W').
+ * @return  double  The sign to apply to the coordinate.
+ */
+constexpr double hemisphere_sign(char direction, char negative) {
+  return 1.0 - 2.0 * static_cast<double>(direction == negative);
+}
+} // namespace gps_lib::detail
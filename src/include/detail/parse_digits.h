@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace gps_lib::detail {
+/**
+ * @brief Powers of ten used to scale fixed-point fractions.
+ */
+inline constexpr std::array<std::uint64_t, 10> POW10{
+    1,         10,         100,         1'000,         10'000,
+    100'000,   1'000'000,  10'000'000,  100'000'000,   1'000'000'000};
+
+/**
+ * @brief Accumulates a run of decimal digits into a fixed-point mantissa.
+ *
+ * The mantissa wraps silently if it exceeds 64 bits, so callers must bound
+ * the length of the run.
+ *
+ * @param digits The characters to accumulate.
+ * @param mantissa The mantissa to extend with the digits.
+ * @return  bool    True if any character was not a decimal digit.
+ */
+constexpr bool accumulate_digits(std::string_view digits,
+                                 std::uint64_t &mantissa) {
+  unsigned invalid = 0;
+
+  for (char c : digits) {
+    unsigned digit = static_cast<unsigned char>(c) - unsigned{'0'};
+    invalid |= static_cast<unsigned>(digit > 9);
+    mantissa = mantissa * 10 + digit;
+  }
+
+  return invalid != 0;
+}
+} // namespace gps_lib::detail
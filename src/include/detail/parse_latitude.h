@@ -1,3 +1,37 @@
 #pragma once
 
-namespace gps_lib::detail {} // namespace gps_lib::detail
+#include <expected>
+#include <string_view>
+
+#include "parse_degrees_minutes.h"
+#include "types.h"
+
+namespace gps_lib::detail {
+/**
+ * @brief Parses a latitude field in the format DDMM.mmmm and its direction.
+ * @param value The latitude field to parse.
+ * @param direction The direction field ('N' or 'S').
+ * @return  std::expected<Latitude, ParseError>  The latitude in signed decimal
+ * degrees (negative south) or an error.
+ */
+constexpr std::expected<Latitude, ParseError>
+parse_latitude(std::string_view value, std::string_view direction) {
+  auto degrees = parse_degrees_minutes(value);
+
+  if (!degrees) {
+    return std::unexpected(degrees.error());
+  }
+
+  if (*degrees > 90.0) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  if (direction.empty() ||
+      (direction.front() != 'N' && direction.front() != 'S')) {
+    return std::unexpected(ParseError::InvalidDirection);
+  }
+
+  return Latitude{*degrees * hemisphere_sign(direction.front(), 'S'),
+                  direction.front()};
+}
+} // namespace gps_lib::detail
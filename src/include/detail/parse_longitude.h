@@ -1,3 +1,37 @@
 #pragma once
 
-namespace gps_lib::detail {} // namespace gps_lib::detail
+#include <expected>
+#include <string_view>
+
+#include "parse_degrees_minutes.h"
+#include "types.h"
+
+namespace gps_lib::detail {
+/**
+ * @brief Parses a longitude field in the format DDDMM.mmmm and its direction.
+ * @param value The longitude field to parse.
+ * @param direction The direction field ('E' or 'W').
+ * @return  std::expected<Longitude, ParseError>  The longitude in signed
+ * decimal degrees (negative west) or an error.
+ */
+constexpr std::expected<Longitude, ParseError>
+parse_longitude(std::string_view value, std::string_view direction) {
+  auto degrees = parse_degrees_minutes(value);
+
+  if (!degrees) {
+    return std::unexpected(degrees.error());
+  }
+
+  if (*degrees > 180.0) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  if (direction.empty() ||
+      (direction.front() != 'E' && direction.front() != 'W')) {
+    return std::unexpected(ParseError::InvalidDirection);
+  }
+
+  return Longitude{*degrees * hemisphere_sign(direction.front(), 'W'),
+                   direction.front()};
+}
+} // namespace gps_lib::detail
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <charconv>
+#include <optional>
+#include <string_view>
+#include <system_error>
+
+namespace gps_lib::detail {
+/**
+ * @brief Parses a numeric NMEA field without allocating or throwing.
+ * @param field The field to parse.
+ * @return  std::optional<double>  The parsed value, or std::nullopt if the
+ * field is empty or not entirely numeric.
+ */
+inline std::optional<double> parse_number(std::string_view field) {
+  double value{};
+  auto [end, error] =
+      std::from_chars(field.data(), field.data() + field.size(), value);
+
+  if (field.empty() || error != std::errc{} ||
+      end != field.data() + field.size()) {
+    return std::nullopt;
+  }
+
+  return value;
+}
+} // namespace gps_lib::detail
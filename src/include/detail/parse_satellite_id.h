@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <string_view>
+
+#include "parse_digits.h"
+#include "types.h"
+
+namespace gps_lib::detail {
+/**
+ * @brief Parses a satellite ID field.
+ * @param field The field to parse.
+ * @return  std::expected<std::uint16_t, ParseError>    The ID, 0 if the
+ * field is empty, or InvalidFormat if it is not a whole number that fits in
+ * 16 bits.
+ */
+constexpr std::expected<std::uint16_t, ParseError>
+parse_satellite_id(std::string_view field) {
+  std::uint64_t id = 0;
+
+  // Five digits cannot wrap the accumulator, and the range check below
+  // rejects the ones that do not fit.
+  if (field.size() > 5 || accumulate_digits(field, id) ||
+      id > std::numeric_limits<std::uint16_t>::max()) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  return static_cast<std::uint16_t>(id);
+}
+} // namespace gps_lib::detail
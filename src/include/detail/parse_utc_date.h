@@ -1,19 +1,99 @@
 #pragma once
 
-#include <string>
-#include <tuple>
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+
+#include "parse_digits.h"
+#include "types.h"
 
 namespace gps_lib::detail {
+/**
+ * @brief Builds a validated calendar date.
+ * @param year The year.
+ * @param month The month, from 1 to 12.
+ * @param day The day of the month.
+ * @return  std::expected<std::chrono::sys_days, ParseError>  The date, or
+ * InvalidFormat if it does not exist.
+ */
+constexpr std::expected<std::chrono::sys_days, ParseError>
+make_utc_date(std::uint64_t year, std::uint64_t month, std::uint64_t day) {
+  std::chrono::year_month_day date{
+      std::chrono::year{static_cast<int>(year)},
+      std::chrono::month{static_cast<unsigned>(month)},
+      std::chrono::day{static_cast<unsigned>(day)}};
+
+  if (year > 9999 || !date.ok()) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  return std::chrono::sys_days{date};
+}
+
 /**
  * @brief Parses a UTC date string in the format DDMMYY.
  * @param utc_date The UTC date string to parse.
- * @return  auto    A tuple containing the day, month, and year as strings.
+ * @return  std::expected<std::chrono::sys_days, ParseError>  The date,
+ * MissingFields if the field is empty or InvalidFormat if it is malformed.
+ * @note Two-digit years are read as 1980 to 2079, since GPS time starts in
+ * 1980.
  */
-inline auto parse_utc_date(const std::string utc_date) {
-  return std::tuple{
-      std::string{utc_date.substr(0, 2)}, // Day.
-      std::string{utc_date.substr(2, 2)}, // Month.
-      std::string{utc_date.substr(4, 2)}, // Year.
-  };
+constexpr std::expected<std::chrono::sys_days, ParseError>
+parse_utc_date(std::string_view utc_date) {
+  if (utc_date.empty()) {
+    return std::unexpected(ParseError::MissingFields);
+  }
+
+  if (utc_date.size() != 6) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  std::uint64_t day = 0;
+  std::uint64_t month = 0;
+  std::uint64_t year = 0;
+  bool invalid = accumulate_digits(utc_date.substr(0, 2), day);
+  invalid |= accumulate_digits(utc_date.substr(2, 2), month);
+  invalid |= accumulate_digits(utc_date.substr(4, 2), year);
+
+  if (invalid) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  return make_utc_date(year < 80 ? 2000 + year : 1900 + year, month, day);
+}
+
+/**
+ * @brief Parses a UTC date split into day, month and four-digit year fields,
+ * as found in ZDA sentences.
+ * @param utc_day The day field.
+ * @param utc_month The month field.
+ * @param utc_year The year field.
+ * @return  std::expected<std::chrono::sys_days, ParseError>  The date,
+ * MissingFields if a field is empty or InvalidFormat if one is malformed.
+ */
+constexpr std::expected<std::chrono::sys_days, ParseError>
+parse_utc_date(std::string_view utc_day, std::string_view utc_month,
+               std::string_view utc_year) {
+  if (utc_day.empty() || utc_month.empty() || utc_year.empty()) {
+    return std::unexpected(ParseError::MissingFields);
+  }
+
+  if (utc_day.size() > 2 || utc_month.size() > 2 || utc_year.size() != 4) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  std::uint64_t day = 0;
+  std::uint64_t month = 0;
+  std::uint64_t year = 0;
+  bool invalid = accumulate_digits(utc_day, day);
+  invalid |= accumulate_digits(utc_month, month);
+  invalid |= accumulate_digits(utc_year, year);
+
+  if (invalid) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  return make_utc_date(year, month, day);
 }
 } // namespace gps_lib::detail
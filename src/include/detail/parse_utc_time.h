@@ -1,20 +1,60 @@
 #pragma once
 
-#include <string>
-#include <tuple>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+
+#include "parse_digits.h"
+#include "types.h"
 
 namespace gps_lib::detail {
 /**
- * @brief Parses a UTC time string in the format HHMMSS.
+ * @brief Parses a UTC time string in the format HHMMSS.ss.
  * @param utc_time The UTC time string to parse.
- * @return  auto    A tuple containing the hours, minutes, and seconds as
- * strings.
+ * @return  std::expected<std::chrono::milliseconds, ParseError>  The time
+ * since midnight truncated to milliseconds, MissingFields if the field is
+ * empty or InvalidFormat if it is malformed.
  */
-inline auto parse_utc_time(const std::string utc_time) {
-  return std::tuple{
-      std::string{utc_time.substr(0, 2)}, // Hours.
-      std::string{utc_time.substr(2, 2)}, // Minutes.
-      std::string{utc_time.substr(4, 2)}, // Seconds.
-  };
+constexpr std::expected<std::chrono::milliseconds, ParseError>
+parse_utc_time(std::string_view utc_time) {
+  if (utc_time.empty()) {
+    return std::unexpected(ParseError::MissingFields);
+  }
+
+  std::size_t point = utc_time.find('.');
+  std::string_view whole = utc_time.substr(0, point);
+  std::string_view fraction = point == std::string_view::npos
+                                  ? std::string_view{}
+                                  : utc_time.substr(point + 1);
+  // Digits past the millisecond are checked, then dropped.
+  std::string_view rest =
+      fraction.size() > 3 ? fraction.substr(3) : std::string_view{};
+  fraction = fraction.substr(0, 3);
+
+  if (whole.size() != 6) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  std::uint64_t hours = 0;
+  std::uint64_t minutes = 0;
+  std::uint64_t seconds = 0;
+  std::uint64_t milliseconds = 0;
+  bool invalid = accumulate_digits(whole.substr(0, 2), hours);
+  invalid |= accumulate_digits(whole.substr(2, 2), minutes);
+  invalid |= accumulate_digits(whole.substr(4, 2), seconds);
+  invalid |= accumulate_digits(fraction, milliseconds);
+  std::uint64_t dropped = 0;
+  invalid |= accumulate_digits(rest, dropped);
+  invalid |= hours > 23 || minutes > 59 || seconds > 60;
+
+  if (invalid) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  return std::chrono::hours(hours) + std::chrono::minutes(minutes) +
+         std::chrono::seconds(seconds) +
+         std::chrono::milliseconds(milliseconds * POW10[3 - fraction.size()]);
 }
 } // namespace gps_lib::detail
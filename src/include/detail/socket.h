@@ -0,0 +1,65 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <cstdint>
+#include <netinet/in.h>
+#include <optional>
+#include <string>
+#include <sys/socket.h>
+
+#include "file_descriptor.h"
+
+namespace gps_lib::detail {
+/**
+ * @brief Builds an IPv4 socket address.
+ * @param address The address in dotted decimal notation.
+ * @param port The port in host order.
+ * @return  std::optional<sockaddr_in>     The socket address, or
+ * std::nullopt if the address is not valid.
+ */
+inline std::optional<sockaddr_in> make_address(const std::string &address,
+                                               std::uint16_t port) {
+  sockaddr_in result{};
+  result.sin_family = AF_INET;
+  result.sin_port = htons(port);
+
+  if (::inet_pton(AF_INET, address.c_str(), &result.sin_addr) != 1) {
+    return std::nullopt;
+  }
+
+  return result;
+}
+
+/**
+ * @brief Opens a non-blocking socket bound with SO_REUSEADDR and
+ * SO_REUSEPORT, listening if it is a stream socket. If the address has port 0,
+ * it is updated with the port the kernel picked so further sockets can share
+ * it.
+ * @param socket Receives the socket.
+ * @param type SOCK_DGRAM or SOCK_STREAM.
+ * @param address The address to bind to.
+ * @param receive_buffer The SO_RCVBUF size, 0 to keep the default.
+ * @return  bool    True on success, false with errno set otherwise.
+ */
+inline bool open_socket(FileDescriptor &socket, int type, sockaddr_in &address,
+                        int receive_buffer) {
+  int one = 1;
+  socklen_t length = sizeof(address);
+
+  socket.reset(::socket(AF_INET, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+
+  return socket &&
+         ::setsockopt(socket.get(), SOL_SOCKET, SO_REUSEADDR, &one,
+                      sizeof(one)) == 0 &&
+         ::setsockopt(socket.get(), SOL_SOCKET, SO_REUSEPORT, &one,
+                      sizeof(one)) == 0 &&
+         (receive_buffer == 0 ||
+          ::setsockopt(socket.get(), SOL_SOCKET, SO_RCVBUF, &receive_buffer,
+                       sizeof(receive_buffer)) == 0) &&
+         ::bind(socket.get(), reinterpret_cast<const sockaddr *>(&address),
+                sizeof(address)) == 0 &&
+         (type != SOCK_STREAM || ::listen(socket.get(), SOMAXCONN) == 0) &&
+         ::getsockname(socket.get(), reinterpret_cast<sockaddr *>(&address),
+                       &length) == 0;
+}
+} // namespace gps_lib::detail
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+
+#include "types.h"
+
+namespace gps_lib::detail {
+/**
+ * @brief Dates a time of day with the stream's current date.
+ *
+ * If the time of day is more than twelve hours earlier than the previous
+ * sentence, the stream has crossed midnight and the date moves forward.
+ *
+ * @param context The stream state.
+ * @param time_of_day The time since midnight.
+ * @return  Timestamp   The dated UTC time.
+ */
+constexpr Timestamp stamp_time(ParseContext &context,
+                               std::chrono::milliseconds time_of_day) {
+  if (time_of_day < context.time_of_day - std::chrono::hours{12}) {
+    context.date += std::chrono::days{1};
+  }
+
+  context.time_of_day = time_of_day;
+
+  return context.date + time_of_day;
+}
+
+/**
+ * @brief Dates a time of day with an explicit date and makes that date the
+ * stream's current date.
+ * @param context The stream state.
+ * @param date The UTC date.
+ * @param time_of_day The time since midnight.
+ * @return  Timestamp   The dated UTC time.
+ */
+constexpr Timestamp stamp_time(ParseContext &context,
+                               std::chrono::sys_days date,
+                               std::chrono::milliseconds time_of_day) {
+  context.date = date;
+  context.time_of_day = time_of_day;
+
+  return date + time_of_day;
+}
+} // namespace gps_lib::detail
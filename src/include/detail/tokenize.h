@@ -1,20 +1,96 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <stdexcept>
 #include <string_view>
-#include <vector>
 
-#include "split.h"
+#include "trace.h"
 
 namespace gps_lib::detail {
 /**
- * @brief Tokenizes a string_view into a vector of string_views based on the '*'
- * separator.
+ * @brief The comma-separated fields of a sentence, held in a fixed array so
+ * tokenizing does not allocate.
+ */
+class Tokens {
+public:
+  /**
+   * @brief Maximum number of fields kept. NMEA limits sentences to 82
+   * characters, so real sentences never reach it; fields past it are dropped.
+   */
+  static constexpr std::size_t CAPACITY{96};
+
+  /**
+   * @brief Appends a field, unless the array is full.
+   * @param token The field.
+   * @return  void    This function does not return a value.
+   */
+  void push_back(std::string_view token) {
+    if (size_ < CAPACITY) {
+      tokens_[size_++] = token;
+    }
+  }
+
+  /**
+   * @brief Returns a field.
+   * @param index The position of the field.
+   * @return  std::string_view    The field.
+   */
+  std::string_view operator[](std::size_t index) const {
+    return tokens_[index];
+  }
+
+  /**
+   * @brief Returns a field, checking its position.
+   * @param index The position of the field.
+   * @return  std::string_view    The field.
+   * @throws std::out_of_range If there is no such field.
+   */
+  std::string_view at(std::size_t index) const {
+    if (index >= size_) {
+      throw std::out_of_range{"gps_lib::detail::Tokens::at"};
+    }
+    return tokens_[index];
+  }
+
+  /**
+   * @brief Returns the number of fields.
+   * @return  std::size_t     The number of fields.
+   */
+  std::size_t size() const { return size_; }
+
+  /**
+   * @brief Checks whether there are no fields.
+   * @return  bool    True if there are no fields.
+   */
+  bool empty() const { return size_ == 0; }
+
+private:
+  std::array<std::string_view, CAPACITY> tokens_; ///< Field storage.
+  std::size_t size_{0};                           ///< Fields stored.
+};
+
+/**
+ * @brief Splits the part of an NMEA sentence before the '*' separator into
+ * its comma-separated fields.
  * @param sample The input NMEA sentence to tokenize.
- * @return  std::vector<std::string_view>  A vector containing the tokenized
- * strings.
+ * @return  Tokens  The fields of the sentence.
  */
-inline std::vector<std::string_view> tokenize(const std::string_view sample) {
-  std::vector<std::string_view> raw_data = detail::split(sample, '*');
-  return detail::split(raw_data.at(0), ',');
+inline Tokens tokenize(const std::string_view sample) {
+  GPS_LIB_TRACE_SCOPE("tokenize");
+
+  std::string_view data = sample.substr(0, sample.find('*'));
+  Tokens tokens;
+  std::size_t start = 0;
+  std::size_t end = 0;
+
+  while ((end = data.find(',', start)) != std::string_view::npos) {
+    tokens.push_back(data.substr(start, end - start));
+    start = end + 1;
+  }
+
+  tokens.push_back(data.substr(start));
+
+  return tokens;
 }
 } // namespace gps_lib::detail
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Opens a trace span that lasts until the end of the enclosing scope.
+ *
+ * With GPS_LIB_TRACE defined, every span is recorded in a per-thread ring
+ * that save_trace() in trace.h dumps. Otherwise the macro expands to nothing
+ * and the hooks in the parser and the sinks cost nothing.
+ *
+ * @param name A string literal naming the span.
+ */
+#ifdef GPS_LIB_TRACE
+#define GPS_LIB_TRACE_SCOPE(name)                                              \
+  static const std::uint16_t GPS_LIB_TRACE_JOIN(gps_lib_trace_id_,            \
+                                                __LINE__) =                    \
+      ::gps_lib::detail::TraceRegistry::instance().intern(name);               \
+  const ::gps_lib::detail::TraceScope GPS_LIB_TRACE_JOIN(gps_lib_trace_,       \
+                                                         __LINE__) {           \
+    GPS_LIB_TRACE_JOIN(gps_lib_trace_id_, __LINE__)                            \
+  }
+#else
+#define GPS_LIB_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#define GPS_LIB_TRACE_JOIN(a, b) GPS_LIB_TRACE_JOIN_(a, b)
+#define GPS_LIB_TRACE_JOIN_(a, b) a##b
+
+namespace gps_lib::detail {
+/**
+ * @brief A completed span, as stored in the rings and in trace files.
+ */
+struct TraceEvent {
+  std::uint16_t name{0};     ///< Interned span name.
+  std::uint16_t reserved{0}; ///< Padding, always zero.
+  std::uint32_t thread{0};   ///< Index of the recording thread.
+  std::uint64_t start{0};    ///< Steady clock time in ns.
+  std::uint64_t duration{0}; ///< Length of the span in ns.
+};
+
+/**
+ * @brief The ring of spans of one thread. When it is full the oldest spans
+ * are overwritten, so a dump shows the most recent activity.
+ */
+struct alignas(64) TraceRing {
+  static constexpr std::size_t CAPACITY{1 << 14}; ///< Spans kept per thread.
+
+  std::array<TraceEvent, CAPACITY> events{}; ///< Span storage.
+  std::atomic<std::uint64_t> head{0};        ///< Spans recorded so far.
+  std::uint32_t thread{0};                   ///< Index of the owner.
+};
+
+/**
+ * @brief Owns the span names and the rings of every thread that traced.
+ *
+ * A ring is handed out on a thread's first span and taken back when the
+ * thread exits. It keeps its spans until the next dump, and only then goes
+ * to the next new thread, so the number of rings is bounded by the peak
+ * number of threads plus those that exited since the last dump. The mutex
+ * is only taken when a trace point runs for the first time, on thread start
+ * and exit, and when the rings are dumped; recording a span touches only the
+ * thread's own ring.
+ */
+class TraceRegistry {
+public:
+  /**
+   * @brief Returns the process-wide registry.
+   * @return  TraceRegistry&  The registry.
+   */
+  static TraceRegistry &instance() {
+    static TraceRegistry registry;
+    return registry;
+  }
+
+  /**
+   * @brief Returns the identifier of a span name, registering it if needed.
+   * @param name The span name.
+   * @return  std::uint16_t   The identifier.
+   */
+  std::uint16_t intern(std::string_view name) {
+    std::lock_guard lock{mutex_};
+
+    for (std::size_t i = 0; i < names_.size(); ++i) {
+      if (names_[i] == name) {
+        return static_cast<std::uint16_t>(i);
+      }
+    }
+
+    names_.emplace_back(name);
+    return static_cast<std::uint16_t>(names_.size() - 1);
+  }
+
+  /**
+   * @brief Hands out a ring to the calling thread, reusing an emptied one
+   * if there is one.
+   * @return  TraceRing&  The ring, empty.
+   */
+  TraceRing &acquire() {
+    std::lock_guard lock{mutex_};
+
+    if (!free_.empty()) {
+      TraceRing *ring = free_.back();
+      free_.pop_back();
+      return *ring;
+    }
+
+    auto &created = rings_.emplace_back(std::make_unique<TraceRing>());
+    created->thread = static_cast<std::uint32_t>(rings_.size());
+    return *created;
+  }
+
+  /**
+   * @brief Takes back the ring of an exiting thread. Its spans stay in the
+   * next dump.
+   * @param ring The ring.
+   * @return  void    This function does not return a value.
+   */
+  void release(TraceRing &ring) {
+    std::lock_guard lock{mutex_};
+    released_.push_back(&ring);
+  }
+
+  /**
+   * @brief Returns the ring of the calling thread, acquiring it on first use.
+   * @return  TraceRing&  The ring.
+   */
+  static TraceRing &ring() {
+    struct Lease {
+      TraceRing &ring{TraceRegistry::instance().acquire()};
+      ~Lease() { TraceRegistry::instance().release(ring); }
+    };
+
+    thread_local Lease lease;
+    return lease.ring;
+  }
+
+  /**
+   * @brief Calls a function with the names and rings under the lock. The
+   * rings of exited threads are emptied afterwards and can be reused, as
+   * their spans have been exported.
+   * @param visit Callback invoked with the names and the rings.
+   * @return  void    This function does not return a value.
+   */
+  template <typename Visit> void visit(Visit &&visit) {
+    std::lock_guard lock{mutex_};
+    visit(names_, rings_);
+
+    for (TraceRing *ring : released_) {
+      ring->head.store(0, std::memory_order_relaxed);
+      free_.push_back(ring);
+    }
+    released_.clear();
+  }
+
+private:
+  std::mutex mutex_;                              ///< Guards the lists.
+  std::vector<std::string> names_;                ///< Names by identifier.
+  std::vector<std::unique_ptr<TraceRing>> rings_; ///< All rings.
+  std::vector<TraceRing *> released_;             ///< Rings of exited threads.
+  std::vector<TraceRing *> free_;                 ///< Emptied, unowned rings.
+};
+
+/**
+ * @brief Records the span of its own lifetime in the thread's ring.
+ */
+class TraceScope {
+public:
+  /**
+   * @brief Starts a span.
+   * @param name The interned span name.
+   */
+  explicit TraceScope(std::uint16_t name) : name_{name}, start_{now()} {}
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+  ~TraceScope() {
+    std::uint64_t end = now();
+    TraceRing &ring = TraceRegistry::ring();
+    std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+
+    ring.events[head % TraceRing::CAPACITY] =
+        TraceEvent{name_, 0, ring.thread, start_, end - start_};
+    ring.head.store(head + 1, std::memory_order_release);
+  }
+
+private:
+  /**
+   * @brief Returns the steady clock time.
+   * @return  std::uint64_t   The time in ns.
+   */
+  static std::uint64_t now() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+
+  std::uint16_t name_;  ///< Interned span name.
+  std::uint64_t start_; ///< Start of the span in ns.
+};
+} // namespace gps_lib::detail
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace gps_lib::detail {
+/**
+ * @brief Blocks until a deadline with sub-millisecond accuracy, or until stop
+ * is requested.
+ *
+ * The thread sleeps until shortly before the deadline, since the scheduler
+ * may wake it late, and yields for the rest so the wake-up jitter stays in
+ * the microsecond range without burning a core between deadlines. The sleep
+ * is a wait on a condition variable tied to the stop token, so a stop request
+ * ends it at once however far away the deadline is.
+ *
+ * @param deadline The time point to wait for.
+ * @param stop Token that ends the wait early when stop is requested.
+ * @return  bool    True if the deadline was reached, false if stopped.
+ */
+inline bool wait_until(std::chrono::steady_clock::time_point deadline,
+                       std::stop_token stop = {}) {
+  constexpr std::chrono::microseconds spin{200};
+
+  if (deadline - std::chrono::steady_clock::now() > spin) {
+    std::mutex mutex;
+    std::condition_variable_any wake;
+    std::unique_lock lock{mutex};
+
+    wake.wait_until(lock, stop, deadline - spin, [] { return false; });
+  }
+
+  while (!stop.stop_requested() &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+
+  return !stop.stop_requested();
+}
+} // namespace gps_lib::detail
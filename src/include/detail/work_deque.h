@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace gps_lib::detail {
+/**
+ * @brief Fixed-capacity Chase-Lev work-stealing deque of pointers.
+ *
+ * The owner thread pushes and pops at the bottom without contention; other
+ * threads steal from the top with a compare-and-swap. The capacity is fixed
+ * because callers bound the number of tasks in flight, so the array never
+ * has to grow while thieves read it.
+ *
+ * @tparam T The pointed-to task type.
+ */
+template <typename T> class WorkDeque {
+public:
+  /**
+   * @brief Constructs a deque.
+   * @param capacity The maximum number of tasks, rounded up to a power of
+   * two.
+   */
+  explicit WorkDeque(std::size_t capacity)
+      : mask_{static_cast<std::int64_t>(std::bit_ceil(capacity)) - 1},
+        slots_{std::make_unique<std::atomic<T *>[]>(
+            static_cast<std::size_t>(mask_ + 1))} {}
+
+  /**
+   * @brief Pushes a task at the bottom. Owner thread only.
+   * @param task The task, which must fit in the capacity.
+   * @return  void    This function does not return a value.
+   */
+  void push(T *task) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+
+    slots_[bottom & mask_].store(task, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Pops the most recently pushed task. Owner thread only.
+   * @return  T*      The task, or nullptr if the deque is empty.
+   */
+  T *pop() {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    T *task = slots_[bottom & mask_].load(std::memory_order_relaxed);
+
+    // The last task may be raced for by a thief.
+    if (top == bottom) {
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        task = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return task;
+  }
+
+  /**
+   * @brief Steals the oldest task. Safe to call from any thread.
+   * @return  T*      The task, or nullptr if the deque is empty or another
+   * thread won the race.
+   */
+  T *steal() {
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+      return nullptr;
+    }
+
+    T *task = slots_[top & mask_].load(std::memory_order_relaxed);
+
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+
+    return task;
+  }
+
+private:
+  std::int64_t mask_;                               ///< Slot index mask.
+  std::unique_ptr<std::atomic<T *>[]> slots_;       ///< Task storage.
+  alignas(64) std::atomic<std::int64_t> top_{0};    ///< Next task to steal.
+  alignas(64) std::atomic<std::int64_t> bottom_{0}; ///< Next free slot.
+};
+} // namespace gps_lib::detail
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+#include "detail/geodesy.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Concept for a callback that receives both moving fixes and dwells.
+ */
+template <typename Sink>
+concept DwellSink = std::invocable<Sink &, const Fix &> &&
+                    std::invocable<Sink &, const Dwell &>;
+
+/**
+ * @brief Collapses stationary periods of a fix stream into Dwell records.
+ *
+ * A cluster starts with a fix whose speed is at most the speed threshold and
+ * grows while the following fixes stay slow and within the jitter radius of
+ * its first fix. Clusters with at least min_fixes fixes are emitted as a
+ * single Dwell when they end; shorter ones are released as the original
+ * fixes. Only the fixes of an unconfirmed cluster are held, so memory is
+ * bounded by min_fixes.
+ */
+class DwellDetector {
+public:
+  /**
+   * @brief Constructs a dwell detector.
+   * @param max_speed Highest speed in m/s considered stationary. Fixes that do
+   * not report speed are judged on position alone.
+   * @param radius Position jitter radius in meters.
+   * @param min_fixes Minimum number of fixes for a cluster to become a dwell.
+   */
+  DwellDetector(double max_speed, double radius, std::size_t min_fixes)
+      : max_speed_{max_speed}, radius_{radius},
+        min_fixes_{min_fixes > 0 ? min_fixes : 1} {
+    pending_.reserve(min_fixes_);
+  }
+
+  /**
+   * @brief Consumes the next fix of the stream.
+   * @param fix The fix to consume.
+   * @param sink Callback invoked with every fix that is not part of a dwell
+   * and with every completed dwell, in stream order.
+   * @return  void    This function does not return a value.
+   */
+  template <DwellSink Sink> void push(const Fix &fix, Sink &&sink) {
+    bool slow = !(fix.speed > max_speed_);
+
+    if (dwell_.fixes > 0 && slow && within_radius(fix)) {
+      absorb(fix);
+      return;
+    }
+
+    close(sink);
+
+    if (slow) {
+      anchor_latitude_ = fix.latitude;
+      anchor_longitude_ = fix.longitude;
+      dwell_.start_time = fix.utc_time;
+      absorb(fix);
+    } else {
+      sink(fix);
+    }
+  }
+
+  /**
+   * @brief Emits the cluster in progress, if any, and resets the detector.
+   * @param sink Callback invoked with the pending dwell or fixes.
+   * @return  void    This function does not return a value.
+   */
+  template <DwellSink Sink> void flush(Sink &&sink) { close(sink); }
+
+private:
+  /**
+   * @brief Checks whether a fix lies within the jitter radius of the cluster.
+   * @param fix The fix to check.
+   * @return  bool    True if the fix belongs to the current cluster.
+   */
+  bool within_radius(const Fix &fix) const {
+    detail::Offset offset = detail::local_offset(
+        anchor_latitude_, anchor_longitude_, fix.latitude, fix.longitude);
+    return std::hypot(offset.east, offset.north) <= radius_;
+  }
+
+  /**
+   * @brief Adds a fix to the current cluster.
+   * @param fix The fix to add.
+   * @return  void    This function does not return a value.
+   */
+  void absorb(const Fix &fix) {
+    dwell_.end_time = fix.utc_time;
+    latitude_sum_ += fix.latitude - anchor_latitude_;
+    longitude_sum_ += fix.longitude - anchor_longitude_;
+
+    if (++dwell_.fixes < min_fixes_) {
+      pending_.push_back(fix);
+    } else {
+      pending_.clear();
+    }
+  }
+
+  /**
+   * @brief Ends the current cluster, emitting it as a dwell or as its fixes.
+   * @param sink Callback receiving the output.
+   * @return  void    This function does not return a value.
+   */
+  template <DwellSink Sink> void close(Sink &sink) {
+    if (dwell_.fixes >= min_fixes_) {
+      double count = static_cast<double>(dwell_.fixes);
+      dwell_.latitude = anchor_latitude_ + latitude_sum_ / count;
+      dwell_.longitude = anchor_longitude_ + longitude_sum_ / count;
+      sink(static_cast<const Dwell &>(dwell_));
+    } else {
+      for (const Fix &fix : pending_) {
+        sink(fix);
+      }
+    }
+
+    pending_.clear();
+    dwell_.fixes = 0;
+    latitude_sum_ = 0.0;
+    longitude_sum_ = 0.0;
+  }
+
+  double max_speed_;          ///< Stationary speed threshold in m/s.
+  double radius_;             ///< Jitter radius in meters.
+  std::size_t min_fixes_;     ///< Fixes needed to confirm a dwell.
+  Dwell dwell_{};             ///< Cluster in progress.
+  double anchor_latitude_{};  ///< Latitude of the first fix of the cluster.
+  double anchor_longitude_{}; ///< Longitude of the first fix of the cluster.
+  double latitude_sum_{};     ///< Sum of latitude offsets from the anchor.
+  double longitude_sum_{};    ///< Sum of longitude offsets from the anchor.
+  std::vector<Fix> pending_;  ///< Fixes of an unconfirmed cluster.
+};
+} // namespace gps_lib
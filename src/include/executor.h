@@ -0,0 +1,400 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "detail/work_deque.h"
+#include "parse.h"
+#include "ring_buffer.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Concept for the per-receiver stage run after parsing.
+ *
+ * A stage is called with every raw sentence of its receiver and the parsed
+ * sample, in arrival order and never concurrently with itself, so it can own
+ * stateful processing such as to_fix followed by an OutlierFilter and a
+ * KalmanFilter without locking.
+ */
+template <typename T>
+concept ExecutorStage = std::invocable<T &, std::string_view, const Sample &>;
+
+/**
+ * @brief This struct holds the options of a ParseExecutor.
+ */
+struct ExecutorOptions {
+  std::size_t threads{std::thread::hardware_concurrency()}; ///< Workers.
+  std::size_t batch{64}; ///< Sentences a task parses before yielding.
+};
+
+/**
+ * @brief This struct holds the counters of a ParseExecutor.
+ */
+struct ExecutorStats {
+  std::size_t tasks{0};     ///< Batches run.
+  std::size_t steals{0};    ///< Batches taken from another worker.
+  std::size_t sentences{0}; ///< Sentences parsed and passed to stages.
+  std::size_t errors{0};    ///< Sentences that failed to parse.
+};
+
+/**
+ * @brief Parses sentences from many receivers on a pool of work-stealing
+ * threads.
+ *
+ * Every receiver has an inbox and a scheduled flag, like an actor. Submitting
+ * to an idle receiver schedules it on its home worker; a worker that runs out
+ * of tasks steals from the other workers' deques. A task parses up to a
+ * batch of sentences of one receiver and runs its stage, and since the flag
+ * keeps a receiver on at most one worker at a time, per-receiver order holds
+ * without any global lock. Bursty receivers spread across cores while idle
+ * ones cost nothing.
+ *
+ * @tparam Stage The per-receiver stage.
+ * @tparam Inbox Sentences a receiver can hold before submit waits, a power of
+ * two.
+ */
+template <ExecutorStage Stage, std::size_t Inbox = 64> class ParseExecutor {
+public:
+  /**
+   * @brief Creates the receivers and starts the worker threads.
+   * @param receivers The number of receivers.
+   * @param make_stage Callback invoked with each receiver index that returns
+   * its stage.
+   * @param options The executor options.
+   */
+  template <std::invocable<std::size_t> Factory>
+  ParseExecutor(std::size_t receivers, Factory &&make_stage,
+                ExecutorOptions options = {})
+      : batch_{std::max<std::size_t>(options.batch, 1)} {
+    receivers_.reserve(receivers);
+    for (std::size_t i = 0; i < receivers; ++i) {
+      receivers_.push_back(std::make_unique<Receiver>(make_stage(i)));
+    }
+
+    std::size_t threads = std::max<std::size_t>(options.threads, 1);
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+      workers_.push_back(std::make_unique<Worker>(receivers, i));
+    }
+
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+      threads_.emplace_back([this, i] { run(*workers_[i]); });
+    }
+  }
+
+  ParseExecutor(const ParseExecutor &) = delete;
+  ParseExecutor &operator=(const ParseExecutor &) = delete;
+
+  ~ParseExecutor() { stop(); }
+
+  /**
+   * @brief Queues a sentence for a receiver without waiting. Safe to call
+   * from several threads at once; sentences submitted by one thread to one
+   * receiver are processed in order.
+   * @param receiver The receiver index.
+   * @param sentence The raw sentence.
+   * @return  bool    True if queued, false if the inbox is full or the
+   * sentence does not fit in a frame.
+   */
+  bool try_submit(std::size_t receiver, std::string_view sentence) {
+    SentenceFrame<> frame;
+    if (!frame.assign(receiver, sentence)) {
+      return false;
+    }
+
+    Receiver &target = *receivers_[receiver];
+    if (!target.inbox.try_push(frame)) {
+      return false;
+    }
+
+    activate(target, receiver % workers_.size());
+
+    return true;
+  }
+
+  /**
+   * @brief Queues a sentence for a receiver, yielding while its inbox is
+   * full.
+   * @param receiver The receiver index.
+   * @param sentence The raw sentence.
+   * @return  bool    True if queued, false if the sentence does not fit in a
+   * frame.
+   */
+  bool submit(std::size_t receiver, std::string_view sentence) {
+    SentenceFrame<> frame;
+    if (!frame.assign(receiver, sentence)) {
+      return false;
+    }
+
+    Receiver &target = *receivers_[receiver];
+    target.inbox.push(frame);
+    activate(target, receiver % workers_.size());
+
+    return true;
+  }
+
+  /**
+   * @brief Processes every queued sentence, then stops the worker threads.
+   * @return  void    This function does not return a value.
+   */
+  void stop() {
+    stopping_.store(true);
+    for (const std::unique_ptr<Worker> &worker : workers_) {
+      wake(*worker);
+    }
+    threads_.clear();
+  }
+
+  /**
+   * @brief Returns the stage of a receiver. Only safe once stopped.
+   * @param receiver The receiver index.
+   * @return  Stage&  The stage.
+   */
+  Stage &stage(std::size_t receiver) { return receivers_[receiver]->stage; }
+
+  /**
+   * @brief Returns the counters summed over all workers.
+   * @return  ExecutorStats   The current counters.
+   */
+  ExecutorStats stats() const {
+    ExecutorStats total;
+
+    for (const std::unique_ptr<Worker> &worker : workers_) {
+      total.tasks += worker->tasks.load(std::memory_order_relaxed);
+      total.steals += worker->steals.load(std::memory_order_relaxed);
+      total.sentences += worker->sentences.load(std::memory_order_relaxed);
+      total.errors += worker->errors.load(std::memory_order_relaxed);
+    }
+
+    return total;
+  }
+
+private:
+  /**
+   * @brief A receiver: its inbox, parse state and stage.
+   */
+  struct alignas(64) Receiver {
+    explicit Receiver(Stage stage) : stage{std::move(stage)} {}
+
+    std::atomic<bool> scheduled{false};     ///< Queued or running.
+    Receiver *next{nullptr};                ///< Link in an injection list.
+    MpscRing<SentenceFrame<>, Inbox> inbox; ///< Pending sentences.
+    ParseContext context;                   ///< Parse state.
+    Stage stage;                            ///< Post-parse processing.
+  };
+
+  /**
+   * @brief The state of one worker thread.
+   */
+  struct alignas(64) Worker {
+    Worker(std::size_t receivers, std::size_t index)
+        : deque{std::max<std::size_t>(receivers, 1)}, index{index},
+          random{index + 1} {}
+
+    /// Tasks owned by this worker, stolen from the top by the others.
+    detail::WorkDeque<Receiver> deque;
+    /// Lock-free stack of receivers scheduled from other threads.
+    std::atomic<Receiver *> injected{nullptr};
+    std::atomic<std::uint32_t> signal{0};  ///< Bumped to wake the worker.
+    std::size_t index;                     ///< Position in workers_.
+    std::uint64_t random;                  ///< Victim selection state.
+    std::atomic<std::size_t> tasks{0};     ///< Batches run.
+    std::atomic<std::size_t> steals{0};    ///< Batches stolen.
+    std::atomic<std::size_t> sentences{0}; ///< Sentences parsed.
+    std::atomic<std::size_t> errors{0};    ///< Sentences rejected.
+  };
+
+  /**
+   * @brief Adds one to a counter that only the calling worker writes.
+   * @param counter The counter to increment.
+   * @param amount The amount to add.
+   * @return  void    This function does not return a value.
+   */
+  static void count(std::atomic<std::size_t> &counter, std::size_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Schedules a receiver that has just received a sentence, unless it
+   * is already queued or running.
+   * @param receiver The receiver.
+   * @param home The worker to schedule it on.
+   * @return  void    This function does not return a value.
+   */
+  void activate(Receiver &receiver, std::size_t home) {
+    // Pairs with the fence in execute: either the running task sees the new
+    // sentence or this exchange sees the flag cleared.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!receiver.scheduled.exchange(true)) {
+      inject(*workers_[home], receiver);
+      wake(*workers_[home]);
+    }
+  }
+
+  /**
+   * @brief Pushes a receiver on a worker's injection list.
+   * @param worker The worker.
+   * @param receiver The receiver.
+   * @return  void    This function does not return a value.
+   */
+  static void inject(Worker &worker, Receiver &receiver) {
+    receiver.next = worker.injected.load(std::memory_order_relaxed);
+    while (!worker.injected.compare_exchange_weak(receiver.next, &receiver)) {
+    }
+  }
+
+  /**
+   * @brief Wakes a worker if it is waiting for tasks.
+   * @param worker The worker.
+   * @return  void    This function does not return a value.
+   */
+  void wake(Worker &worker) {
+    worker.signal.fetch_add(1);
+    if (sleepers_.load() > 0) {
+      worker.signal.notify_one();
+    }
+  }
+
+  /**
+   * @brief Finds the next task: the worker's own deque first, then its
+   * injection list, then the other workers' deques.
+   * @param worker The worker.
+   * @return  Receiver*   The receiver to run, or nullptr if there is none.
+   */
+  Receiver *next_task(Worker &worker) {
+    if (Receiver *receiver = worker.deque.pop()) {
+      return receiver;
+    }
+
+    Receiver *list = worker.injected.exchange(nullptr);
+    if (list != nullptr) {
+      // The list is newest first, so the oldest ends at the bottom and is
+      // popped first while the newest are left for thieves.
+      std::size_t moved = 0;
+      for (; list != nullptr; list = list->next, ++moved) {
+        worker.deque.push(list);
+      }
+      if (moved > 1 && sleepers_.load() > 0) {
+        wake(*workers_[(worker.index + 1) % workers_.size()]);
+      }
+      return worker.deque.pop();
+    }
+
+    std::size_t start = xorshift(worker.random) % workers_.size();
+
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+      Worker &victim = *workers_[(start + i) % workers_.size()];
+      if (&victim == &worker) {
+        continue;
+      }
+      if (Receiver *receiver = victim.deque.steal()) {
+        count(worker.steals);
+        return receiver;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Runs tasks until the executor stops and no task is left.
+   * @param worker The worker.
+   * @return  void    This function does not return a value.
+   */
+  void run(Worker &worker) {
+    while (true) {
+      std::uint32_t signal = worker.signal.load();
+
+      if (Receiver *receiver = next_task(worker)) {
+        execute(worker, *receiver);
+        continue;
+      }
+
+      if (stopping_.load() && worker.injected.load() == nullptr) {
+        return;
+      }
+
+      sleepers_.fetch_add(1);
+      worker.signal.wait(signal);
+      sleepers_.fetch_sub(1);
+    }
+  }
+
+  /**
+   * @brief Parses a batch of a receiver's sentences and runs its stage,
+   * then reschedules the receiver if more arrived.
+   * @param worker The worker running the task.
+   * @param receiver The receiver.
+   * @return  void    This function does not return a value.
+   */
+  void execute(Worker &worker, Receiver &receiver) {
+    SentenceFrame<> frame;
+    std::size_t parsed = 0;
+    std::size_t failed = 0;
+
+    for (std::size_t i = 0; i < batch_ && receiver.inbox.try_pop(frame); ++i) {
+      std::string_view line = frame.view();
+      auto sample = parse(line, receiver.context);
+
+      if (sample) {
+        receiver.stage(line, *sample);
+        ++parsed;
+      } else {
+        ++failed;
+      }
+    }
+
+    count(worker.tasks);
+    count(worker.sentences, parsed);
+    count(worker.errors, failed);
+
+    // A full batch yields to the other receivers queued on this worker.
+    if (parsed + failed == batch_) {
+      inject(worker, receiver);
+      return;
+    }
+
+    receiver.scheduled.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!receiver.inbox.empty() && !receiver.scheduled.exchange(true)) {
+      inject(worker, receiver);
+    }
+  }
+
+  /**
+   * @brief Advances a xorshift generator.
+   * @param state The generator state, not zero.
+   * @return  std::uint64_t   The next value.
+   */
+  static std::uint64_t xorshift(std::uint64_t &state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+  std::size_t batch_;                                ///< Sentences per task.
+  std::vector<std::unique_ptr<Receiver>> receivers_; ///< Receivers by index.
+  std::vector<std::unique_ptr<Worker>> workers_;     ///< Worker states.
+  std::atomic<bool> stopping_{false};                ///< Set by stop.
+  std::atomic<std::size_t> sleepers_{0};             ///< Waiting workers.
+  std::vector<std::jthread> threads_;                ///< Worker threads.
+};
+} // namespace gps_lib
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#include "detail/parse_number.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Extracts a position fix from a parsed sample.
+ * @param sample The parsed sample.
+ * @return  std::optional<Fix>  The fix, or std::nullopt if the sample carries
+ * no position or the receiver reports it as invalid.
+ */
+inline std::optional<Fix> to_fix(const Sample &sample) {
+  return std::visit(
+      [](const auto &data) -> std::optional<Fix> {
+        using T = std::decay_t<decltype(data)>;
+        constexpr double unknown = std::numeric_limits<double>::quiet_NaN();
+        if constexpr (std::is_same_v<T, RMC>) {
+          if (data.status != 'A') {
+            return std::nullopt;
+          }
+          double speed = detail::parse_number(data.speed).value_or(unknown);
+          return Fix{data.utc_time, data.latitude.value, data.longitude.value,
+                     speed * KNTOMS, unknown};
+        } else if constexpr (std::is_same_v<T, GGA>) {
+          if (data.quality == '\0' || data.quality == '0') {
+            return std::nullopt;
+          }
+          double hdop = detail::parse_number(data.hdop).value_or(unknown);
+          return Fix{data.utc_time, data.latitude.value, data.longitude.value,
+                     unknown, hdop};
+        } else if constexpr (std::is_same_v<T, GNS>) {
+          // One character per constellation; 'N' means no fix from it.
+          std::string_view mode = data.mode;
+          if (mode.find_first_not_of('N') == std::string_view::npos) {
+            return std::nullopt;
+          }
+          double hdop = detail::parse_number(data.hdop).value_or(unknown);
+          return Fix{data.utc_time, data.latitude.value, data.longitude.value,
+                     unknown, hdop};
+        } else if constexpr (std::is_same_v<T, GLL>) {
+          if (data.status != 'A') {
+            return std::nullopt;
+          }
+          return Fix{data.utc_time, data.latitude.value, data.longitude.value,
+                     unknown, unknown};
+        } else {
+          return std::nullopt;
+        }
+      },
+      sample);
+}
+} // namespace gps_lib
@@ -0,0 +1,544 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+
+#include "rtcm.h"
+#include "ubx.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Splits a byte stream into NMEA sentences.
+ *
+ * Bytes may arrive in chunks of any size. A sentence starts at '$' and ends
+ * at the line feed; a trailing carriage return is removed. Sentences that lie
+ * entirely inside one chunk are emitted as views into that chunk without
+ * copying, and only sentences split across chunks are buffered. A '$' in the
+ * middle of a sentence restarts framing, so the framer resynchronizes after
+ * line noise, and sentences longer than Capacity are dropped.
+ *
+ * @tparam Capacity Maximum sentence length in bytes. NMEA 0183 limits
+ * sentences to 82 bytes; the default leaves room for proprietary ones.
+ */
+template <std::size_t Capacity = 128> class SentenceFramer {
+public:
+  /**
+   * @brief Consumes a chunk of the stream.
+   * @param data The bytes received.
+   * @param emit Callback invoked with every complete sentence. The view is
+   * only valid during the call.
+   * @return  void    This function does not return a value.
+   */
+  template <std::invocable<std::string_view> Emit>
+  void push(std::string_view data, Emit &&emit) {
+    while (!data.empty()) {
+      if (!synced_) {
+        std::size_t start = data.find('$');
+        if (start == std::string_view::npos) {
+          return;
+        }
+        data.remove_prefix(start);
+        synced_ = true;
+        size_ = 0;
+      }
+
+      // The '$' that opened the sentence is either buffered or data[0].
+      std::size_t end = data.find_first_of("\n$", size_ == 0 ? 1 : 0);
+
+      if (end == std::string_view::npos) {
+        append(data);
+        return;
+      }
+
+      if (data[end] == '$') {
+        ++dropped_;
+        synced_ = false;
+        data.remove_prefix(end);
+        continue;
+      }
+
+      std::string_view line = data.substr(0, end);
+      data.remove_prefix(end + 1);
+
+      if (size_ != 0) {
+        if (!append(line)) {
+          continue;
+        }
+        line = std::string_view{buffer_.data(), size_};
+      }
+
+      synced_ = false;
+      emit_line(line, emit);
+    }
+  }
+
+  /**
+   * @brief Emits the buffered sentence, if any, as if a line feed followed
+   * it. Used at the end of a datagram or when a connection closes.
+   * @param emit Callback invoked with the sentence.
+   * @return  void    This function does not return a value.
+   */
+  template <std::invocable<std::string_view> Emit> void flush(Emit &&emit) {
+    if (synced_) {
+      synced_ = false;
+      emit_line(std::string_view{buffer_.data(), size_}, emit);
+    }
+  }
+
+  /**
+   * @brief Returns the number of sentences dropped because they were too
+   * long or interrupted by another '$'.
+   * @return  std::size_t     The number of dropped sentences.
+   */
+  std::size_t dropped() const { return dropped_; }
+
+private:
+  /**
+   * @brief Buffers part of a sentence, dropping it if it does not fit.
+   * @param data The bytes to buffer.
+   * @return  bool    True if the bytes were buffered.
+   */
+  bool append(std::string_view data) {
+    if (data.size() > Capacity - size_) {
+      ++dropped_;
+      synced_ = false;
+      return false;
+    }
+
+    data.copy(buffer_.data() + size_, data.size());
+    size_ += data.size();
+
+    return true;
+  }
+
+  /**
+   * @brief Emits a complete line after removing its carriage return.
+   * @param line The line without its line feed.
+   * @param emit Callback invoked with the sentence.
+   * @return  void    This function does not return a value.
+   */
+  template <typename Emit> void emit_line(std::string_view line, Emit &emit) {
+    if (line.ends_with('\r')) {
+      line.remove_suffix(1);
+    }
+
+    if (line.size() > Capacity) {
+      ++dropped_;
+    } else if (line.size() > 1) {
+      emit(line);
+    }
+
+    size_ = 0;
+  }
+
+  std::array<char, Capacity> buffer_{}; ///< Sentence split across chunks.
+  std::size_t size_{0};                 ///< Bytes in buffer_.
+  std::size_t dropped_{0};              ///< Sentences dropped so far.
+  bool synced_{false};                  ///< True inside a sentence.
+};
+
+/**
+ * @brief Splits a byte stream that mixes NMEA sentences with UBX and RTCM3
+ * frames, as sent by u-blox receivers with several protocols enabled on one
+ * port or by RTK base stations interleaving corrections with NMEA.
+ *
+ * A sentence starts at '$' and ends at the line feed, as in SentenceFramer.
+ * A UBX frame starts at its sync characters and an RTCM3 frame at its
+ * preamble; both end after the checksum their length field places. Binary
+ * payloads and line noise can contain those start bytes, so when a frame
+ * turns out to be too long or its checksum or CRC fails, only its first byte
+ * is skipped and the bytes after it are scanned again, which recovers the
+ * sentences and frames a false start would otherwise swallow. Sentences and
+ * frames that lie inside one chunk are emitted as views into that chunk;
+ * only those split across chunks are buffered.
+ *
+ * The callback is invoked with a std::string_view for every sentence and,
+ * if it accepts them, with a UbxFrame or an RtcmFrame for every frame, so it
+ * is typically an overloaded set of lambdas:
+ *
+ * @code
+ * framer.push(chunk, overloaded{
+ *     [&](std::string_view sentence) { parse_into(sample, sentence); },
+ *     [&](const UbxFrame &frame) {
+ *       if (auto pvt = UbxNavPvt::from(frame)) {
+ *         consume(to_fix(*pvt));
+ *       }
+ *     },
+ *     [&](const RtcmFrame &frame) { rover.write(frame.bytes); }});
+ * @endcode
+ *
+ * @tparam Capacity Maximum sentence or frame length in bytes. The default
+ * holds a UBX-NAV-SAT frame for about 340 satellites.
+ */
+template <std::size_t Capacity = 4096> class MixedFramer {
+public:
+  /**
+   * @brief Consumes a chunk of the stream.
+   * @param data The bytes received.
+   * @param emit Callback invoked with every complete sentence and frame. The
+   * views are only valid during the call.
+   * @return  void    This function does not return a value.
+   */
+  template <std::invocable<std::string_view> Emit>
+  void push(std::string_view data, Emit &&emit) {
+    for (;;) {
+      if (state_ == State::Rescan) {
+        requeue();
+      }
+
+      // The bytes of a rejected frame are read again before the new ones.
+      bool pending = pending_begin_ != pending_end_;
+      std::string_view input =
+          pending ? std::string_view{buffer_.data() + pending_begin_,
+                                     pending_end_ - pending_begin_}
+                  : data;
+      if (input.empty()) {
+        return;
+      }
+
+      input = step(input, emit);
+
+      if (pending) {
+        pending_begin_ = pending_end_ - input.size();
+      } else {
+        data = input;
+      }
+    }
+  }
+
+  /**
+   * @brief Emits the buffered sentence, if any, as if a line feed followed
+   * it, and drops a partial frame. Used when a connection closes.
+   * @param emit Callback invoked with the sentence.
+   * @return  void    This function does not return a value.
+   */
+  template <std::invocable<std::string_view> Emit> void flush(Emit &&emit) {
+    // A partial frame may be a false start hiding sentences: rescan it.
+    while (state_ == State::Ubx || state_ == State::Rtcm) {
+      ++dropped_;
+      state_ = State::Rescan;
+      push({}, emit);
+    }
+
+    if (state_ == State::Nmea) {
+      emit_line(std::string_view{buffer_.data(), size_}, emit);
+    }
+
+    state_ = State::Idle;
+    size_ = 0;
+  }
+
+  /**
+   * @brief Returns the number of sentences dropped because they were too
+   * long or interrupted, and of frames cut short by flush().
+   * @return  std::size_t     The number of dropped sentences and frames.
+   */
+  std::size_t dropped() const { return dropped_; }
+
+  /**
+   * @brief Returns the number of UBX and RTCM3 frames whose checksum failed.
+   * Their bytes after the first were scanned again.
+   * @return  std::size_t     The number of corrupt frames.
+   */
+  std::size_t checksum_failures() const { return checksum_failures_; }
+
+  /**
+   * @brief Returns the number of false frame starts: a sync byte or
+   * preamble without the second sync byte or zero reserved bits after it,
+   * or with a length beyond Capacity. Each was skipped as one byte of noise
+   * and is not counted as a checksum failure.
+   * @return  std::size_t     The number of false starts.
+   */
+  std::size_t resyncs() const { return resyncs_; }
+
+private:
+  /**
+   * @brief What the framer is reading.
+   */
+  enum class State : std::uint8_t {
+    Idle,  ///< Looking for the start of a sentence or frame.
+    Nmea,  ///< Inside a sentence.
+    Ubx,   ///< Inside a UBX frame.
+    Rtcm,  ///< Inside an RTCM3 frame.
+    Rescan ///< The buffered frame was rejected; its bytes are read again.
+  };
+
+  /// Bytes that start a sentence or a frame.
+  static constexpr std::string_view START{"$\xB5\xD3"};
+  /// Bytes that end or interrupt a sentence.
+  static constexpr std::string_view NMEA_END{"\n$\xB5\xD3"};
+
+  /**
+   * @brief Consumes bytes of the stream, up to the end of the current
+   * sentence or frame.
+   * @param data The bytes.
+   * @param emit Callback invoked with the sentence or frame if it completes.
+   * @return  std::string_view    The bytes left over.
+   */
+  template <typename Emit>
+  std::string_view step(std::string_view data, Emit &emit) {
+    if (state_ == State::Idle) {
+      std::size_t start = data.find_first_of(START);
+      if (start == std::string_view::npos) {
+        return {};
+      }
+      data.remove_prefix(start);
+      state_ = data[0] == '$'          ? State::Nmea
+               : data[0] == UBX_SYNC_1 ? State::Ubx
+                                       : State::Rtcm;
+      size_ = 0;
+    }
+
+    return state_ == State::Nmea ? push_nmea(data, emit)
+                                 : push_frame(data, emit);
+  }
+
+  /**
+   * @brief Queues the buffered bytes of a rejected frame, all but the first,
+   * to be read again before the rest of the input.
+   * @return  void    This function does not return a value.
+   */
+  void requeue() {
+    // A frame is only buffered once the input in hand ends before it does,
+    // so no pending bytes are left when a buffered frame is rejected, and
+    // buffer_[1, size_) can be read again where it lies.
+    if (size_ > 1) {
+      pending_begin_ = 1;
+      pending_end_ = size_;
+    }
+
+    state_ = State::Idle;
+    size_ = 0;
+  }
+
+  /**
+   * @brief Consumes bytes of a sentence.
+   * @param data The bytes, starting inside the sentence.
+   * @param emit Callback invoked with the sentence if it completes.
+   * @return  std::string_view    The bytes left over.
+   */
+  template <typename Emit>
+  std::string_view push_nmea(std::string_view data, Emit &emit) {
+    // The '$' that opened the sentence is either buffered or data[0].
+    std::size_t end = data.find_first_of(NMEA_END, size_ == 0 ? 1 : 0);
+
+    if (end == std::string_view::npos) {
+      append(data);
+      return {};
+    }
+
+    if (data[end] != '\n') {
+      ++dropped_;
+      state_ = State::Idle;
+      return data.substr(end);
+    }
+
+    std::string_view line = data.substr(0, end);
+    data.remove_prefix(end + 1);
+
+    if (size_ != 0) {
+      if (!append(line)) {
+        return data;
+      }
+      line = std::string_view{buffer_.data(), size_};
+    }
+
+    state_ = State::Idle;
+    emit_line(line, emit);
+    return data;
+  }
+
+  /**
+   * @brief Consumes bytes of a UBX or RTCM3 frame.
+   * @param data The bytes, starting inside the frame.
+   * @param emit Callback invoked with the frame if it completes.
+   * @return  std::string_view    The bytes left over.
+   */
+  template <typename Emit>
+  std::string_view push_frame(std::string_view data, Emit &emit) {
+    std::size_t header_size = state_ == State::Ubx ? UBX_HEADER_SIZE
+                                                   : RTCM_HEADER_SIZE;
+
+    if (size_ == 0) {
+      if (data.size() >= 2 && !continues_start(data[1])) {
+        ++resyncs_;
+        state_ = State::Idle;
+        return data.substr(1);
+      }
+
+      // The whole frame is in the chunk: emit it in place, or skip its
+      // first byte if it was a false start.
+      if (data.size() >= header_size) {
+        std::size_t total = frame_size(data);
+        if (total > Capacity) {
+          ++resyncs_;
+          state_ = State::Idle;
+          return data.substr(1);
+        }
+        if (data.size() >= total) {
+          return data.substr(emit_frame(data.substr(0, total), emit) ? total
+                                                                     : 1);
+        }
+      }
+    } else if (size_ == 1 && !continues_start(data[0])) {
+      // The first byte was noise.
+      ++resyncs_;
+      state_ = State::Idle;
+      size_ = 0;
+      return data;
+    }
+
+    // The frame is split across chunks: buffer its header, then the rest.
+    std::string_view buffered{buffer_.data(), size_};
+    std::size_t total =
+        size_ < header_size ? header_size : frame_size(buffered);
+    std::size_t take = std::min(total - size_, data.size());
+
+    store(data.substr(0, take));
+    data.remove_prefix(take);
+
+    if (size_ == header_size &&
+        frame_size({buffer_.data(), size_}) > Capacity) {
+      ++resyncs_;
+      state_ = State::Rescan;
+    } else if (size_ == total && total != header_size) {
+      emit_frame({buffer_.data(), size_}, emit);
+    }
+
+    return data;
+  }
+
+  /**
+   * @brief Checks the byte after the first one of a frame, which tells a
+   * frame from noise that happens to match its first byte.
+   * @param c The second byte.
+   * @return  bool    True for the second UBX sync character, or for RTCM3
+   * reserved bits that are all zero.
+   */
+  bool continues_start(char c) const {
+    return state_ == State::Ubx ? c == UBX_SYNC_2 : (c & 0xFC) == 0;
+  }
+
+  /**
+   * @brief Returns the size of a frame from its header.
+   * @param header At least the header bytes of the frame.
+   * @return  std::size_t     The size of the whole frame.
+   */
+  std::size_t frame_size(std::string_view header) const {
+    return state_ == State::Ubx
+               ? detail::read_le<std::uint16_t>(header, 4) + UBX_FRAME_OVERHEAD
+               : rtcm_payload_size(header) + RTCM_FRAME_OVERHEAD;
+  }
+
+  /**
+   * @brief Buffers part of a sentence, dropping it if it does not fit.
+   * @param data The bytes to buffer.
+   * @return  bool    True if the bytes were buffered.
+   */
+  bool append(std::string_view data) {
+    if (data.size() > Capacity - size_) {
+      ++dropped_;
+      state_ = State::Idle;
+      return false;
+    }
+
+    store(data);
+    return true;
+  }
+
+  /**
+   * @brief Copies bytes to the end of the buffer. They may lie further on
+   * in the buffer itself, when a rejected frame is read again.
+   * @param data The bytes.
+   * @return  void    This function does not return a value.
+   */
+  void store(std::string_view data) {
+    std::char_traits<char>::move(buffer_.data() + size_, data.data(),
+                                 data.size());
+    size_ += data.size();
+  }
+
+  /**
+   * @brief Emits a complete line after removing its carriage return.
+   * @param line The line without its line feed.
+   * @param emit Callback invoked with the sentence.
+   * @return  void    This function does not return a value.
+   */
+  template <typename Emit> void emit_line(std::string_view line, Emit &emit) {
+    if (line.ends_with('\r')) {
+      line.remove_suffix(1);
+    }
+
+    if (line.size() > Capacity) {
+      ++dropped_;
+    } else if (line.size() > 1) {
+      emit(line);
+    }
+
+    size_ = 0;
+  }
+
+  /**
+   * @brief Checks a complete frame and emits it. A frame whose checksum
+   * fails is counted, and its bytes are rescanned after the first one.
+   * @param frame The frame, from its first byte to the checksum.
+   * @param emit Callback invoked with the frame, if it takes the frame type.
+   * @return  bool    True if the frame was valid.
+   */
+  template <typename Emit>
+  bool emit_frame(std::string_view frame, Emit &emit) {
+    bool valid = state_ == State::Ubx
+                     ? emit_decoded(decode_ubx(frame), emit)
+                     : emit_decoded(decode_rtcm(frame), emit);
+
+    if (valid) {
+      state_ = State::Idle;
+      size_ = 0;
+    } else {
+      ++checksum_failures_;
+      state_ = State::Rescan;
+    }
+
+    return valid;
+  }
+
+  /**
+   * @brief Emits a decoded frame.
+   * @param decoded The frame or the decoding error.
+   * @param emit Callback invoked with the frame, if it takes the frame type.
+   * @return  bool    True if the frame was decoded.
+   */
+  template <typename Frame, typename Emit>
+  bool emit_decoded(const std::expected<Frame, ParseError> &decoded,
+                    Emit &emit) {
+    if (!decoded) {
+      return false;
+    }
+
+    if constexpr (std::invocable<Emit &, const Frame &>) {
+      emit(*decoded);
+    }
+    return true;
+  }
+
+  std::array<char, Capacity> buffer_{}; ///< Data split across chunks.
+  std::size_t size_{0};                 ///< Bytes in buffer_.
+  std::size_t dropped_{0};              ///< Data dropped so far.
+  std::size_t checksum_failures_{0};    ///< Corrupt frames so far.
+  std::size_t resyncs_{0};              ///< False frame starts so far.
+  std::size_t pending_begin_{0};        ///< Start of the bytes to reread.
+  std::size_t pending_end_{0};          ///< End of the bytes to reread.
+  State state_{State::Idle};            ///< What is being read.
+};
+} // namespace gps_lib
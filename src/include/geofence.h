@@ -0,0 +1,306 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief This struct represents a polygon vertex in decimal degrees.
+ */
+struct Vertex {
+  double latitude;  ///< Latitude in decimal degrees.
+  double longitude; ///< Longitude in decimal degrees.
+};
+
+/**
+ * @brief This struct represents a receiver entering or leaving a geofence.
+ */
+struct GeofenceEvent {
+  std::uint64_t receiver; ///< Receiver that crossed the fence.
+  std::uint32_t fence;    ///< Identifier of the fence.
+  bool entered;           ///< True when entering, false when leaving.
+};
+
+/**
+ * @brief Indexes many polygons for fast point-in-polygon queries.
+ *
+ * Polygons are stored as flat edge arrays and bucketed into a uniform grid
+ * over their combined bounding box, so a query only tests the polygons whose
+ * bounding box overlaps the cell of the point. Coordinates are treated as
+ * planar degrees, which is accurate for geofence-sized polygons that do not
+ * cross the antimeridian.
+ */
+class GeofenceIndex {
+public:
+  /**
+   * @brief Adds a polygon to the index. Call build() before querying.
+   * @param id The identifier reported for this fence.
+   * @param polygon The vertices of the polygon, open or closed.
+   * @return  void    This function does not return a value.
+   */
+  void add(std::uint32_t id, std::span<const Vertex> polygon) {
+    Fence fence{id,
+                std::numeric_limits<double>::max(),
+                std::numeric_limits<double>::max(),
+                std::numeric_limits<double>::lowest(),
+                std::numeric_limits<double>::lowest(),
+                static_cast<std::uint32_t>(edges_.size()),
+                0};
+
+    for (std::size_t i = 0; i < polygon.size(); ++i) {
+      const Vertex &from = polygon[i];
+      const Vertex &to = polygon[(i + 1) % polygon.size()];
+
+      fence.min_latitude = std::min(fence.min_latitude, from.latitude);
+      fence.min_longitude = std::min(fence.min_longitude, from.longitude);
+      fence.max_latitude = std::max(fence.max_latitude, from.latitude);
+      fence.max_longitude = std::max(fence.max_longitude, from.longitude);
+
+      // Horizontal edges never cross a ray cast along the longitude axis.
+      if (from.latitude != to.latitude) {
+        edges_.push_back({from.latitude, to.latitude, from.longitude,
+                          (to.longitude - from.longitude) /
+                              (to.latitude - from.latitude)});
+      }
+    }
+
+    fence.edge_end = static_cast<std::uint32_t>(edges_.size());
+    fences_.push_back(fence);
+  }
+
+  /**
+   * @brief Builds the grid over all added polygons.
+   * @param cells_per_fence Target number of grid cells per polygon.
+   * @return  void    This function does not return a value.
+   */
+  void build(std::size_t cells_per_fence = 4) {
+    min_latitude_ = min_longitude_ = std::numeric_limits<double>::max();
+    double max_latitude = std::numeric_limits<double>::lowest();
+    double max_longitude = std::numeric_limits<double>::lowest();
+
+    for (const Fence &fence : fences_) {
+      min_latitude_ = std::min(min_latitude_, fence.min_latitude);
+      min_longitude_ = std::min(min_longitude_, fence.min_longitude);
+      max_latitude = std::max(max_latitude, fence.max_latitude);
+      max_longitude = std::max(max_longitude, fence.max_longitude);
+    }
+
+    double cells = static_cast<double>(fences_.size() * cells_per_fence);
+    side_ = std::max<std::size_t>(
+        1, static_cast<std::size_t>(std::ceil(std::sqrt(cells))));
+    cell_height_ = std::max(max_latitude - min_latitude_, 1e-9) /
+                   static_cast<double>(side_);
+    cell_width_ = std::max(max_longitude - min_longitude_, 1e-9) /
+                  static_cast<double>(side_);
+
+    // Counting pass, then fill the cells in compressed row form.
+    cell_offsets_.assign(side_ * side_ + 1, 0);
+    for_each_cell_of_fences([&](std::size_t cell, std::uint32_t) {
+      ++cell_offsets_[cell + 1];
+    });
+    for (std::size_t i = 1; i < cell_offsets_.size(); ++i) {
+      cell_offsets_[i] += cell_offsets_[i - 1];
+    }
+
+    cell_fences_.resize(cell_offsets_.back());
+    std::vector<std::uint32_t> cursor(cell_offsets_.begin(),
+                                      cell_offsets_.end() - 1);
+    for_each_cell_of_fences([&](std::size_t cell, std::uint32_t fence) {
+      cell_fences_[cursor[cell]++] = fence;
+    });
+  }
+
+  /**
+   * @brief Visits every fence that contains a position.
+   * @param latitude The latitude in decimal degrees.
+   * @param longitude The longitude in decimal degrees.
+   * @param visit Callback invoked with the identifier of each fence.
+   * @return  void    This function does not return a value.
+   */
+  template <std::invocable<std::uint32_t> Visit>
+  void query(double latitude, double longitude, Visit &&visit) const {
+    double row = (latitude - min_latitude_) / cell_height_;
+    double column = (longitude - min_longitude_) / cell_width_;
+
+    if (!(row >= 0.0 && column >= 0.0 && row < static_cast<double>(side_) &&
+          column < static_cast<double>(side_))) {
+      return;
+    }
+
+    std::size_t cell = static_cast<std::size_t>(row) * side_ +
+                       static_cast<std::size_t>(column);
+
+    for (std::uint32_t i = cell_offsets_[cell]; i < cell_offsets_[cell + 1];
+         ++i) {
+      const Fence &fence = fences_[cell_fences_[i]];
+      if (contains(fence, latitude, longitude)) {
+        visit(fence.id);
+      }
+    }
+  }
+
+  /**
+   * @brief Returns the number of fences in the index.
+   * @return  std::size_t     The number of fences.
+   */
+  std::size_t size() const { return fences_.size(); }
+
+private:
+  /**
+   * @brief This struct stores the bounding box and edge range of a polygon.
+   */
+  struct Fence {
+    std::uint32_t id;         ///< Identifier reported for the fence.
+    double min_latitude;      ///< Southern bound.
+    double min_longitude;     ///< Western bound.
+    double max_latitude;      ///< Northern bound.
+    double max_longitude;     ///< Eastern bound.
+    std::uint32_t edge_begin; ///< First edge in edges_.
+    std::uint32_t edge_end;   ///< One past the last edge in edges_.
+  };
+
+  /**
+   * @brief This struct stores a non-horizontal polygon edge for the crossing
+   * test.
+   */
+  struct Edge {
+    double latitude0;  ///< Latitude of the first vertex.
+    double latitude1;  ///< Latitude of the second vertex.
+    double longitude0; ///< Longitude of the first vertex.
+    double slope;      ///< Longitude change per degree of latitude.
+  };
+
+  /**
+   * @brief Tests whether a fence contains a position with the crossing rule.
+   * @param fence The fence to test.
+   * @param latitude The latitude in decimal degrees.
+   * @param longitude The longitude in decimal degrees.
+   * @return  bool    True if the position is inside the polygon.
+   */
+  bool contains(const Fence &fence, double latitude, double longitude) const {
+    if (latitude < fence.min_latitude || latitude > fence.max_latitude ||
+        longitude < fence.min_longitude || longitude > fence.max_longitude) {
+      return false;
+    }
+
+    bool inside = false;
+
+    for (std::uint32_t i = fence.edge_begin; i < fence.edge_end; ++i) {
+      const Edge &edge = edges_[i];
+      bool spans = (edge.latitude0 > latitude) != (edge.latitude1 > latitude);
+      bool left = longitude < edge.longitude0 +
+                                  (latitude - edge.latitude0) * edge.slope;
+      inside ^= spans & left;
+    }
+
+    return inside;
+  }
+
+  /**
+   * @brief Visits every grid cell overlapped by the bounding box of each
+   * fence.
+   * @param visit Callback invoked with the cell and the fence index.
+   * @return  void    This function does not return a value.
+   */
+  template <typename Visit> void for_each_cell_of_fences(Visit &&visit) {
+    auto clamp_cell = [&](double value) {
+      return std::min(static_cast<std::size_t>(std::max(value, 0.0)),
+                      side_ - 1);
+    };
+
+    for (std::uint32_t f = 0; f < fences_.size(); ++f) {
+      const Fence &fence = fences_[f];
+      std::size_t row0 =
+          clamp_cell((fence.min_latitude - min_latitude_) / cell_height_);
+      std::size_t row1 =
+          clamp_cell((fence.max_latitude - min_latitude_) / cell_height_);
+      std::size_t column0 =
+          clamp_cell((fence.min_longitude - min_longitude_) / cell_width_);
+      std::size_t column1 =
+          clamp_cell((fence.max_longitude - min_longitude_) / cell_width_);
+
+      for (std::size_t row = row0; row <= row1; ++row) {
+        for (std::size_t column = column0; column <= column1; ++column) {
+          visit(row * side_ + column, f);
+        }
+      }
+    }
+  }
+
+  std::vector<Fence> fences_;               ///< Indexed polygons.
+  std::vector<Edge> edges_;                 ///< Edges of all polygons.
+  std::vector<std::uint32_t> cell_offsets_; ///< First fence of each cell.
+  std::vector<std::uint32_t> cell_fences_;  ///< Fence indices per cell.
+  std::size_t side_{0};                     ///< Cells per grid side.
+  double min_latitude_{0.0};                ///< Southern bound of the grid.
+  double min_longitude_{0.0};               ///< Western bound of the grid.
+  double cell_height_{1.0};                 ///< Cell height in degrees.
+  double cell_width_{1.0};                  ///< Cell width in degrees.
+};
+
+/**
+ * @brief Tracks which fences each receiver is inside and reports enter and
+ * exit transitions.
+ */
+class GeofenceTracker {
+public:
+  /**
+   * @brief Constructs a tracker over a built index.
+   * @param index The geofence index. It must outlive the tracker.
+   */
+  explicit GeofenceTracker(const GeofenceIndex &index) : index_{index} {}
+
+  /**
+   * @brief Updates the position of a receiver.
+   * @param receiver The receiver identifier.
+   * @param fix The new fix of the receiver.
+   * @param emit Callback invoked with every enter and exit transition.
+   * @return  void    This function does not return a value.
+   */
+  template <std::invocable<const GeofenceEvent &> Emit>
+  void update(std::uint64_t receiver, const Fix &fix, Emit &&emit) {
+    scratch_.clear();
+    index_.query(fix.latitude, fix.longitude,
+                 [&](std::uint32_t fence) { scratch_.push_back(fence); });
+    std::sort(scratch_.begin(), scratch_.end());
+
+    std::vector<std::uint32_t> &inside = inside_[receiver];
+    auto before = inside.begin();
+    auto now = scratch_.begin();
+
+    // Both lists are sorted, so one merge pass finds every transition.
+    while (before != inside.end() || now != scratch_.end()) {
+      if (now == scratch_.end() || (before != inside.end() && *before < *now)) {
+        emit(GeofenceEvent{receiver, *before++, false});
+      } else if (before == inside.end() || *now < *before) {
+        emit(GeofenceEvent{receiver, *now++, true});
+      } else {
+        ++before;
+        ++now;
+      }
+    }
+
+    inside.swap(scratch_);
+  }
+
+private:
+  const GeofenceIndex &index_;         ///< Fences to test against.
+  std::vector<std::uint32_t> scratch_; ///< Reused query buffer.
+  /// Sorted identifiers of the fences each receiver is inside.
+  std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> inside_;
+};
+} // namespace gps_lib
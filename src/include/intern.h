@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string_view>
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Names of the sentence types, in the order of the Sample variant.
+ */
+constexpr std::array<std::string_view, 12> SENTENCE_NAMES{
+    "GGA", "GLL", "GSA", "GSV", "RMC", "VTG",
+    "ZDA", "GST", "GBS", "GNS", "RMB", "HDT"};
+
+/**
+ * @brief The sentence types, in the order of the Sample variant and of
+ * SENTENCE_NAMES.
+ */
+enum class SentenceType : std::uint8_t {
+  GGA,
+  GLL,
+  GSA,
+  GSV,
+  RMC,
+  VTG,
+  ZDA,
+  GST,
+  GBS,
+  GNS,
+  RMB,
+  HDT
+};
+
+/**
+ * @brief Talker identifiers known by name; any other talker maps to the last
+ * entry.
+ */
+constexpr std::array<std::string_view, 8> TALKER_NAMES{
+    "GP", "GL", "GA", "GB", "GQ", "GI", "GN", "other"};
+
+/**
+ * @brief The talkers of TALKER_NAMES, in the same order.
+ */
+enum class Talker : std::uint8_t { GP, GL, GA, GB, GQ, GI, GN, Other };
+
+/**
+ * @brief Returns the talker of a sentence.
+ * @param sentence The sentence or its address field, e.g. "$GPGGA".
+ * @return  Talker  The talker, or Talker::Other if it has no name.
+ */
+constexpr Talker talker_of(std::string_view sentence) {
+  std::string_view talker = sentence.substr(sentence.starts_with('$'), 2);
+  std::size_t index = 0;
+
+  while (index + 1 < TALKER_NAMES.size() && TALKER_NAMES[index] != talker) {
+    ++index;
+  }
+
+  return static_cast<Talker>(index);
+}
+
+/**
+ * @brief The address field of a sentence, e.g. "$GPGGA", as its talker and
+ * sentence type.
+ *
+ * Both parts come from fixed code sets, so an address takes four bytes,
+ * never allocates and compares in a few instructions, however many distinct
+ * addresses a stream contains. A talker without a name, e.g. "BD", keeps its
+ * two characters, so it reads back as it was sent.
+ */
+struct Address {
+  Talker talker{Talker::Other};         ///< Talker, Other if it has no name.
+  SentenceType type{SentenceType::GGA}; ///< Sentence type.
+  /// Characters of a talker without a name, "--" for a named one.
+  std::array<char, 2> other{'-', '-'};
+
+  /**
+   * @brief Compares two addresses.
+   * @return  bool    True if both talker and type match.
+   */
+  friend constexpr bool operator==(Address, Address) = default;
+};
+
+/**
+ * @brief Returns the address of a sentence.
+ * @param field The address field, e.g. "$GPGGA".
+ * @param type The sentence type.
+ * @return  Address The address, keeping the characters of a talker without
+ * a name.
+ */
+constexpr Address address_of(std::string_view field, SentenceType type) {
+  Address address{talker_of(field), type};
+
+  if (address.talker == Talker::Other) {
+    std::string_view talker = field.substr(field.starts_with('$'), 2);
+    talker.copy(address.other.data(), address.other.size());
+  }
+  return address;
+}
+
+/**
+ * @brief Returns the talker of an address as text.
+ * @param address The address.
+ * @return  std::string_view    The talker, e.g. "GP" or "BD".
+ */
+constexpr std::string_view talker_name(const Address &address) {
+  if (address.talker == Talker::Other) {
+    return {address.other.data(), address.other.size()};
+  }
+  return TALKER_NAMES[static_cast<std::size_t>(address.talker)];
+}
+
+namespace detail {
+/**
+ * @brief Views a single-character field as text.
+ * @param field The field, '\0' if the sentence left it empty.
+ * @return  std::string_view    The character, or an empty view.
+ */
+constexpr std::string_view char_field(const char &field) {
+  return {&field, field == '\0' ? 0u : 1u};
+}
+} // namespace detail
+} // namespace gps_lib
+
+/**
+ * @brief Formats an Address as the address field, e.g. "$GPGGA", accepting
+ * the string format spec.
+ */
+template <>
+struct std::formatter<gps_lib::Address> : std::formatter<std::string_view> {
+  /**
+   * @brief Formats an address.
+   * @param address The address.
+   * @param context The format context.
+   * @return  std::format_context::iterator   The end of the output.
+   */
+  auto format(gps_lib::Address address, std::format_context &context) const {
+    std::array<char, 6> field{'$'};
+    std::string_view talker = gps_lib::talker_name(address);
+    std::string_view type =
+        gps_lib::SENTENCE_NAMES[static_cast<std::size_t>(address.type)];
+
+    talker.copy(field.data() + 1, 2);
+    type.copy(field.data() + 3, 3);
+    return std::formatter<std::string_view>::format(
+        {field.data(), field.size()}, context);
+  }
+};
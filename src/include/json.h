@@ -1,8 +1,13 @@
 #pragma once
 
+#include <chrono>
+#include <format>
 #include <fstream>
 #include <nlohmann/json.hpp>
+#include <print>
+#include <string>
 
+#include "detail/trace.h"
 #include "types.h"
 
 /**
@@ -11,6 +16,25 @@
  * sentences.
  */
 namespace gps_lib {
+/**
+ * @brief Formats a timestamp as an ISO 8601 UTC string.
+ * @param time The timestamp to format.
+ * @return  std::string     The formatted timestamp, such as
+ * 2018-02-01T21:10:41.000Z.
+ */
+inline std::string to_iso8601(Timestamp time) {
+  return std::format("{:%FT%TZ}", time);
+}
+
+/**
+ * @brief Serializes a sentence address to JSON, e.g. "$GPGGA".
+ * @param j The JSON object to populate.
+ * @param address The Address to serialize.
+ */
+inline void to_json(nlohmann::json &j, const Address &address) {
+  j = std::format("{}", address);
+}
+
 /**
  * @brief Serializes a Latitude object to JSON.
  * @param j The JSON object to populate.
@@ -50,10 +74,10 @@ inline void to_json(nlohmann::json &j, const Satellite &sat) {
  */
 inline void to_json(nlohmann::json &j, const GGA &gga) {
   j = nlohmann::json{{"type", gga.type},
-                     {"utc_time", gga.utc_time},
+                     {"utc_time", to_iso8601(gga.utc_time)},
                      {"latitude", gga.latitude},
                      {"longitude", gga.longitude},
-                     {"quality", gga.quality},
+                     {"quality", detail::char_field(gga.quality)},
                      {"satellites_used", gga.satellites_used},
                      {"hdop", gga.hdop},
                      {"altitude", gga.altitude},
@@ -70,8 +94,8 @@ inline void to_json(nlohmann::json &j, const GLL &gll) {
   j = nlohmann::json{{"type", gll.type},
                      {"latitude", gll.latitude},
                      {"longitude", gll.longitude},
-                     {"utc_time", gll.utc_time},
-                     {"status", gll.status}};
+                     {"utc_time", to_iso8601(gll.utc_time)},
+                     {"status", detail::char_field(gll.status)}};
 }
 
 /**
@@ -80,10 +104,14 @@ inline void to_json(nlohmann::json &j, const GLL &gll) {
  * @param gsa The GSA object to serialize.
  */
 inline void to_json(nlohmann::json &j, const GSA &gsa) {
-  j = nlohmann::json{{"type", gsa.type},         {"mode", gsa.mode},
-                     {"fix_type", gsa.fix_type}, {"satellites", gsa.satellites},
-                     {"pdop", gsa.pdop},         {"hdop", gsa.hdop},
-                     {"vdop", gsa.vdop},         {"checksum", gsa.checksum}};
+  j = nlohmann::json{{"type", gsa.type},
+                     {"mode", detail::char_field(gsa.mode)},
+                     {"fix_type", detail::char_field(gsa.fix_type)},
+                     {"satellites", gsa.satellites},
+                     {"pdop", gsa.pdop},
+                     {"hdop", gsa.hdop},
+                     {"vdop", gsa.vdop},
+                     {"checksum", gsa.checksum}};
 }
 
 /**
@@ -106,14 +134,13 @@ inline void to_json(nlohmann::json &j, const GSV &gsv) {
  */
 inline void to_json(nlohmann::json &j, const RMC &rmc) {
   j = nlohmann::json{{"type", rmc.type},
-                     {"utc_time", rmc.utc_time},
-                     {"status", rmc.status},
+                     {"utc_time", to_iso8601(rmc.utc_time)},
+                     {"status", detail::char_field(rmc.status)},
                      {"latitude", rmc.latitude},
                      {"longitude", rmc.longitude},
                      {"speed", rmc.speed},
                      {"course", rmc.course},
-                     {"utc_date", rmc.utc_date},
-                     {"mode", rmc.mode}};
+                     {"mode", detail::char_field(rmc.mode)}};
 }
 
 /**
@@ -127,7 +154,7 @@ inline void to_json(nlohmann::json &j, const VTG &vtg) {
                      {"course_magnetic", vtg.course_magnetic},
                      {"speed_kn", vtg.speed_kn},
                      {"speed_kh", vtg.speed_kh},
-                     {"mode", vtg.mode}};
+                     {"mode", detail::char_field(vtg.mode)}};
 }
 
 /**
@@ -137,20 +164,103 @@ inline void to_json(nlohmann::json &j, const VTG &vtg) {
  */
 inline void to_json(nlohmann::json &j, const ZDA &zda) {
   j = nlohmann::json{{"type", zda.type},
-                     {"utc_time", zda.utc_time},
-                     {"utc_day", zda.utc_day},
-                     {"utc_month", zda.utc_month},
-                     {"utc_year", zda.utc_year},
+                     {"utc_time", to_iso8601(zda.utc_time)},
                      {"local_zone_hours", zda.local_zone_hours},
                      {"local_zone_minutes", zda.local_zone_minutes}};
 }
 
+/**
+ * @brief Serializes a GST object to JSON.
+ * @param j The JSON object to populate.
+ * @param gst The GST object to serialize.
+ */
+inline void to_json(nlohmann::json &j, const GST &gst) {
+  j = nlohmann::json{{"type", gst.type},
+                     {"utc_time", to_iso8601(gst.utc_time)},
+                     {"rms", gst.rms},
+                     {"semi_major_error", gst.semi_major_error},
+                     {"semi_minor_error", gst.semi_minor_error},
+                     {"orientation", gst.orientation},
+                     {"latitude_error", gst.latitude_error},
+                     {"longitude_error", gst.longitude_error},
+                     {"altitude_error", gst.altitude_error}};
+}
+
+/**
+ * @brief Serializes a GBS object to JSON.
+ * @param j The JSON object to populate.
+ * @param gbs The GBS object to serialize.
+ */
+inline void to_json(nlohmann::json &j, const GBS &gbs) {
+  j = nlohmann::json{{"type", gbs.type},
+                     {"utc_time", to_iso8601(gbs.utc_time)},
+                     {"latitude_error", gbs.latitude_error},
+                     {"longitude_error", gbs.longitude_error},
+                     {"altitude_error", gbs.altitude_error},
+                     {"failed_satellite", gbs.failed_satellite},
+                     {"probability", gbs.probability},
+                     {"bias", gbs.bias},
+                     {"bias_deviation", gbs.bias_deviation},
+                     {"system_id", gbs.system_id},
+                     {"signal_id", gbs.signal_id}};
+}
+
+/**
+ * @brief Serializes a GNS object to JSON.
+ * @param j The JSON object to populate.
+ * @param gns The GNS object to serialize.
+ */
+inline void to_json(nlohmann::json &j, const GNS &gns) {
+  j = nlohmann::json{{"type", gns.type},
+                     {"utc_time", to_iso8601(gns.utc_time)},
+                     {"latitude", gns.latitude},
+                     {"longitude", gns.longitude},
+                     {"mode", gns.mode},
+                     {"satellites_used", gns.satellites_used},
+                     {"hdop", gns.hdop},
+                     {"altitude", gns.altitude},
+                     {"geoidal_separation", gns.geoidal_separation},
+                     {"dgps", gns.dgps}};
+}
+
+/**
+ * @brief Serializes an RMB object to JSON.
+ * @param j The JSON object to populate.
+ * @param rmb The RMB object to serialize.
+ */
+inline void to_json(nlohmann::json &j, const RMB &rmb) {
+  j = nlohmann::json{{"type", rmb.type},
+                     {"status", detail::char_field(rmb.status)},
+                     {"cross_track_error", rmb.cross_track_error},
+                     {"steer", detail::char_field(rmb.steer)},
+                     {"origin", rmb.origin},
+                     {"destination", rmb.destination},
+                     {"destination_latitude", rmb.destination_latitude},
+                     {"destination_longitude", rmb.destination_longitude},
+                     {"range", rmb.range},
+                     {"bearing", rmb.bearing},
+                     {"closing_velocity", rmb.closing_velocity},
+                     {"arrival", detail::char_field(rmb.arrival)},
+                     {"mode", detail::char_field(rmb.mode)}};
+}
+
+/**
+ * @brief Serializes an HDT object to JSON.
+ * @param j The JSON object to populate.
+ * @param hdt The HDT object to serialize.
+ */
+inline void to_json(nlohmann::json &j, const HDT &hdt) {
+  j = nlohmann::json{{"type", hdt.type}, {"heading", hdt.heading}};
+}
+
 /**
  * @brief Serializes a Sample variant to JSON.
  * @param j The JSON object to populate.
  * @param sample The Sample variant to serialize.
  */
 inline void to_json(nlohmann::json &j, const Sample &sample) {
+  GPS_LIB_TRACE_SCOPE("to_json");
+
   std::visit(
       [&](const auto &value) {
         j = nlohmann::json{{"type", value.type}, {"data", value}};
@@ -165,6 +275,8 @@ inline void to_json(nlohmann::json &j, const Sample &sample) {
  * @return True if the file was written successfully, false otherwise.
  */
 inline bool save_to_json(const Sample &sample, const std::string &filename) {
+  GPS_LIB_TRACE_SCOPE("save_to_json");
+
   try {
     nlohmann::json j = sample;
     std::ofstream out(filename);
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "detail/geodesy.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief This constant represents the number of meters in a degree of
+ * latitude.
+ */
+constexpr double METERS_PER_DEGREE{detail::EARTH_RADIUS * detail::DEGTORAD};
+
+/**
+ * @brief This struct holds the tuning of the constant-velocity Kalman filter.
+ */
+struct KalmanParameters {
+  double acceleration_noise{0.5}; ///< Acceleration std deviation in m/s^2.
+  double uere{3.0};               ///< Range error in meters at HDOP 1.
+  double initial_velocity{10.0};  ///< Velocity std deviation in m/s at start.
+  double max_gap{10.0};           ///< Gap in seconds that restarts the filter.
+};
+
+/**
+ * @brief This struct represents a position measurement fed to the filter.
+ */
+struct KalmanMeasurement {
+  std::size_t receiver; ///< Index of the receiver in a KalmanBank.
+  double time;          ///< Measurement time in seconds since the epoch.
+  double latitude;      ///< Latitude in decimal degrees.
+  double longitude;     ///< Longitude in decimal degrees.
+  double hdop;          ///< Horizontal dilution of precision, NaN if unknown.
+};
+
+/**
+ * @brief This struct represents the filtered position and velocity.
+ */
+struct KalmanEstimate {
+  double latitude;       ///< Filtered latitude in decimal degrees.
+  double longitude;      ///< Filtered longitude in decimal degrees.
+  double east_velocity;  ///< Velocity towards the east in m/s.
+  double north_velocity; ///< Velocity towards the north in m/s.
+};
+
+/**
+ * @brief This struct holds the filter state of one receiver in a single cache
+ * line.
+ *
+ * The position is kept as a float offset from a local origin that follows the
+ * receiver, and both axes share one covariance because they see the same time
+ * steps and measurement noise.
+ */
+struct alignas(64) KalmanState {
+  double origin_latitude{};  ///< Latitude of the local origin.
+  double origin_longitude{}; ///< Longitude of the local origin.
+  /// Time of the last update in seconds, NaN before the first measurement.
+  double time{std::numeric_limits<double>::quiet_NaN()};
+
+  float origin_scale{};   ///< Meters per degree of longitude at the origin.
+  float east{};           ///< East offset from the origin in meters.
+  float east_velocity{};  ///< East velocity in m/s.
+  float north{};          ///< North offset from the origin in meters.
+  float north_velocity{}; ///< North velocity in m/s.
+  float position_var{};   ///< Position variance in m^2.
+  float covariance{};     ///< Position-velocity covariance in m^2/s.
+  float velocity_var{};   ///< Velocity variance in m^2/s^2.
+  float hdop{1.0F};       ///< Last known horizontal dilution of precision.
+};
+
+static_assert(sizeof(KalmanState) == 64, "KalmanState must fit a cache line");
+
+/**
+ * @brief Advances a receiver's filter state with a new measurement.
+ *
+ * The measurement noise is (uere * hdop)^2; when the measurement has no HDOP
+ * the last known value of the receiver is used. The filter restarts on the
+ * first measurement, when time goes backwards and after gaps longer than
+ * max_gap.
+ *
+ * @param state The receiver's filter state.
+ * @param measurement The measurement to apply.
+ * @param params The filter tuning.
+ * @return  KalmanEstimate  The filtered position and velocity.
+ */
+inline KalmanEstimate kalman_update(KalmanState &state,
+                                    const KalmanMeasurement &measurement,
+                                    const KalmanParameters &params) {
+  constexpr double recenter_distance = 1000.0;
+
+  double hdop = measurement.hdop > 0.0 ? measurement.hdop : state.hdop;
+  double noise = params.uere * hdop;
+  double r = noise * noise;
+  double dt = measurement.time - state.time;
+
+  state.hdop = static_cast<float>(hdop);
+
+  if (!(dt >= 0.0 && dt <= params.max_gap)) {
+    state.origin_latitude = measurement.latitude;
+    state.origin_longitude = measurement.longitude;
+    state.time = measurement.time;
+    state.origin_scale = static_cast<float>(
+        METERS_PER_DEGREE * std::cos(measurement.latitude * detail::DEGTORAD));
+    state.east = state.north = 0.0F;
+    state.east_velocity = state.north_velocity = 0.0F;
+    state.position_var = static_cast<float>(r);
+    state.covariance = 0.0F;
+    state.velocity_var =
+        static_cast<float>(params.initial_velocity * params.initial_velocity);
+    return {measurement.latitude, measurement.longitude, 0.0, 0.0};
+  }
+
+  double scale = state.origin_scale;
+  double z_east =
+      std::remainder(measurement.longitude - state.origin_longitude, 360.0) *
+      scale;
+  double z_north =
+      (measurement.latitude - state.origin_latitude) * METERS_PER_DEGREE;
+
+  // Predict with a white-noise acceleration model.
+  double q = params.acceleration_noise * params.acceleration_noise;
+  double dt2 = dt * dt;
+  double east = state.east + state.east_velocity * dt;
+  double north = state.north + state.north_velocity * dt;
+  double p00 = state.position_var + 2.0 * dt * state.covariance +
+               dt2 * state.velocity_var + q * dt2 * dt2 / 4.0;
+  double p01 = state.covariance + dt * state.velocity_var + q * dt2 * dt / 2.0;
+  double p11 = state.velocity_var + q * dt2;
+
+  // Update both axes with the same gain.
+  double k0 = p00 / (p00 + r);
+  double k1 = p01 / (p00 + r);
+  double east_innovation = z_east - east;
+  double north_innovation = z_north - north;
+  double east_velocity = state.east_velocity + k1 * east_innovation;
+  double north_velocity = state.north_velocity + k1 * north_innovation;
+  east += k0 * east_innovation;
+  north += k0 * north_innovation;
+
+  state.position_var = static_cast<float>((1.0 - k0) * p00);
+  state.covariance = static_cast<float>((1.0 - k0) * p01);
+  state.velocity_var = static_cast<float>(p11 - k1 * p01);
+  state.east_velocity = static_cast<float>(east_velocity);
+  state.north_velocity = static_cast<float>(north_velocity);
+  state.time = measurement.time;
+
+  double latitude = state.origin_latitude + north / METERS_PER_DEGREE;
+  double longitude =
+      std::remainder(state.origin_longitude + east / scale, 360.0);
+
+  // Keep the offsets small so float precision stays at the millimeter level.
+  if (std::fabs(east) > recenter_distance ||
+      std::fabs(north) > recenter_distance) {
+    state.origin_latitude = latitude;
+    state.origin_longitude = longitude;
+    state.origin_scale = static_cast<float>(
+        METERS_PER_DEGREE * std::cos(latitude * detail::DEGTORAD));
+    east = north = 0.0;
+  }
+
+  state.east = static_cast<float>(east);
+  state.north = static_cast<float>(north);
+
+  return {latitude, longitude, east_velocity, north_velocity};
+}
+
+/**
+ * @brief Smooths the fixes of a single receiver with a constant-velocity
+ * Kalman filter.
+ */
+class KalmanFilter {
+public:
+  /**
+   * @brief Constructs a Kalman filter.
+   * @param params The filter tuning.
+   */
+  explicit KalmanFilter(KalmanParameters params = {}) : params_{params} {}
+
+  /**
+   * @brief Applies a fix to the filter.
+   * @param fix The fix to apply. Its HDOP is used as measurement noise.
+   * @return  Fix     The fix with filtered position and speed.
+   */
+  Fix update(const Fix &fix) {
+    std::chrono::duration<double> time = fix.utc_time.time_since_epoch();
+    KalmanEstimate estimate = kalman_update(
+        state_, {0, time.count(), fix.latitude, fix.longitude, fix.hdop},
+        params_);
+
+    Fix filtered = fix;
+    filtered.latitude = estimate.latitude;
+    filtered.longitude = estimate.longitude;
+    filtered.speed =
+        std::hypot(estimate.east_velocity, estimate.north_velocity);
+
+    return filtered;
+  }
+
+  /**
+   * @brief Sets the HDOP used for fixes that do not report one, such as RMC
+   * fixes following a GSA sentence.
+   * @param hdop The horizontal dilution of precision.
+   * @return  void    This function does not return a value.
+   */
+  void set_hdop(double hdop) { state_.hdop = static_cast<float>(hdop); }
+
+private:
+  KalmanParameters params_; ///< Filter tuning.
+  KalmanState state_{};     ///< Filter state.
+};
+
+/**
+ * @brief Runs independent Kalman filters for many receivers.
+ *
+ * Each receiver's state is one cache line, so a batch of measurements for
+ * arbitrary receivers touches exactly one line per measurement.
+ */
+class KalmanBank {
+public:
+  /**
+   * @brief Constructs a bank of filters.
+   * @param receivers The number of receivers.
+   * @param params The filter tuning shared by all receivers.
+   */
+  explicit KalmanBank(std::size_t receivers, KalmanParameters params = {})
+      : params_{params}, states_(receivers) {}
+
+  /**
+   * @brief Applies a batch of measurements.
+   * @param measurements The measurements, in time order per receiver.
+   * @param estimates Output for the estimate of each measurement.
+   * @return  void    This function does not return a value.
+   */
+  void update(std::span<const KalmanMeasurement> measurements,
+              std::span<KalmanEstimate> estimates) {
+    std::size_t count = std::min(measurements.size(), estimates.size());
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const KalmanMeasurement &measurement = measurements[i];
+      estimates[i] =
+          kalman_update(states_[measurement.receiver], measurement, params_);
+    }
+  }
+
+  /**
+   * @brief Returns the filter state of a receiver.
+   * @param receiver The index of the receiver.
+   * @return  KalmanState&    The receiver's state.
+   */
+  KalmanState &state(std::size_t receiver) { return states_[receiver]; }
+
+  /**
+   * @brief Returns the number of receivers in the bank.
+   * @return  std::size_t     The number of receivers.
+   */
+  std::size_t size() const { return states_.size(); }
+
+private:
+  KalmanParameters params_;         ///< Filter tuning.
+  std::vector<KalmanState> states_; ///< One state per receiver.
+};
+} // namespace gps_lib
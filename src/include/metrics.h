@@ -0,0 +1,436 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "intern.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+static_assert(SENTENCE_NAMES.size() == std::variant_size_v<Sample>,
+              "Every Sample alternative needs a metrics name");
+
+/**
+ * @brief Names of the ParseError values, in declaration order.
+ */
+constexpr std::array<std::string_view, 5> PARSE_ERROR_NAMES{
+    "InvalidDirection", "InvalidFormat", "MissingFields", "UnknownError",
+    "UnsupportedType"};
+
+/**
+ * @brief A log-linear latency histogram in the style of HdrHistogram.
+ *
+ * Values below 16 ns have one bucket each; above, every power of two is
+ * split into 16 buckets, so any recorded value is known within 6.25% while
+ * the whole range up to about 18 minutes fits in under 600 counters.
+ */
+struct LatencyHistogram {
+  /// Buckets per power of two, as a power of two.
+  static constexpr std::size_t SUB_BITS{4};
+  /// Buckets per power of two.
+  static constexpr std::size_t SUB_BUCKETS{std::size_t{1} << SUB_BITS};
+  /// Values of this many bits or more land in the last bucket.
+  static constexpr std::size_t MAX_BITS{40};
+  /// Total number of buckets.
+  static constexpr std::size_t BUCKETS{SUB_BUCKETS * (MAX_BITS - SUB_BITS + 1)};
+
+  std::array<std::uint64_t, BUCKETS> counts{}; ///< Values per bucket.
+  std::uint64_t count{0};                      ///< Values recorded.
+  std::uint64_t sum{0};                        ///< Sum of values in ns.
+
+  /**
+   * @brief Returns the bucket of a value.
+   * @param nanoseconds The value.
+   * @return  std::size_t     The bucket index.
+   */
+  static constexpr std::size_t bucket(std::uint64_t nanoseconds) {
+    nanoseconds = std::min<std::uint64_t>(nanoseconds,
+                                          (std::uint64_t{1} << MAX_BITS) - 1);
+    if (nanoseconds < SUB_BUCKETS) {
+      return static_cast<std::size_t>(nanoseconds);
+    }
+
+    auto exponent = static_cast<std::size_t>(std::bit_width(nanoseconds)) - 1;
+    std::size_t shift = exponent - SUB_BITS;
+
+    return SUB_BUCKETS * (shift + 1) +
+           static_cast<std::size_t>((nanoseconds >> shift) - SUB_BUCKETS);
+  }
+
+  /**
+   * @brief Returns the largest value that falls in a bucket.
+   * @param index The bucket index.
+   * @return  std::uint64_t   The upper bound in ns.
+   */
+  static constexpr std::uint64_t upper_bound(std::size_t index) {
+    if (index < SUB_BUCKETS) {
+      return index;
+    }
+
+    std::size_t shift = index / SUB_BUCKETS - 1;
+    std::uint64_t mantissa = SUB_BUCKETS + index % SUB_BUCKETS;
+
+    return ((mantissa + 1) << shift) - 1;
+  }
+
+  /**
+   * @brief Returns a quantile of the recorded values.
+   * @param quantile The quantile, between 0 and 1.
+   * @return  std::chrono::nanoseconds    The upper bound of the bucket
+   * holding the quantile, or zero if nothing was recorded.
+   */
+  std::chrono::nanoseconds percentile(double quantile) const {
+    if (count == 0) {
+      return std::chrono::nanoseconds{0};
+    }
+
+    auto rank =
+        static_cast<std::uint64_t>(quantile * static_cast<double>(count));
+    std::uint64_t seen = 0;
+
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+      seen += counts[i];
+      if (seen > rank || seen == count) {
+        return std::chrono::nanoseconds{upper_bound(i)};
+      }
+    }
+
+    return std::chrono::nanoseconds{upper_bound(BUCKETS - 1)};
+  }
+};
+
+/**
+ * @brief This struct holds the parser metrics summed over all threads.
+ */
+struct MetricsSnapshot {
+  /// Parsed sentences by type, in the order of SENTENCE_NAMES.
+  std::array<std::uint64_t, SENTENCE_NAMES.size()> sentences{};
+  /// Parsed sentences by talker, in the order of TALKER_NAMES.
+  std::array<std::uint64_t, TALKER_NAMES.size()> talkers{};
+  /// Rejected sentences by error, in the order of PARSE_ERROR_NAMES.
+  std::array<std::uint64_t, PARSE_ERROR_NAMES.size()> errors{};
+  std::uint64_t checksum_failures{0}; ///< Sentences with a wrong checksum.
+  std::uint64_t bytes{0};             ///< Bytes passed to parse().
+  LatencyHistogram latency;           ///< Time spent in parse().
+};
+
+namespace detail {
+/**
+ * @brief The counters of one thread. Only the owning thread writes them, so
+ * recording is a relaxed load and store with no read-modify-write, while
+ * snapshots may read them from any thread.
+ */
+struct alignas(64) ThreadMetrics {
+  /// Parsed sentences by type.
+  std::array<std::atomic<std::uint64_t>, SENTENCE_NAMES.size()> sentences{};
+  /// Parsed sentences by talker.
+  std::array<std::atomic<std::uint64_t>, TALKER_NAMES.size()> talkers{};
+  /// Rejected sentences by error.
+  std::array<std::atomic<std::uint64_t>, PARSE_ERROR_NAMES.size()> errors{};
+  std::atomic<std::uint64_t> checksum_failures{0}; ///< Checksum mismatches.
+  std::atomic<std::uint64_t> bytes{0};             ///< Bytes parsed.
+  /// Parse latency histogram buckets.
+  std::array<std::atomic<std::uint64_t>, LatencyHistogram::BUCKETS> latency{};
+  std::atomic<std::uint64_t> latency_sum{0}; ///< Sum of latencies in ns.
+};
+
+/**
+ * @brief Adds to a counter that only the calling thread writes.
+ * @param counter The counter.
+ * @param amount The amount to add.
+ * @return  void    This function does not return a value.
+ */
+inline void bump(std::atomic<std::uint64_t> &counter,
+                 std::uint64_t amount = 1) {
+  counter.store(counter.load(std::memory_order_relaxed) + amount,
+                std::memory_order_relaxed);
+}
+
+/**
+ * @brief Owns the counters of every thread that has recorded metrics.
+ *
+ * Counters are handed out once per thread and taken back when the thread
+ * exits, keeping their values, so totals never go backwards and the number
+ * of blocks is bounded by the peak number of threads. The mutex is only
+ * taken on thread start, thread exit and snapshot.
+ */
+class MetricsRegistry {
+public:
+  /**
+   * @brief Returns the process-wide registry.
+   * @return  MetricsRegistry&    The registry.
+   */
+  static MetricsRegistry &instance() {
+    static MetricsRegistry registry;
+    return registry;
+  }
+
+  /**
+   * @brief Hands out a block of counters to the calling thread.
+   * @return  ThreadMetrics&  The counters.
+   */
+  ThreadMetrics &acquire() {
+    std::lock_guard lock{mutex_};
+
+    if (!free_.empty()) {
+      ThreadMetrics *metrics = free_.back();
+      free_.pop_back();
+      return *metrics;
+    }
+
+    return *blocks_.emplace_back(std::make_unique<ThreadMetrics>());
+  }
+
+  /**
+   * @brief Takes back the counters of an exiting thread.
+   * @param metrics The counters.
+   * @return  void    This function does not return a value.
+   */
+  void release(ThreadMetrics &metrics) {
+    std::lock_guard lock{mutex_};
+    free_.push_back(&metrics);
+  }
+
+  /**
+   * @brief Sums the counters of all threads.
+   * @return  MetricsSnapshot     The totals.
+   */
+  MetricsSnapshot snapshot() {
+    std::lock_guard lock{mutex_};
+    MetricsSnapshot total;
+
+    auto add = [](auto &to, const auto &from) {
+      for (std::size_t i = 0; i < to.size(); ++i) {
+        to[i] += from[i].load(std::memory_order_relaxed);
+      }
+    };
+
+    for (const std::unique_ptr<ThreadMetrics> &metrics : blocks_) {
+      add(total.sentences, metrics->sentences);
+      add(total.talkers, metrics->talkers);
+      add(total.errors, metrics->errors);
+      add(total.latency.counts, metrics->latency);
+      total.checksum_failures +=
+          metrics->checksum_failures.load(std::memory_order_relaxed);
+      total.bytes += metrics->bytes.load(std::memory_order_relaxed);
+      total.latency.sum += metrics->latency_sum.load(std::memory_order_relaxed);
+    }
+
+    for (std::uint64_t count : total.latency.counts) {
+      total.latency.count += count;
+    }
+
+    return total;
+  }
+
+private:
+  std::mutex mutex_;                                   ///< Guards the lists.
+  std::vector<std::unique_ptr<ThreadMetrics>> blocks_; ///< All blocks.
+  std::vector<ThreadMetrics *> free_;                  ///< Unowned blocks.
+};
+
+/**
+ * @brief Returns the counters of the calling thread, registering them on
+ * first use.
+ * @return  ThreadMetrics&  The counters.
+ */
+inline ThreadMetrics &thread_metrics() {
+  struct Lease {
+    ThreadMetrics &metrics{MetricsRegistry::instance().acquire()};
+    ~Lease() { MetricsRegistry::instance().release(metrics); }
+  };
+
+  thread_local Lease lease;
+  return lease.metrics;
+}
+
+/**
+ * @brief Records a checksum failure.
+ * @return  void    This function does not return a value.
+ */
+inline void record_checksum_failure() {
+  bump(thread_metrics().checksum_failures);
+}
+
+/**
+ * @brief Records the outcome of one parse() or parse_into() call.
+ * @param sentence The raw sentence.
+ * @param result The index in Sample of the parsed sentence type, or the
+ * error.
+ * @param elapsed The time spent parsing.
+ * @return  void    This function does not return a value.
+ */
+inline void record_parse(std::string_view sentence,
+                         const std::expected<std::size_t, ParseError> &result,
+                         std::chrono::nanoseconds elapsed) {
+  ThreadMetrics &metrics = thread_metrics();
+
+  bump(metrics.bytes, sentence.size());
+
+  if (!result) {
+    bump(metrics.errors[static_cast<std::size_t>(result.error())]);
+  } else {
+    bump(metrics.sentences[*result]);
+    bump(metrics.talkers[static_cast<std::size_t>(talker_of(sentence))]);
+  }
+
+  auto nanoseconds =
+      static_cast<std::uint64_t>(std::max<std::int64_t>(elapsed.count(), 0));
+  bump(metrics.latency[LatencyHistogram::bucket(nanoseconds)]);
+  bump(metrics.latency_sum, nanoseconds);
+}
+
+/**
+ * @brief Appends a number to a Prometheus exposition.
+ * @param out The exposition.
+ * @param value The number.
+ * @return  void    This function does not return a value.
+ */
+template <typename T> void append_number(std::string &out, T value) {
+  std::array<char, 32> buffer;
+  auto [end, error] = std::to_chars(buffer.data(),
+                                    buffer.data() + buffer.size(), value);
+  out.append(buffer.data(), end);
+}
+} // namespace detail
+
+/**
+ * @brief Returns the parser metrics summed over all threads.
+ *
+ * Metrics are recorded only when GPS_LIB_METRICS is defined, e.g. through
+ * the GPS_LIB_METRICS CMake option. Otherwise the hooks in parse() and
+ * is_valid_sample() are compiled out and the snapshot stays empty.
+ *
+ * @return  MetricsSnapshot     The totals since the process started.
+ */
+inline MetricsSnapshot metrics_snapshot() {
+  return detail::MetricsRegistry::instance().snapshot();
+}
+
+/**
+ * @brief Formats a snapshot in the Prometheus text exposition format.
+ * @param snapshot The metrics to format.
+ * @return  std::string     The exposition, with parse latency as a summary
+ * in seconds with the 0.5, 0.9, 0.99 and 0.999 quantiles.
+ */
+inline std::string to_prometheus(const MetricsSnapshot &snapshot) {
+  std::string out;
+
+  auto family = [&](std::string_view name, std::string_view type,
+                    std::string_view help) {
+    out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+  };
+
+  auto labelled = [&](std::string_view name, std::string_view label,
+                      const auto &names, const auto &values) {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      out.append(name).append("{").append(label).append("=\"");
+      out.append(names[i]).append("\"} ");
+      detail::append_number(out, values[i]);
+      out.append("\n");
+    }
+  };
+
+  auto single = [&](std::string_view name, auto value) {
+    out.append(name).append(" ");
+    detail::append_number(out, value);
+    out.append("\n");
+  };
+
+  family("gps_lib_sentences_total", "counter",
+         "Sentences parsed, by sentence type.");
+  labelled("gps_lib_sentences_total", "type", SENTENCE_NAMES,
+           snapshot.sentences);
+
+  family("gps_lib_talker_sentences_total", "counter",
+         "Sentences parsed, by talker.");
+  labelled("gps_lib_talker_sentences_total", "talker", TALKER_NAMES,
+           snapshot.talkers);
+
+  family("gps_lib_parse_errors_total", "counter",
+         "Sentences rejected, by error.");
+  labelled("gps_lib_parse_errors_total", "error", PARSE_ERROR_NAMES,
+           snapshot.errors);
+
+  family("gps_lib_checksum_failures_total", "counter",
+         "Sentences whose checksum did not match.");
+  single("gps_lib_checksum_failures_total", snapshot.checksum_failures);
+
+  family("gps_lib_bytes_total", "counter", "Bytes passed to the parser.");
+  single("gps_lib_bytes_total", snapshot.bytes);
+
+  family("gps_lib_parse_latency_seconds", "summary",
+         "Time spent parsing one sentence.");
+  constexpr std::array<std::pair<std::string_view, double>, 4> quantiles{
+      {{"0.5", 0.5}, {"0.9", 0.9}, {"0.99", 0.99}, {"0.999", 0.999}}};
+
+  for (auto [label, quantile] : quantiles) {
+    std::chrono::duration<double> latency =
+        snapshot.latency.percentile(quantile);
+    out.append("gps_lib_parse_latency_seconds{quantile=\"")
+        .append(label)
+        .append("\"} ");
+    detail::append_number(out, latency.count());
+    out.append("\n");
+  }
+  single("gps_lib_parse_latency_seconds_sum",
+         static_cast<double>(snapshot.latency.sum) * 1e-9);
+  single("gps_lib_parse_latency_seconds_count", snapshot.latency.count);
+
+  return out;
+}
+
+/**
+ * @brief Writes the current metrics to a file in the Prometheus text format,
+ * e.g. for the node_exporter textfile collector.
+ *
+ * The snapshot is written to a temporary file that then replaces the target,
+ * so a scraper never reads a partial file.
+ *
+ * @param path The output file path.
+ * @return  bool    True if the file was written successfully, false
+ * otherwise.
+ */
+inline bool write_prometheus(const std::filesystem::path &path) {
+  std::filesystem::path temporary = path;
+  temporary += ".tmp";
+
+  {
+    std::ofstream out{temporary, std::ios::trunc};
+    if (!out) {
+      return false;
+    }
+    out << to_prometheus(metrics_snapshot());
+    if (!out) {
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary, path, error);
+
+  return !error;
+}
+} // namespace gps_lib
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+
+#include "detail/geodesy.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief This struct holds the thresholds of the outlier filter.
+ */
+struct OutlierParameters {
+  double max_speed{70.0};          ///< Physical speed limit in m/s.
+  double speed_tolerance{5.0};     ///< Allowed excess over reported speed.
+  double position_tolerance{10.0}; ///< Position noise in meters always allowed.
+  std::size_t max_rejections{5};   ///< Rejections in a row before reseeding.
+};
+
+/**
+ * @brief Rejects fixes that imply an impossible jump from the last accepted
+ * fix.
+ *
+ * The implied speed between a fix and the last accepted one is compared with
+ * the reported speed of both (plus a tolerance) and with a physical limit.
+ * Each check is O(1) and keeps only the last accepted fix. After
+ * max_rejections rejections in a row the filter assumes the receiver really
+ * moved and accepts the next fix as a new reference.
+ */
+class OutlierFilter {
+public:
+  /**
+   * @brief Constructs an outlier filter.
+   * @param params The filter thresholds.
+   */
+  explicit OutlierFilter(OutlierParameters params = {}) : params_{params} {}
+
+  /**
+   * @brief Checks a fix and makes it the new reference if it is plausible.
+   * @param fix The fix to check.
+   * @return  bool    True if the fix is plausible, false if it is an outlier.
+   */
+  bool accept(const Fix &fix) {
+    if (has_last_ && rejections_ < params_.max_rejections) {
+      std::chrono::duration<double> elapsed = fix.utc_time - last_.utc_time;
+      double dt = elapsed.count();
+
+      detail::Offset offset = detail::local_offset(
+          last_.latitude, last_.longitude, fix.latitude, fix.longitude);
+      double distance = std::hypot(offset.east, offset.north);
+      implied_speed_ = dt > 0.0 ? distance / dt : 0.0;
+
+      if (std::max(distance - params_.position_tolerance, 0.0) >
+          speed_limit(fix) * std::max(dt, 0.0)) {
+        ++rejections_;
+        return false;
+      }
+    }
+
+    last_ = fix;
+    has_last_ = true;
+    rejections_ = 0;
+
+    return true;
+  }
+
+  /**
+   * @brief Consumes a fix, forwarding it only if it is plausible.
+   * @param fix The fix to consume.
+   * @param emit Callback invoked with every accepted fix.
+   * @return  void    This function does not return a value.
+   */
+  template <std::invocable<const Fix &> Emit>
+  void push(const Fix &fix, Emit &&emit) {
+    if (accept(fix)) {
+      emit(fix);
+    }
+  }
+
+  /**
+   * @brief Returns the implied speed of the last checked fix.
+   * @return  double  The speed in m/s implied by the jump from the previous
+   * accepted fix.
+   * @note Fixes accepted without a check, the first one and the one that
+   * reseeds the filter after max_rejections rejections, leave it unchanged,
+   * so after a reseed it still holds the speed of the last rejected fix.
+   */
+  double implied_speed() const { return implied_speed_; }
+
+private:
+  /**
+   * @brief Computes the highest plausible speed between the last accepted fix
+   * and a new one.
+   * @param fix The new fix.
+   * @return  double  The speed limit in m/s.
+   */
+  double speed_limit(const Fix &fix) const {
+    double reported = std::fmax(last_.speed, fix.speed);
+
+    if (std::isnan(reported)) {
+      return params_.max_speed;
+    }
+
+    return std::min(reported + params_.speed_tolerance, params_.max_speed);
+  }
+
+  OutlierParameters params_;  ///< Filter thresholds.
+  Fix last_{};                ///< Last accepted fix.
+  bool has_last_{false};      ///< Whether a fix has been accepted yet.
+  double implied_speed_{0.0}; ///< Implied speed of the last checked fix.
+  std::size_t rejections_{0}; ///< Rejections since the last accepted fix.
+};
+} // namespace gps_lib
@@ -1,12 +1,24 @@
 #pragma once
 
+#include <chrono>
 #include <concepts>
 #include <cstddef>
 #include <expected>
 #include <string>
 #include <string_view>
-
+#include <type_traits>
+#include <variant>
+
+#include "detail/parse_char.h"
+#include "detail/parse_latitude.h"
+#include "detail/parse_longitude.h"
+#include "detail/parse_satellite_id.h"
+#include "detail/parse_utc_date.h"
+#include "detail/parse_utc_time.h"
+#include "detail/stamp_time.h"
 #include "detail/tokenize.h"
+#include "detail/trace.h"
+#include "metrics.h"
 #include "tools.h"
 #include "types.h"
 
@@ -22,238 +34,598 @@ namespace gps_lib {
 template <typename T>
 concept StringLike = std::convertible_to<T, std::string_view>;
 
+namespace detail {
 /**
- * @brief Parses a given NMEA sentence and returns a Sample variant.
- * @param sample  The NMEA sentence to parse.
- * @return std::expected<Sample, ParseError>  An expected containing the parsed
- * Sample or an error.
- * @throws std::invalid_argument If numeric fields are malformed.
+ * @brief Returns the position in Sample of a sentence type.
+ * @tparam T The sentence type.
+ * @return  std::size_t     The index of T in the Sample variant.
  */
-inline std::expected<Sample, ParseError> parse(StringLike auto const &sample) {
-  if (!gps_lib::is_valid_sample(sample)) {
+template <typename T, std::size_t I = 0> consteval std::size_t sample_index() {
+  if constexpr (std::is_same_v<std::variant_alternative_t<I, Sample>, T>) {
+    return I;
+  } else {
+    return sample_index<T, I + 1>();
+  }
+}
+
+/**
+ * @brief Maps the address field of a sentence to the Sample alternative it
+ * parses into.
+ * @param type The address field, e.g. "$GPGGA".
+ * @return  std::size_t     The index of the sentence type in Sample, or
+ * std::variant_npos if the type is not supported.
+ */
+inline std::size_t sentence_index(std::string_view type) {
+  if (type.find("GGA") != std::string::npos) {
+    return sample_index<GGA>();
+  } else if (type.find("GLL") != std::string::npos) {
+    return sample_index<GLL>();
+  } else if (type.find("GSA") != std::string::npos) {
+    return sample_index<GSA>();
+  } else if (type.find("GSV") != std::string::npos) {
+    return sample_index<GSV>();
+  } else if (type.find("RMC") != std::string::npos) {
+    return sample_index<RMC>();
+  } else if (type.find("VTG") != std::string::npos) {
+    return sample_index<VTG>();
+  } else if (type.find("ZDA") != std::string::npos) {
+    return sample_index<ZDA>();
+  } else if (type.find("GST") != std::string::npos) {
+    return sample_index<GST>();
+  } else if (type.find("GBS") != std::string::npos) {
+    return sample_index<GBS>();
+  } else if (type.find("GNS") != std::string::npos) {
+    return sample_index<GNS>();
+  } else if (type.find("RMB") != std::string::npos) {
+    return sample_index<RMB>();
+  } else if (type.find("HDT") != std::string::npos) {
+    return sample_index<HDT>();
+  }
+
+  return std::variant_npos;
+}
+
+/**
+ * @brief Returns the sentence of type T held by a sample, replacing the
+ * current alternative if it is of another type.
+ * @param sample The sample to reuse.
+ * @param context The parse state, whose resource a new alternative uses.
+ * @return  T&      The sentence to overwrite.
+ */
+template <typename T> T &reuse(Sample &sample, ParseContext &context) {
+  if (T *data = std::get_if<T>(&sample)) {
+    return *data;
+  }
+  return sample.emplace<T>(context.resource);
+}
+
+/**
+ * @brief Parses a given NMEA sentence into a Sample variant.
+ * @param sample  The sample to overwrite.
+ * @param line    The NMEA sentence to parse.
+ * @param context The state of the stream the sentence belongs to.
+ * @return std::expected<void, ParseError>  Nothing, or the error that stopped
+ * parsing.
+ */
+inline std::expected<void, ParseError>
+parse_sentence(Sample &sample, std::string_view line, ParseContext &context) {
+  GPS_LIB_TRACE_SCOPE("parse");
+
+  if (!gps_lib::is_valid_sample(line)) {
     return std::unexpected(ParseError::InvalidFormat);
   }
 
-  auto tokens = detail::tokenize(sample);
+  auto tokens = detail::tokenize(line);
 
   if (tokens.empty()) {
     return std::unexpected(ParseError::UnknownError);
   }
 
   // This won't throw an error because tokens is not empty.
-  auto type = tokens.at(0);
+  std::size_t index = sentence_index(tokens.at(0));
+
+  if (index == sample_index<GGA>()) {
+    GPS_LIB_TRACE_SCOPE("parse_gga");
 
-  if (type.find("GGA") != std::string::npos) {
     if (tokens.size() < static_cast<size_t>(TokensPerSentence::GGA)) {
       return std::unexpected(ParseError::MissingFields);
     }
 
-    GGA data;
+    GGA &data = detail::reuse<GGA>(sample, context);
 
-    data.type = tokens.at(0);
-    data.utc_time = tokens.at(1);
+    data.type = address_of(tokens.at(0), SentenceType::GGA);
 
-    try {
-      data.latitude.value = std::stod(std::string{tokens.at(2)}) / 100.0;
-    } catch (...) {
-      return std::unexpected{ParseError::MissingFields};
-    }
-    if (!tokens.at(3).empty() &&
-        (tokens.at(3).front() == 'N' || tokens.at(3).front() == 'S')) {
-      data.latitude.direction = tokens.at(3).front();
-    } else {
-      return std::unexpected{ParseError::InvalidDirection};
+    auto time_of_day = detail::parse_utc_time(tokens.at(1));
+    if (!time_of_day) {
+      return std::unexpected{time_of_day.error()};
     }
+    data.utc_time = detail::stamp_time(context, *time_of_day);
 
-    if (!tokens.at(5).empty() &&
-        (tokens.at(5).front() == 'E' || tokens.at(5).front() == 'W')) {
-      data.longitude.direction = tokens.at(5).front();
-    } else {
-      return std::unexpected{ParseError::InvalidDirection};
+    auto latitude = detail::parse_latitude(tokens.at(2), tokens.at(3));
+    if (!latitude) {
+      return std::unexpected{latitude.error()};
     }
-    try {
-      double sign = data.longitude.direction == 'W' ? -1.0 : 1.0;
-      data.longitude.value =
-          std::stod(std::string{tokens.at(4)}) / 100.0 * sign;
-    } catch (...) {
-      return std::unexpected{ParseError::MissingFields};
+    data.latitude = *latitude;
+
+    auto longitude = detail::parse_longitude(tokens.at(4), tokens.at(5));
+    if (!longitude) {
+      return std::unexpected{longitude.error()};
     }
+    data.longitude = *longitude;
 
-    data.quality = tokens.at(6);
+    auto quality = detail::parse_char(tokens.at(6));
+    if (!quality) {
+      return std::unexpected{quality.error()};
+    }
+    data.quality = *quality;
     data.satellites_used = tokens.at(7);
     data.hdop = tokens.at(8);
     data.altitude = tokens.at(9);
     data.geoidal_separation = tokens.at(11);
     data.dgps = tokens.at(14);
 
-    return data;
-  } else if (type.find("GLL") != std::string::npos) {
+    return {};
+  } else if (index == sample_index<GLL>()) {
+    GPS_LIB_TRACE_SCOPE("parse_gll");
+
     if (tokens.size() < static_cast<size_t>(TokensPerSentence::GLL)) {
       return std::unexpected(ParseError::MissingFields);
     }
 
-    GLL data;
+    GLL &data = detail::reuse<GLL>(sample, context);
 
-    data.type = tokens.at(0);
+    data.type = address_of(tokens.at(0), SentenceType::GLL);
 
-    try {
-      data.latitude.value = std::stod(std::string{tokens.at(1)}) / 100.0;
-    } catch (...) {
-      return std::unexpected{ParseError::MissingFields};
+    auto latitude = detail::parse_latitude(tokens.at(1), tokens.at(2));
+    if (!latitude) {
+      return std::unexpected{latitude.error()};
     }
-    if (!tokens.at(2).empty() &&
-        (tokens.at(2).front() == 'N' || tokens.at(2).front() == 'S')) {
-      data.latitude.direction = tokens.at(2).front();
-    } else {
-      return std::unexpected{ParseError::InvalidDirection};
+    data.latitude = *latitude;
+
+    auto longitude = detail::parse_longitude(tokens.at(3), tokens.at(4));
+    if (!longitude) {
+      return std::unexpected{longitude.error()};
     }
+    data.longitude = *longitude;
 
-    if (!tokens.at(4).empty() &&
-        (tokens.at(4).front() == 'E' || tokens.at(4).front() == 'W')) {
-      data.longitude.direction = tokens.at(4).front();
-    } else {
-      return std::unexpected{ParseError::InvalidDirection};
+    auto time_of_day = detail::parse_utc_time(tokens.at(5));
+    if (!time_of_day) {
+      return std::unexpected{time_of_day.error()};
     }
-    try {
-      double sign = data.longitude.direction == 'W' ? -1.0 : 1.0;
-      data.longitude.value =
-          std::stod(std::string{tokens.at(3)}) / 100.0 * sign;
-    } catch (...) {
-      return std::unexpected{ParseError::MissingFields};
+    data.utc_time = detail::stamp_time(context, *time_of_day);
+
+    auto status = detail::parse_char(tokens.at(6));
+    if (!status) {
+      return std::unexpected{status.error()};
     }
+    data.status = *status;
 
-    data.utc_time = tokens.at(6);
-    data.status = tokens.at(7);
+    return {};
+  } else if (index == sample_index<GSA>()) {
+    GPS_LIB_TRACE_SCOPE("parse_gsa");
 
-    return data;
-  } else if (type.find("GSA") != std::string::npos) {
     if (tokens.size() < static_cast<size_t>(TokensPerSentence::GSA)) {
       return std::unexpected(ParseError::MissingFields);
     }
 
-    GSA data;
+    GSA &data = detail::reuse<GSA>(sample, context);
+
+    data.type = address_of(tokens.at(0), SentenceType::GSA);
+
+    auto mode = detail::parse_char(tokens.at(1));
+    if (!mode) {
+      return std::unexpected{mode.error()};
+    }
+    data.mode = *mode;
+
+    auto fix_type = detail::parse_char(tokens.at(2));
+    if (!fix_type) {
+      return std::unexpected{fix_type.error()};
+    }
+    data.fix_type = *fix_type;
 
-    data.type = tokens.at(0);
-    data.mode = tokens.at(1);
-    data.fix_type = tokens.at(2);
-    data.satellites.reserve(12);
     data.pdop = tokens.at(15);
     data.hdop = tokens.at(16);
     data.vdop = tokens.at(17);
 
-    for (size_t i = 0; i < 12 && (i + 3) < tokens.size(); ++i) {
-      data.satellites.push_back(std::string{tokens.at(i + 3)});
+    for (size_t i = 0; i < data.satellites.size(); ++i) {
+      auto id = detail::parse_satellite_id(tokens.at(i + 3));
+      if (!id) {
+        return std::unexpected{id.error()};
+      }
+      data.satellites[i] = *id;
     }
 
-    return data;
-  } else if (type.find("GSV") != std::string::npos) {
+    return {};
+  } else if (index == sample_index<GSV>()) {
+    GPS_LIB_TRACE_SCOPE("parse_gsv");
+
     if (tokens.size() < static_cast<size_t>(TokensPerSentence::GSV)) {
       return std::unexpected(ParseError::MissingFields);
     }
 
-    GSV data;
+    GSV &data = detail::reuse<GSV>(sample, context);
 
-    data.type = tokens.at(0);
+    data.type = address_of(tokens.at(0), SentenceType::GSV);
     data.number_of_messages = tokens.at(1);
     data.sequence_number = tokens.at(2);
     data.satellites_in_view = tokens.at(3);
 
-    try {
-      data.satellites.reserve(std::stoi(data.number_of_messages));
-    } catch (...) {
-      return std::unexpected{ParseError::MissingFields};
-    }
-
-    for (int i = 1; i <= std::stoi(data.number_of_messages) &&
-                    static_cast<size_t>(i * 4 + 3) < tokens.size();
-         ++i) {
-      Satellite satellite;
+    // Up to four satellites follow the header, four fields each.
+    data.satellites.resize((tokens.size() - 4) / 4);
 
-      satellite.id = tokens[i * 4 + 4];
-      satellite.elevation = tokens[i * 4 + 5];
-      satellite.azimuth = tokens[i * 4 + 6];
-      satellite.snr = tokens[i * 4 + 7];
+    for (size_t i = 4; i + 3 < tokens.size(); i += 4) {
+      Satellite &satellite = data.satellites[(i - 4) / 4];
 
-      data.satellites.push_back(satellite);
+      auto id = detail::parse_satellite_id(tokens[i]);
+      if (!id) {
+        return std::unexpected{id.error()};
+      }
+      satellite.id = *id;
+      satellite.elevation = tokens[i + 1];
+      satellite.azimuth = tokens[i + 2];
+      satellite.snr = tokens[i + 3];
     }
 
-    return data;
-  } else if (type.find("RMC") != std::string::npos) {
+    return {};
+  } else if (index == sample_index<RMC>()) {
+    GPS_LIB_TRACE_SCOPE("parse_rmc");
+
     if (tokens.size() < static_cast<size_t>(TokensPerSentence::RMC)) {
       return std::unexpected(ParseError::MissingFields);
     }
 
-    RMC data;
+    RMC &data = detail::reuse<RMC>(sample, context);
 
-    data.type = tokens.at(0);
-    data.utc_time = tokens.at(1);
-    data.status = tokens.at(2);
+    data.type = address_of(tokens.at(0), SentenceType::RMC);
 
-    try {
-      data.latitude.value = std::stod(std::string{tokens.at(3)}) / 100.0;
-    } catch (...) {
-      return std::unexpected{ParseError::MissingFields};
+    auto time_of_day = detail::parse_utc_time(tokens.at(1));
+    if (!time_of_day) {
+      return std::unexpected{time_of_day.error()};
     }
-    if (!tokens.at(4).empty() &&
-        (tokens.at(4).front() == 'N' || tokens.at(4).front() == 'S')) {
-      data.latitude.direction = tokens.at(4).front();
-    } else {
-      return std::unexpected{ParseError::InvalidDirection};
+    auto date = detail::parse_utc_date(tokens.at(9));
+    if (!date) {
+      return std::unexpected{date.error()};
     }
+    data.utc_time = detail::stamp_time(context, *date, *time_of_day);
 
-    if (!tokens.at(6).empty() &&
-        (tokens.at(6).front() == 'E' || tokens.at(6).front() == 'W')) {
-      data.longitude.direction = tokens.at(6).front();
-    } else {
-      return std::unexpected{ParseError::InvalidDirection};
+    auto status = detail::parse_char(tokens.at(2));
+    if (!status) {
+      return std::unexpected{status.error()};
     }
-    try {
-      double sign = data.longitude.direction == 'W' ? -1.0 : 1.0;
-      data.longitude.value =
-          std::stod(std::string{tokens.at(5)}) / 100.0 * sign;
-    } catch (...) {
-      return std::unexpected{ParseError::MissingFields};
+    data.status = *status;
+
+    auto latitude = detail::parse_latitude(tokens.at(3), tokens.at(4));
+    if (!latitude) {
+      return std::unexpected{latitude.error()};
+    }
+    data.latitude = *latitude;
+
+    auto longitude = detail::parse_longitude(tokens.at(5), tokens.at(6));
+    if (!longitude) {
+      return std::unexpected{longitude.error()};
     }
+    data.longitude = *longitude;
 
     data.speed = tokens.at(7);
     data.course = tokens.at(8);
-    data.utc_date = tokens.at(9);
-    data.mode = tokens.at(11);
 
-    return data;
-  } else if (type.find("VTG") != std::string::npos) {
+    auto mode = detail::parse_char(tokens.at(11));
+    if (!mode) {
+      return std::unexpected{mode.error()};
+    }
+    data.mode = *mode;
+
+    return {};
+  } else if (index == sample_index<VTG>()) {
+    GPS_LIB_TRACE_SCOPE("parse_vtg");
+
     if (tokens.size() < static_cast<size_t>(TokensPerSentence::VTG)) {
       return std::unexpected(ParseError::MissingFields);
     }
 
-    VTG data;
+    VTG &data = detail::reuse<VTG>(sample, context);
 
-    data.type = tokens.at(0);
+    data.type = address_of(tokens.at(0), SentenceType::VTG);
     data.course = tokens.at(1);
     data.course_magnetic = tokens.at(3);
     data.speed_kn = tokens.at(5);
     data.speed_kh = tokens.at(7);
-    data.mode = tokens.at(9);
 
-    return data;
-  } else if (type.find("ZDA") != std::string::npos) {
+    auto mode = detail::parse_char(tokens.at(9));
+    if (!mode) {
+      return std::unexpected{mode.error()};
+    }
+    data.mode = *mode;
+
+    return {};
+  } else if (index == sample_index<ZDA>()) {
+    GPS_LIB_TRACE_SCOPE("parse_zda");
+
     if (tokens.size() < static_cast<size_t>(TokensPerSentence::ZDA)) {
       return std::unexpected(ParseError::MissingFields);
     }
 
-    ZDA data;
+    ZDA &data = detail::reuse<ZDA>(sample, context);
+
+    data.type = address_of(tokens.at(0), SentenceType::ZDA);
+    auto time_of_day = detail::parse_utc_time(tokens.at(1));
+    if (!time_of_day) {
+      return std::unexpected{time_of_day.error()};
+    }
+    auto date =
+        detail::parse_utc_date(tokens.at(2), tokens.at(3), tokens.at(4));
+    if (!date) {
+      return std::unexpected{date.error()};
+    }
+    data.utc_time = detail::stamp_time(context, *date, *time_of_day);
 
-    data.type = tokens.at(0);
-    data.utc_time = tokens.at(1);
-    data.utc_day = tokens.at(2);
-    data.utc_month = tokens.at(3);
-    data.utc_year = tokens.at(4);
     data.local_zone_hours = tokens.at(5);
     data.local_zone_minutes = tokens.at(6);
 
-    return data;
+    return {};
+  } else if (index == sample_index<GST>()) {
+    GPS_LIB_TRACE_SCOPE("parse_gst");
+
+    if (tokens.size() < static_cast<size_t>(TokensPerSentence::GST)) {
+      return std::unexpected(ParseError::MissingFields);
+    }
+
+    GST &data = detail::reuse<GST>(sample, context);
+
+    data.type = address_of(tokens.at(0), SentenceType::GST);
+
+    auto time_of_day = detail::parse_utc_time(tokens.at(1));
+    if (!time_of_day) {
+      return std::unexpected{time_of_day.error()};
+    }
+    data.utc_time = detail::stamp_time(context, *time_of_day);
+
+    data.rms = tokens.at(2);
+    data.semi_major_error = tokens.at(3);
+    data.semi_minor_error = tokens.at(4);
+    data.orientation = tokens.at(5);
+    data.latitude_error = tokens.at(6);
+    data.longitude_error = tokens.at(7);
+    data.altitude_error = tokens.at(8);
+
+    return {};
+  } else if (index == sample_index<GBS>()) {
+    GPS_LIB_TRACE_SCOPE("parse_gbs");
+
+    if (tokens.size() < static_cast<size_t>(TokensPerSentence::GBS)) {
+      return std::unexpected(ParseError::MissingFields);
+    }
+
+    GBS &data = detail::reuse<GBS>(sample, context);
+
+    data.type = address_of(tokens.at(0), SentenceType::GBS);
+
+    auto time_of_day = detail::parse_utc_time(tokens.at(1));
+    if (!time_of_day) {
+      return std::unexpected{time_of_day.error()};
+    }
+    data.utc_time = detail::stamp_time(context, *time_of_day);
+
+    data.latitude_error = tokens.at(2);
+    data.longitude_error = tokens.at(3);
+    data.altitude_error = tokens.at(4);
+
+    auto failed_satellite = detail::parse_satellite_id(tokens.at(5));
+    if (!failed_satellite) {
+      return std::unexpected{failed_satellite.error()};
+    }
+    data.failed_satellite = *failed_satellite;
+
+    data.probability = tokens.at(6);
+    data.bias = tokens.at(7);
+    data.bias_deviation = tokens.at(8);
+
+    // NMEA 4.1 appends the system and signal IDs.
+    data.system_id = tokens.size() > 9 ? tokens[9] : std::string_view{};
+    data.signal_id = tokens.size() > 10 ? tokens[10] : std::string_view{};
+
+    return {};
+  } else if (index == sample_index<GNS>()) {
+    GPS_LIB_TRACE_SCOPE("parse_gns");
+
+    if (tokens.size() < static_cast<size_t>(TokensPerSentence::GNS)) {
+      return std::unexpected(ParseError::MissingFields);
+    }
+
+    GNS &data = detail::reuse<GNS>(sample, context);
+
+    data.type = address_of(tokens.at(0), SentenceType::GNS);
+
+    auto time_of_day = detail::parse_utc_time(tokens.at(1));
+    if (!time_of_day) {
+      return std::unexpected{time_of_day.error()};
+    }
+    data.utc_time = detail::stamp_time(context, *time_of_day);
+
+    auto latitude = detail::parse_latitude(tokens.at(2), tokens.at(3));
+    if (!latitude) {
+      return std::unexpected{latitude.error()};
+    }
+    data.latitude = *latitude;
+
+    auto longitude = detail::parse_longitude(tokens.at(4), tokens.at(5));
+    if (!longitude) {
+      return std::unexpected{longitude.error()};
+    }
+    data.longitude = *longitude;
+
+    data.mode = tokens.at(6);
+    data.satellites_used = tokens.at(7);
+    data.hdop = tokens.at(8);
+    data.altitude = tokens.at(9);
+    data.geoidal_separation = tokens.at(10);
+    data.dgps = tokens.at(12);
+
+    return {};
+  } else if (index == sample_index<RMB>()) {
+    GPS_LIB_TRACE_SCOPE("parse_rmb");
+
+    if (tokens.size() < static_cast<size_t>(TokensPerSentence::RMB)) {
+      return std::unexpected(ParseError::MissingFields);
+    }
+
+    RMB &data = detail::reuse<RMB>(sample, context);
+
+    data.type = address_of(tokens.at(0), SentenceType::RMB);
+
+    auto status = detail::parse_char(tokens.at(1));
+    if (!status) {
+      return std::unexpected{status.error()};
+    }
+    data.status = *status;
+
+    data.cross_track_error = tokens.at(2);
+
+    auto steer = detail::parse_char(tokens.at(3));
+    if (!steer) {
+      return std::unexpected{steer.error()};
+    }
+    data.steer = *steer;
+
+    data.origin = tokens.at(4);
+    data.destination = tokens.at(5);
+
+    auto latitude = detail::parse_latitude(tokens.at(6), tokens.at(7));
+    if (!latitude) {
+      return std::unexpected{latitude.error()};
+    }
+    data.destination_latitude = *latitude;
+
+    auto longitude = detail::parse_longitude(tokens.at(8), tokens.at(9));
+    if (!longitude) {
+      return std::unexpected{longitude.error()};
+    }
+    data.destination_longitude = *longitude;
+
+    data.range = tokens.at(10);
+    data.bearing = tokens.at(11);
+    data.closing_velocity = tokens.at(12);
+
+    auto arrival = detail::parse_char(tokens.at(13));
+    if (!arrival) {
+      return std::unexpected{arrival.error()};
+    }
+    data.arrival = *arrival;
+
+    // NMEA 2.3 appends the mode indicator.
+    auto mode = detail::parse_char(tokens.size() > 14 ? tokens[14] : "");
+    if (!mode) {
+      return std::unexpected{mode.error()};
+    }
+    data.mode = *mode;
+
+    return {};
+  } else if (index == sample_index<HDT>()) {
+    GPS_LIB_TRACE_SCOPE("parse_hdt");
+
+    if (tokens.size() < static_cast<size_t>(TokensPerSentence::HDT)) {
+      return std::unexpected(ParseError::MissingFields);
+    }
+
+    HDT &data = detail::reuse<HDT>(sample, context);
+
+    data.type = address_of(tokens.at(0), SentenceType::HDT);
+    data.heading = tokens.at(1);
+
+    return {};
   } else {
     return std::unexpected(ParseError::UnsupportedType);
   }
 }
+} // namespace detail
+
+/**
+ * @brief Parses a given NMEA sentence into an existing Sample, reusing its
+ * storage.
+ *
+ * When the sample already holds the parsed sentence type, its strings and
+ * vectors are overwritten in place, so parsing repeatedly into the same
+ * samples (see SamplePool) stops allocating once their capacity has grown.
+ * Otherwise the sentence replaces the current alternative and allocates from
+ * the context's resource.
+ *
+ * @param sample  The sample to overwrite. Its contents are unspecified if
+ * parsing fails.
+ * @param line    The NMEA sentence to parse.
+ * @param context The state of the stream the sentence belongs to, used to
+ * date sentences that only carry the time of day.
+ * @return std::expected<void, ParseError>  Nothing, or the error that stopped
+ * parsing.
+ */
+inline std::expected<void, ParseError>
+parse_into(Sample &sample, StringLike auto const &line, ParseContext &context) {
+#ifdef GPS_LIB_METRICS
+  auto start = std::chrono::steady_clock::now();
+  auto result = detail::parse_sentence(sample, line, context);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  if (result) {
+    detail::record_parse(line, sample.index(), elapsed);
+  } else {
+    detail::record_parse(line, std::unexpected{result.error()}, elapsed);
+  }
+
+  return result;
+#else
+  return detail::parse_sentence(sample, line, context);
+#endif
+}
+
+/**
+ * @brief Parses a single NMEA sentence into an existing Sample without stream
+ * state.
+ * @param sample  The sample to overwrite. Its contents are unspecified if
+ * parsing fails.
+ * @param line    The NMEA sentence to parse.
+ * @return std::expected<void, ParseError>  Nothing, or the error that stopped
+ * parsing.
+ * @note Sentences that only carry the time of day, such as GGA, are dated
+ * 1970-01-01.
+ */
+inline std::expected<void, ParseError>
+parse_into(Sample &sample, StringLike auto const &line) {
+  ParseContext context;
+  return parse_into(sample, line, context);
+}
+
+/**
+ * @brief Parses a given NMEA sentence and returns a Sample variant.
+ * @param sample  The NMEA sentence to parse.
+ * @param context The state of the stream the sentence belongs to, used to
+ * date sentences that only carry the time of day.
+ * @return std::expected<Sample, ParseError>  An expected containing the parsed
+ * Sample or an error.
+ */
+inline std::expected<Sample, ParseError> parse(StringLike auto const &sample,
+                                               ParseContext &context) {
+  // Any alternative will do, as long as it allocates from the context.
+  Sample result{std::in_place_type<GGA>, context.resource};
+
+  auto parsed = parse_into(result, sample, context);
+  if (!parsed) {
+    return std::unexpected{parsed.error()};
+  }
+
+  return result;
+}
+
+/**
+ * @brief Parses a single NMEA sentence without stream state.
+ * @param sample  The NMEA sentence to parse.
+ * @return std::expected<Sample, ParseError>  An expected containing the parsed
+ * Sample or an error.
+ * @note Sentences that only carry the time of day, such as GGA, are dated
+ * 1970-01-01.
+ * Use the overload taking a ParseContext to date them from the stream.
+ */
+inline std::expected<Sample, ParseError> parse(StringLike auto const &sample) {
+  ParseContext context;
+  return parse(sample, context);
+}
 } // namespace gps_lib
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "parse.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief A pool of parsed samples kept per sentence type, for servers that
+ * parse many receivers on several threads.
+ *
+ * A sample handed back with release() keeps the capacity of its strings and
+ * vectors. acquire() picks a sample of the type the sentence will parse
+ * into, so parse_into() overwrites it in place and, once the pool is warm,
+ * parsing allocates nothing.
+ *
+ * @code
+ * Sample sample = pool.acquire(line);
+ * if (parse_into(sample, line, context)) {
+ *   consume(sample);
+ * }
+ * pool.release(std::move(sample));
+ * @endcode
+ */
+class SamplePool {
+public:
+  /**
+   * @brief Default number of samples kept per sentence type.
+   */
+  static constexpr std::size_t DEFAULT_LIMIT{1024};
+
+  /**
+   * @brief Constructs an empty pool.
+   * @param limit The number of samples kept per sentence type. Samples
+   * released past it are destroyed.
+   */
+  explicit SamplePool(std::size_t limit = DEFAULT_LIMIT) : limit_{limit} {}
+
+  SamplePool(const SamplePool &) = delete;
+  SamplePool &operator=(const SamplePool &) = delete;
+
+  /**
+   * @brief Takes a sample to parse a sentence into.
+   * @param line The sentence that will be parsed into the sample.
+   * @return  Sample  A released sample of the sentence's type if there is
+   * one, otherwise a new sample.
+   */
+  Sample acquire(std::string_view line) {
+    std::size_t index =
+        detail::sentence_index(line.substr(0, line.find_first_of(",*")));
+
+    if (index != std::variant_npos) {
+      Bucket &bucket = buckets_[index];
+      std::lock_guard lock{bucket.mutex};
+
+      if (!bucket.samples.empty()) {
+        Sample sample{std::move(bucket.samples.back())};
+        bucket.samples.pop_back();
+        return sample;
+      }
+    }
+
+    return Sample{};
+  }
+
+  /**
+   * @brief Hands a sample back to the pool.
+   * @param sample The sample, whatever its type.
+   * @return  void    This function does not return a value.
+   */
+  void release(Sample &&sample) {
+    Bucket &bucket = buckets_[sample.index()];
+    std::lock_guard lock{bucket.mutex};
+
+    if (bucket.samples.size() < limit_) {
+      bucket.samples.push_back(std::move(sample));
+    }
+  }
+
+  /**
+   * @brief Returns the number of samples held.
+   * @return  std::size_t     The number of samples, all types together.
+   */
+  std::size_t size() {
+    std::size_t total = 0;
+
+    for (Bucket &bucket : buckets_) {
+      std::lock_guard lock{bucket.mutex};
+      total += bucket.samples.size();
+    }
+
+    return total;
+  }
+
+private:
+  /**
+   * @brief The samples of one type, on their own cache line so threads
+   * recycling different types do not contend.
+   */
+  struct alignas(64) Bucket {
+    std::mutex mutex;            ///< Guards the samples.
+    std::vector<Sample> samples; ///< Released samples.
+  };
+
+  std::size_t limit_;                                       ///< Per-type cap.
+  std::array<Bucket, std::variant_size_v<Sample>> buckets_; ///< By type.
+};
+} // namespace gps_lib
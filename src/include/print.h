@@ -3,6 +3,7 @@
 #include <expected>
 #include <print>
 
+#include "detail/trace.h"
 #include "types.h"
 
 /**
@@ -19,9 +20,9 @@ namespace gps_lib {
 inline void print_gga(const GGA &data) {
   std::println("GGA: {}, {}, {}, {}, {}, {}, {}, {}, {}, {}", data.utc_time,
                data.latitude.value, data.latitude.direction,
-               data.longitude.value, data.longitude.direction, data.quality,
-               data.satellites_used, data.hdop, data.altitude,
-               data.geoidal_separation);
+               data.longitude.value, data.longitude.direction,
+               detail::char_field(data.quality), data.satellites_used,
+               data.hdop, data.altitude, data.geoidal_separation);
 }
 
 /**
@@ -30,8 +31,9 @@ inline void print_gga(const GGA &data) {
  * @return  void    This function does not return a value.
  */
 inline void print_gsa(const GSA &data) {
-  std::println("GSA: {}, {}, {}, {}, {}, {}", data.mode, data.fix_type,
-               data.satellites.size(), data.pdop, data.hdop, data.vdop);
+  std::println("GSA: {}, {}, {}, {}, {}, {}", detail::char_field(data.mode),
+               detail::char_field(data.fix_type), data.satellites.size(),
+               data.pdop, data.hdop, data.vdop);
   for (const auto &sat : data.satellites) {
     std::println("Satellite: {}", sat);
   }
@@ -61,7 +63,8 @@ inline void print_gsv(const GSV &data) {
 inline void print_gll(const GLL &data) {
   std::println("GLL: {}, {}, {}, {}, {}", data.latitude.value,
                data.latitude.direction, data.longitude.value,
-               data.longitude.direction, data.utc_time, data.status);
+               data.longitude.direction, data.utc_time,
+               detail::char_field(data.status));
 }
 
 /**
@@ -70,10 +73,11 @@ inline void print_gll(const GLL &data) {
  * @return  void    This function does not return a value.
  */
 inline void print_rmc(const RMC &data) {
-  std::println("RMC: {}, {}, {}, {}, {}, {}, {}, {}, {}, {}", data.utc_time,
-               data.status, data.latitude.value, data.latitude.direction,
-               data.longitude.value, data.longitude.direction, data.speed,
-               data.course, data.utc_date, data.mode);
+  std::println("RMC: {}, {}, {}, {}, {}, {}, {}, {}, {}", data.utc_time,
+               detail::char_field(data.status), data.latitude.value,
+               data.latitude.direction, data.longitude.value,
+               data.longitude.direction, data.speed, data.course,
+               detail::char_field(data.mode));
 }
 
 /**
@@ -91,17 +95,77 @@ inline void print_vtg(const VTG &data) {
  * @return  void    This function does not return a value.
  */
 inline void print_zda(const ZDA &data) {
-  std::println("ZDA: {}, {}, {}, {}, {}, {}", data.utc_time, data.utc_day,
-               data.utc_month, data.utc_year, data.local_zone_hours,
+  std::println("ZDA: {}, {}, {}", data.utc_time, data.local_zone_hours,
                data.local_zone_minutes);
 }
 
+/**
+ * @brief Prints the GST data.
+ * @param data The GST data to print.
+ * @return  void    This function does not return a value.
+ */
+inline void print_gst(const GST &data) {
+  std::println("GST: {}, {}, {}, {}, {}, {}, {}, {}", data.utc_time, data.rms,
+               data.semi_major_error, data.semi_minor_error, data.orientation,
+               data.latitude_error, data.longitude_error, data.altitude_error);
+}
+
+/**
+ * @brief Prints the GBS data.
+ * @param data The GBS data to print.
+ * @return  void    This function does not return a value.
+ */
+inline void print_gbs(const GBS &data) {
+  std::println("GBS: {}, {}, {}, {}, {}, {}, {}, {}", data.utc_time,
+               data.latitude_error, data.longitude_error, data.altitude_error,
+               data.failed_satellite, data.probability, data.bias,
+               data.bias_deviation);
+}
+
+/**
+ * @brief Prints the GNS data.
+ * @param data The GNS data to print.
+ * @return  void    This function does not return a value.
+ */
+inline void print_gns(const GNS &data) {
+  std::println("GNS: {}, {}, {}, {}, {}, {}, {}, {}, {}, {}", data.utc_time,
+               data.latitude.value, data.latitude.direction,
+               data.longitude.value, data.longitude.direction, data.mode,
+               data.satellites_used, data.hdop, data.altitude,
+               data.geoidal_separation);
+}
+
+/**
+ * @brief Prints the RMB data.
+ * @param data The RMB data to print.
+ * @return  void    This function does not return a value.
+ */
+inline void print_rmb(const RMB &data) {
+  std::println("RMB: {}, {}, {}, {}, {}, {}, {}, {}, {}, {}",
+               detail::char_field(data.status), data.cross_track_error,
+               detail::char_field(data.steer), data.origin, data.destination,
+               data.destination_latitude.value,
+               data.destination_longitude.value, data.range, data.bearing,
+               detail::char_field(data.arrival));
+}
+
+/**
+ * @brief Prints the HDT data.
+ * @param data The HDT data to print.
+ * @return  void    This function does not return a value.
+ */
+inline void print_hdt(const HDT &data) {
+  std::println("HDT: {}", data.heading);
+}
+
 /**
  * @brief Prints the parsed sample data.
  * @param sample The parsed sample to print.
  * @return  void    This function does not return a value.
  */
 inline void print_sample(const std::expected<Sample, ParseError> &sample) {
+  GPS_LIB_TRACE_SCOPE("print_sample");
+
   if (!sample) {
     std::println("Error parsing sample to print.");
     return;
@@ -123,6 +187,16 @@ inline void print_sample(const std::expected<Sample, ParseError> &sample) {
             print_vtg(data);
           } else if constexpr (std::is_same_v<T, ZDA>) {
             print_zda(data);
+          } else if constexpr (std::is_same_v<T, GST>) {
+            print_gst(data);
+          } else if constexpr (std::is_same_v<T, GBS>) {
+            print_gbs(data);
+          } else if constexpr (std::is_same_v<T, GNS>) {
+            print_gns(data);
+          } else if constexpr (std::is_same_v<T, RMB>) {
+            print_rmb(data);
+          } else if constexpr (std::is_same_v<T, HDT>) {
+            print_hdt(data);
           } else {
             std::println("Unknown or unsupported sample type.");
           }
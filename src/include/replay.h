@@ -0,0 +1,286 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <netinet/in.h>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "detail/file_descriptor.h"
+#include "detail/socket.h"
+#include "detail/wait_until.h"
+#include "parse.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Concept for callbacks that receive replayed sentences.
+ *
+ * The sink is called with the index of the log, the raw sentence and its
+ * parsed form.
+ */
+template <typename T>
+concept ReplaySink =
+    std::invocable<T &, std::size_t, std::string_view, const Sample &>;
+
+/**
+ * @brief This struct holds the pacing options of a replay.
+ */
+struct ReplayOptions {
+  double speed{1.0}; ///< Replay speed multiplier, 0 for as fast as possible.
+  /// Gaps between sentences longer than this, or backwards jumps in time, are
+  /// replayed without waiting.
+  std::chrono::milliseconds max_gap{std::chrono::seconds{10}};
+};
+
+/**
+ * @brief This struct holds the statistics of a replayed log.
+ */
+struct ReplayStats {
+  std::size_t sentences{0};                 ///< Sentences emitted.
+  std::size_t skipped{0};                   ///< Invalid or unparsed lines.
+  std::chrono::nanoseconds lateness{0};     ///< Total delay after deadlines.
+  std::chrono::nanoseconds max_lateness{0}; ///< Worst delay after a deadline.
+};
+
+/**
+ * @brief Replays recorded NMEA logs paced by the UTC time of their sentences.
+ *
+ * Each sentence is due when the log time elapsed since the first sentence,
+ * divided by the speed multiplier, has elapsed on the steady clock. Sentences
+ * without a time, such as GSA or VTG, share the time of the last timed
+ * sentence so every epoch is delivered as a burst, like a receiver does.
+ * Deadlines are absolute, so waiting errors never accumulate over a long log.
+ */
+class Replayer {
+public:
+  /**
+   * @brief Constructs a replayer.
+   * @param options The pacing options.
+   */
+  explicit Replayer(ReplayOptions options = {}) : options_{options} {}
+
+  /**
+   * @brief Replays a single log on the calling thread.
+   * @param log The stream to read sentences from, one per line.
+   * @param sink Callback invoked with every sentence when it is due.
+   * @param stop Token that ends the replay early when stop is requested.
+   * @return  ReplayStats     The statistics of the replay.
+   */
+  template <ReplaySink Sink>
+  ReplayStats run(std::istream &log, Sink &&sink,
+                  std::stop_token stop = {}) const {
+    return play(log, 0, std::chrono::steady_clock::now(), sink, stop);
+  }
+
+  /**
+   * @brief Replays several logs concurrently, one thread per log, with a
+   * common start time.
+   * @param logs The paths of the logs to replay.
+   * @param sink Callback invoked with every sentence when it is due. It is
+   * called from several threads at once and must be thread-safe.
+   * @param stop Token that ends the replay early when stop is requested.
+   * @return  std::optional<std::vector<ReplayStats>>  The statistics of each
+   * log, or std::nullopt if a log could not be opened.
+   */
+  template <ReplaySink Sink>
+  std::optional<std::vector<ReplayStats>>
+  run(std::span<const std::filesystem::path> logs, Sink &&sink,
+      std::stop_token stop = {}) const {
+    std::vector<std::ifstream> files;
+    files.reserve(logs.size());
+
+    for (const std::filesystem::path &path : logs) {
+      files.emplace_back(path);
+      if (!files.back()) {
+        return std::nullopt;
+      }
+    }
+
+    std::vector<ReplayStats> stats(files.size());
+    auto start = std::chrono::steady_clock::now();
+
+    {
+      std::vector<std::jthread> threads;
+      threads.reserve(files.size());
+
+      for (std::size_t i = 0; i < files.size(); ++i) {
+        threads.emplace_back([&, i] {
+          stats[i] = play(files[i], i, start, sink, stop);
+        });
+      }
+    }
+
+    return stats;
+  }
+
+private:
+  /**
+   * @brief Replays a log against a given start time.
+   * @param log The stream to read sentences from.
+   * @param id The index of the log passed to the sink.
+   * @param start The steady clock time at which the first sentence is due.
+   * @param sink Callback invoked with every sentence.
+   * @param stop Token that ends the replay early.
+   * @return  ReplayStats     The statistics of the replay.
+   */
+  template <typename Sink>
+  ReplayStats play(std::istream &log, std::size_t id,
+                   std::chrono::steady_clock::time_point start, Sink &sink,
+                   std::stop_token stop) const {
+    using namespace std::chrono;
+
+    ReplayStats stats;
+    ParseContext context;
+    std::optional<Timestamp> previous;
+    duration<double> elapsed{0.0};
+    std::string line;
+
+    while (!stop.stop_requested() && std::getline(log, line)) {
+      if (line.ends_with('\r')) {
+        line.pop_back();
+      }
+
+      auto sample = parse(line, context);
+      if (!sample) {
+        ++stats.skipped;
+        continue;
+      }
+
+      // Untimed sentences keep the time of the last timed one.
+      Timestamp time = context.date + context.time_of_day;
+      auto gap = previous ? time - *previous : milliseconds{0};
+      previous = time;
+
+      if (options_.speed > 0.0) {
+        if (gap > milliseconds{0} && gap <= options_.max_gap) {
+          elapsed += duration<double>{gap} / options_.speed;
+        }
+
+        auto deadline = start + duration_cast<steady_clock::duration>(elapsed);
+        if (!detail::wait_until(deadline, stop)) {
+          break;
+        }
+
+        auto late = steady_clock::now() - deadline;
+        stats.lateness += late;
+        stats.max_lateness = std::max<nanoseconds>(stats.max_lateness, late);
+      }
+
+      sink(id, std::string_view{line}, *sample);
+      ++stats.sentences;
+    }
+
+    return stats;
+  }
+
+  ReplayOptions options_; ///< Pacing options.
+};
+
+/**
+ * @brief Replay sink that sends every sentence as a UDP datagram, so external
+ * services can consume a replay as if it came from a networked receiver.
+ */
+class UdpSink {
+public:
+  /**
+   * @brief Opens a UDP socket towards a local or remote port.
+   * @param port The destination port.
+   * @param address The destination IPv4 address.
+   * @return  std::expected<UdpSink, std::error_code>    The sink, or the
+   * system error that prevented opening it.
+   */
+  static std::expected<UdpSink, std::error_code>
+  open(std::uint16_t port, const std::string &address = "127.0.0.1") {
+    std::optional<sockaddr_in> destination =
+        detail::make_address(address, port);
+    if (!destination) {
+      return std::unexpected{
+          std::make_error_code(std::errc::invalid_argument)};
+    }
+
+    detail::FileDescriptor socket{::socket(AF_INET, SOCK_DGRAM, 0)};
+    if (!socket) {
+      return std::unexpected{detail::last_error()};
+    }
+
+    return UdpSink{std::move(socket), *destination};
+  }
+
+  /**
+   * @brief Moves a sink, keeping its failure count.
+   * @param other The sink to move from.
+   */
+  UdpSink(UdpSink &&other) noexcept
+      : socket_{std::move(other.socket_)}, destination_{other.destination_},
+        failures_{other.failures_.load(std::memory_order_relaxed)} {}
+
+  /**
+   * @brief Sends a sentence terminated by CR LF in a single datagram. Safe to
+   * call from several threads at once. A datagram the socket refuses is
+   * counted in failures() rather than retried, as a receiver would drop it.
+   * @param sentence The raw NMEA sentence.
+   * @return  void    This function does not return a value.
+   */
+  void operator()(std::size_t, std::string_view sentence,
+                  const Sample &) const {
+    static constexpr char terminator[] = "\r\n";
+
+    iovec parts[2]{{const_cast<char *>(sentence.data()), sentence.size()},
+                   {const_cast<char *>(terminator), 2}};
+
+    msghdr message{};
+    message.msg_name = const_cast<sockaddr_in *>(&destination_);
+    message.msg_namelen = sizeof(destination_);
+    message.msg_iov = parts;
+    message.msg_iovlen = 2;
+
+    if (::sendmsg(socket_.get(), &message, 0) < 0) {
+      failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Returns the number of sentences that could not be sent.
+   * @return  std::size_t     The number of failed sends.
+   */
+  std::size_t failures() const {
+    return failures_.load(std::memory_order_relaxed);
+  }
+
+private:
+  /**
+   * @brief Constructs a sink over an open socket.
+   * @param socket The UDP socket.
+   * @param destination The destination address.
+   */
+  UdpSink(detail::FileDescriptor socket, sockaddr_in destination)
+      : socket_{std::move(socket)}, destination_{destination} {}
+
+  detail::FileDescriptor socket_; ///< UDP socket.
+  sockaddr_in destination_;       ///< Destination address.
+  /// Sentences that could not be sent.
+  mutable std::atomic<std::size_t> failures_{0};
+};
+} // namespace gps_lib
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief A raw sentence stored inline, so it can be handed between threads
+ * through a ring without allocating.
+ *
+ * @tparam Capacity Maximum sentence length in bytes. It matches the default
+ * of SentenceFramer, so every sentence the framer emits fits.
+ */
+template <std::size_t Capacity = 128> struct SentenceFrame {
+  std::uint64_t source{0};           ///< Source the sentence came from.
+  std::uint32_t size{0};             ///< Length of the sentence.
+  std::array<char, Capacity> data{}; ///< Sentence bytes, not terminated.
+
+  /**
+   * @brief Copies a sentence into the frame.
+   * @param from The source identifier.
+   * @param sentence The raw sentence.
+   * @return  bool    True if the sentence fits, false if it is too long.
+   */
+  bool assign(std::uint64_t from, std::string_view sentence) {
+    if (sentence.size() > Capacity) {
+      return false;
+    }
+
+    source = from;
+    size = static_cast<std::uint32_t>(sentence.size());
+    sentence.copy(data.data(), sentence.size());
+
+    return true;
+  }
+
+  /**
+   * @brief Returns the stored sentence.
+   * @return  std::string_view    A view of the sentence in the frame.
+   */
+  std::string_view view() const { return {data.data(), size}; }
+};
+
+/**
+ * @brief Bounded lock-free queue for one producer and one consumer thread.
+ *
+ * Typical use is a reader thread handing sentences to a parser thread so a
+ * stall in parsing or output does not stop the reader from draining its
+ * socket or serial port. Each index lives on its own cache line next to a
+ * cached copy of the other one, so in the steady state neither side touches
+ * the other's line.
+ *
+ * @tparam T Element type, trivially copyable.
+ * @tparam Size Number of slots, a power of two.
+ */
+template <typename T, std::size_t Size> class SpscRing {
+  static_assert(std::has_single_bit(Size), "Size must be a power of two");
+  static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+  /**
+   * @brief Appends an element. Producer thread only.
+   * @param value The element to append.
+   * @return  bool    True if appended, false if the ring is full.
+   */
+  bool try_push(const T &value) {
+    std::size_t tail = producer_.index.load(std::memory_order_relaxed);
+
+    if (tail - producer_.cached >= Size) {
+      producer_.cached = consumer_.index.load(std::memory_order_acquire);
+      if (tail - producer_.cached >= Size) {
+        return false;
+      }
+    }
+
+    slots_[tail & MASK] = value;
+    producer_.index.store(tail + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * @brief Appends an element, yielding while the ring is full, so the
+   * producer waits for the consumer instead of dropping data.
+   * @param value The element to append.
+   * @return  void    This function does not return a value.
+   */
+  void push(const T &value) {
+    while (!try_push(value)) {
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * @brief Removes the oldest element. Consumer thread only.
+   * @param value Receives the element.
+   * @return  bool    True if an element was removed, false if the ring is
+   * empty.
+   */
+  bool try_pop(T &value) {
+    std::size_t head = consumer_.index.load(std::memory_order_relaxed);
+
+    if (head == consumer_.cached) {
+      consumer_.cached = producer_.index.load(std::memory_order_acquire);
+      if (head == consumer_.cached) {
+        return false;
+      }
+    }
+
+    value = slots_[head & MASK];
+    consumer_.index.store(head + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * @brief Visits every available element in place and removes them with a
+   * single index update. Consumer thread only.
+   * @param visit Callback invoked with each element, oldest first.
+   * @return  std::size_t     The number of elements visited.
+   */
+  template <std::invocable<const T &> Visit> std::size_t drain(Visit &&visit) {
+    std::size_t head = consumer_.index.load(std::memory_order_relaxed);
+    consumer_.cached = producer_.index.load(std::memory_order_acquire);
+
+    for (std::size_t i = head; i != consumer_.cached; ++i) {
+      visit(slots_[i & MASK]);
+    }
+
+    consumer_.index.store(consumer_.cached, std::memory_order_release);
+
+    return consumer_.cached - head;
+  }
+
+  /**
+   * @brief Returns the number of elements in the ring. Exact only when
+   * called from the producer or the consumer while the other is idle.
+   * @return  std::size_t     The number of elements.
+   */
+  std::size_t size() const {
+    return producer_.index.load(std::memory_order_acquire) -
+           consumer_.index.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr std::size_t MASK{Size - 1}; ///< Slot index mask.
+
+  /**
+   * @brief One side's index and its cached copy of the other side's index.
+   */
+  struct alignas(64) Side {
+    std::atomic<std::size_t> index{0}; ///< Next slot this side uses.
+    std::size_t cached{0};             ///< Last seen index of the other side.
+  };
+
+  Side producer_;                           ///< Tail, written by the producer.
+  Side consumer_;                           ///< Head, written by the consumer.
+  alignas(64) std::array<T, Size> slots_{}; ///< Element storage.
+};
+
+/**
+ * @brief Bounded lock-free queue for many producer threads and one consumer
+ * thread.
+ *
+ * Producers claim slots with a compare-and-swap on the tail, so several
+ * readers can feed one parser. Every slot carries a sequence number telling
+ * whether it is free for the producer of a lap or published for the
+ * consumer, which keeps a slow producer from exposing a half-written slot.
+ *
+ * @tparam T Element type, trivially copyable.
+ * @tparam Size Number of slots, a power of two.
+ */
+template <typename T, std::size_t Size> class MpscRing {
+  static_assert(std::has_single_bit(Size), "Size must be a power of two");
+  static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+  MpscRing() {
+    for (std::size_t i = 0; i < Size; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscRing(const MpscRing &) = delete;
+  MpscRing &operator=(const MpscRing &) = delete;
+
+  /**
+   * @brief Appends an element. Safe to call from several threads at once.
+   * @param value The element to append.
+   * @return  bool    True if appended, false if the ring is full.
+   */
+  bool try_push(const T &value) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+
+    while (true) {
+      Slot &slot = slots_[tail & MASK];
+      std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      auto lag = static_cast<std::ptrdiff_t>(sequence - tail);
+
+      if (lag == 0) {
+        if (tail_.compare_exchange_weak(tail, tail + 1,
+                                        std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.sequence.store(tail + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;
+      } else {
+        tail = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Appends an element, yielding while the ring is full, so the
+   * producer waits for the consumer instead of dropping data.
+   * @param value The element to append.
+   * @return  void    This function does not return a value.
+   */
+  void push(const T &value) {
+    while (!try_push(value)) {
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * @brief Removes the oldest element. Consumer thread only.
+   * @param value Receives the element.
+   * @return  bool    True if an element was removed, false if the ring is
+   * empty or the oldest element is still being written.
+   */
+  bool try_pop(T &value) {
+    Slot &slot = slots_[head_ & MASK];
+
+    if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return false;
+    }
+
+    value = slot.value;
+    slot.sequence.store(head_ + Size, std::memory_order_release);
+    ++head_;
+
+    return true;
+  }
+
+  /**
+   * @brief Visits available elements in place, oldest first, stopping at
+   * the first one still being written. Consumer thread only.
+   * @param visit Callback invoked with each element.
+   * @return  std::size_t     The number of elements visited.
+   */
+  template <std::invocable<const T &> Visit> std::size_t drain(Visit &&visit) {
+    std::size_t visited = 0;
+
+    while (true) {
+      Slot &slot = slots_[head_ & MASK];
+      if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+        return visited;
+      }
+
+      visit(slot.value);
+      slot.sequence.store(head_ + Size, std::memory_order_release);
+      ++head_;
+      ++visited;
+    }
+  }
+
+  /**
+   * @brief Checks whether the oldest element is ready. Consumer thread only.
+   * @return  bool    True if nothing can be popped yet.
+   */
+  bool empty() const {
+    return slots_[head_ & MASK].sequence.load(std::memory_order_acquire) !=
+           head_ + 1;
+  }
+
+private:
+  static constexpr std::size_t MASK{Size - 1}; ///< Slot index mask.
+
+  /**
+   * @brief An element and the sequence number that publishes it.
+   */
+  struct Slot {
+    std::atomic<std::size_t> sequence{0}; ///< Lap and state of the slot.
+    T value{};                            ///< Stored element.
+  };
+
+  alignas(64) std::atomic<std::size_t> tail_{0}; ///< Next slot to claim.
+  alignas(64) std::size_t head_{0};              ///< Next slot to consume.
+  alignas(64) std::array<Slot, Size> slots_{};   ///< Element storage.
+};
+
+} // namespace gps_lib
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+
+#include "metrics.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Preamble of an RTCM3 frame.
+ */
+constexpr char RTCM_PREAMBLE{'\xD3'};
+
+/**
+ * @brief Bytes before the payload: preamble, 6 reserved bits and the 10-bit
+ * length.
+ */
+constexpr std::size_t RTCM_HEADER_SIZE{3};
+
+/**
+ * @brief Bytes of framing around the payload, header and CRC together.
+ */
+constexpr std::size_t RTCM_FRAME_OVERHEAD{RTCM_HEADER_SIZE + 3};
+
+/**
+ * @brief Largest payload the 10-bit length field can describe.
+ */
+constexpr std::size_t RTCM_MAX_PAYLOAD{1023};
+
+/**
+ * @brief An RTCM3 frame with a valid CRC.
+ */
+struct RtcmFrame {
+  std::uint16_t message_type; ///< Message number, e.g. 1005; 0 if empty.
+  std::string_view payload;   ///< Payload, a view into the decoded bytes.
+  /// The whole frame, preamble to CRC, ready to forward to a rover.
+  std::string_view bytes;
+};
+
+namespace detail {
+/**
+ * @brief Generator polynomial of CRC-24Q, without its x^24 term.
+ */
+constexpr std::uint32_t CRC24Q_POLYNOMIAL{0x864CFB};
+
+/**
+ * @brief Builds the byte-at-a-time lookup table of CRC-24Q.
+ * @return  std::array<std::uint32_t, 256>  The CRC of every byte value.
+ */
+constexpr std::array<std::uint32_t, 256> make_crc24q_table() {
+  std::array<std::uint32_t, 256> table{};
+
+  for (std::uint32_t byte = 0; byte < table.size(); ++byte) {
+    std::uint32_t crc = byte << 16;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc << 1) ^ ((crc & 0x800000) != 0 ? CRC24Q_POLYNOMIAL : 0);
+    }
+    table[byte] = crc & 0xFFFFFF;
+  }
+
+  return table;
+}
+
+/**
+ * @brief Lookup table of CRC-24Q, computed at compile time.
+ */
+inline constexpr std::array<std::uint32_t, 256> CRC24Q_TABLE{
+    make_crc24q_table()};
+
+/**
+ * @brief Computes the CRC-24Q of an RTCM3 frame.
+ * @param body The header and payload bytes.
+ * @return  std::uint32_t   The CRC in the low 24 bits.
+ */
+constexpr std::uint32_t crc24q(std::string_view body) {
+  std::uint32_t crc = 0;
+
+  for (char c : body) {
+    auto index = ((crc >> 16) ^ static_cast<unsigned char>(c)) & 0xFF;
+    crc = ((crc << 8) ^ CRC24Q_TABLE[index]) & 0xFFFFFF;
+  }
+
+  return crc;
+}
+
+/**
+ * @brief Reads a big-endian field of an RTCM3 frame.
+ * @param bytes The frame.
+ * @param offset The offset of the field.
+ * @param size The size of the field in bytes, at most 4.
+ * @return  std::uint32_t   The field.
+ */
+constexpr std::uint32_t read_be(std::string_view bytes, std::size_t offset,
+                                std::size_t size) {
+  std::uint32_t value = 0;
+
+  for (std::size_t i = 0; i < size; ++i) {
+    value = (value << 8) | static_cast<unsigned char>(bytes[offset + i]);
+  }
+
+  return value;
+}
+} // namespace detail
+
+/**
+ * @brief Returns the payload length of an RTCM3 frame from its header.
+ * @param header At least the first RTCM_HEADER_SIZE bytes of the frame.
+ * @return  std::size_t     The payload length.
+ */
+constexpr std::size_t rtcm_payload_size(std::string_view header) {
+  return detail::read_be(header, 1, 2) & 0x3FF;
+}
+
+/**
+ * @brief Checks and decodes one RTCM3 frame.
+ * @param frame The frame, from the preamble to the CRC.
+ * @return  std::expected<RtcmFrame, ParseError>   The frame, whose views
+ * point into the given bytes, or MissingFields if the frame is truncated
+ * and InvalidFormat if its preamble, reserved bits, length or CRC are wrong.
+ */
+inline std::expected<RtcmFrame, ParseError>
+decode_rtcm(std::string_view frame) {
+  if (frame.size() < RTCM_FRAME_OVERHEAD) {
+    return std::unexpected(ParseError::MissingFields);
+  }
+
+  if (frame[0] != RTCM_PREAMBLE || (frame[1] & 0xFC) != 0) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  std::size_t length = rtcm_payload_size(frame);
+
+  if (frame.size() < length + RTCM_FRAME_OVERHEAD) {
+    return std::unexpected(ParseError::MissingFields);
+  } else if (frame.size() > length + RTCM_FRAME_OVERHEAD) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  std::size_t crc_offset = RTCM_HEADER_SIZE + length;
+  if (detail::crc24q(frame.substr(0, crc_offset)) !=
+      detail::read_be(frame, crc_offset, 3)) {
+#ifdef GPS_LIB_METRICS
+    detail::record_checksum_failure();
+#endif
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  std::string_view payload = frame.substr(RTCM_HEADER_SIZE, length);
+  auto message_type = static_cast<std::uint16_t>(
+      payload.size() >= 2 ? detail::read_be(payload, 0, 2) >> 4 : 0);
+
+  return RtcmFrame{message_type, payload, frame};
+}
+
+/**
+ * @brief Appends an RTCM3 frame, with its CRC, to a byte string.
+ * @param out The bytes to append to.
+ * @param payload The payload, at most RTCM_MAX_PAYLOAD bytes; its first 12
+ * bits are the message number.
+ * @return  void    This function does not return a value.
+ */
+inline void encode_rtcm(std::string &out, std::string_view payload) {
+  std::size_t start = out.size();
+
+  out.push_back(RTCM_PREAMBLE);
+  out.push_back(static_cast<char>((payload.size() >> 8) & 0x03));
+  out.push_back(static_cast<char>(payload.size() & 0xFF));
+  out.append(payload);
+
+  std::uint32_t crc = detail::crc24q({out.data() + start, out.size() - start});
+  out.push_back(static_cast<char>((crc >> 16) & 0xFF));
+  out.push_back(static_cast<char>((crc >> 8) & 0xFF));
+  out.push_back(static_cast<char>(crc & 0xFF));
+}
+} // namespace gps_lib
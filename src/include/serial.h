@@ -0,0 +1,377 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <expected>
+#include <fcntl.h>
+#include <filesystem>
+#include <linux/serial.h>
+#include <optional>
+#include <poll.h>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <system_error>
+#include <termios.h>
+#include <unistd.h>
+#include <utility>
+
+#include "detail/file_descriptor.h"
+#include "framer.h"
+#include "parse.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Concept for callbacks that receive sentences read from a serial
+ * port.
+ *
+ * The handler is called with the raw sentence and its parsed form.
+ */
+template <typename T>
+concept SerialHandler = std::invocable<T &, std::string_view, const Sample &>;
+
+/**
+ * @brief This struct holds the line settings of a serial port.
+ *
+ * The defaults favour latency: a read returns as soon as one byte is
+ * available instead of waiting for a buffer to fill or a timer to expire.
+ */
+struct SerialOptions {
+  unsigned baud{9600};    ///< Line speed in bits per second.
+  std::uint8_t vmin{1};   ///< Bytes a read waits for (VMIN).
+  std::uint8_t vtime{0};  ///< Inter-byte timeout in tenths of a second.
+  bool low_latency{true}; ///< Ask the UART driver to skip its receive delay.
+};
+
+/**
+ * @brief This struct holds the latency between reading the bytes that
+ * complete a sentence and having its sample parsed.
+ */
+struct LatencyStats {
+  std::size_t count{0};              ///< Samples measured.
+  std::chrono::nanoseconds total{0}; ///< Sum of latencies.
+  /// Best latency, the maximum duration until one is measured.
+  std::chrono::nanoseconds min{std::chrono::nanoseconds::max()};
+  std::chrono::nanoseconds max{0}; ///< Worst latency.
+
+  /**
+   * @brief Records one latency.
+   * @param latency The measured latency.
+   * @return  void    This function does not return a value.
+   */
+  void add(std::chrono::nanoseconds latency) {
+    ++count;
+    total += latency;
+    min = std::min(min, latency);
+    max = std::max(max, latency);
+  }
+
+  /**
+   * @brief Returns the mean latency.
+   * @return  std::chrono::nanoseconds    The mean, or zero if nothing was
+   * measured.
+   */
+  std::chrono::nanoseconds mean() const {
+    return count == 0 ? std::chrono::nanoseconds{0}
+                      : total / static_cast<std::int64_t>(count);
+  }
+};
+
+/**
+ * @brief This struct holds the statistics of a serial reader.
+ */
+struct SerialStats {
+  std::size_t reads{0};     ///< Reads that returned data.
+  std::size_t bytes{0};     ///< Bytes received.
+  std::size_t sentences{0}; ///< Sentences parsed and passed to the handler.
+  std::size_t errors{0};    ///< Sentences that failed to parse.
+  std::size_t dropped{0};   ///< Sentences dropped by the framer.
+  LatencyStats latency;     ///< Byte to parsed sample latency.
+};
+
+namespace detail {
+/**
+ * @brief Maps a line speed to its termios constant.
+ * @param baud The speed in bits per second.
+ * @return  std::optional<speed_t>     The constant, or std::nullopt if the
+ * speed is not a standard one.
+ */
+inline std::optional<speed_t> baud_constant(unsigned baud) {
+  static constexpr std::array<std::pair<unsigned, speed_t>, 12> speeds{{
+      {1200, B1200},
+      {2400, B2400},
+      {4800, B4800},
+      {9600, B9600},
+      {19200, B19200},
+      {38400, B38400},
+      {57600, B57600},
+      {115200, B115200},
+      {230400, B230400},
+      {460800, B460800},
+      {500000, B500000},
+      {921600, B921600},
+  }};
+
+  auto it =
+      std::ranges::find(speeds, baud, &std::pair<unsigned, speed_t>::first);
+  if (it == speeds.end()) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+} // namespace detail
+
+/**
+ * @brief Reads NMEA sentences from a serial receiver such as /dev/ttyUSB0 or
+ * /dev/ttyACM0.
+ *
+ * The port is put in raw mode, so the line discipline neither buffers lines
+ * nor translates characters, and every read hands whatever arrived to a
+ * SentenceFramer. Each sentence is parsed as soon as its line feed is read.
+ * The time from the wake-up that delivered the line feed to the parsed
+ * sample is recorded, which is the part of the latency budget the host
+ * controls.
+ *
+ * It is only available on Linux: a stop request wakes the reader through an
+ * eventfd, and low_latency sets ASYNC_LOW_LATENCY from <linux/serial.h>.
+ */
+class SerialReader {
+public:
+  /**
+   * @brief Opens and configures a serial port.
+   * @param device The path of the device, or of a pseudo-terminal.
+   * @param options The line settings.
+   * @return  std::expected<SerialReader, std::error_code>   The reader, or
+   * the system error that prevented configuring the port.
+   */
+  static std::expected<SerialReader, std::error_code>
+  open(const std::filesystem::path &device, SerialOptions options = {}) {
+    std::optional<speed_t> speed = detail::baud_constant(options.baud);
+    if (!speed) {
+      return std::unexpected{
+          std::make_error_code(std::errc::invalid_argument)};
+    }
+
+    detail::FileDescriptor port{
+        ::open(device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC)};
+    if (!port) {
+      return std::unexpected{detail::last_error()};
+    }
+
+    termios settings{};
+    if (::tcgetattr(port.get(), &settings) != 0) {
+      return std::unexpected{detail::last_error()};
+    }
+
+    ::cfmakeraw(&settings);
+    settings.c_cflag |= CLOCAL | CREAD;
+    settings.c_cc[VMIN] = options.vmin;
+    settings.c_cc[VTIME] = options.vtime;
+
+    if (::cfsetispeed(&settings, *speed) != 0 ||
+        ::cfsetospeed(&settings, *speed) != 0 ||
+        ::tcsetattr(port.get(), TCSANOW, &settings) != 0) {
+      return std::unexpected{detail::last_error()};
+    }
+
+    // Only real UARTs support this; pseudo-terminals and USB CDC devices
+    // reject it and have no such delay anyway.
+    serial_struct serial{};
+    if (options.low_latency && ::ioctl(port.get(), TIOCGSERIAL, &serial) == 0) {
+      serial.flags |= ASYNC_LOW_LATENCY;
+      ::ioctl(port.get(), TIOCSSERIAL, &serial);
+    }
+
+    ::tcflush(port.get(), TCIFLUSH);
+
+    return SerialReader{std::move(port)};
+  }
+
+  /**
+   * @brief Reads sentences on the calling thread until the device closes or
+   * stop is requested.
+   * @param handler Callback invoked with every parsed sentence.
+   * @param stop Token that ends the reading when stop is requested.
+   * @return  std::expected<SerialStats, std::error_code>    The statistics,
+   * or the system error that ended the reading.
+   */
+  template <SerialHandler Handler>
+  std::expected<SerialStats, std::error_code>
+  run(Handler &&handler, std::stop_token stop = {}) {
+    using namespace std::chrono;
+
+    detail::FileDescriptor stop_event{::eventfd(0, EFD_CLOEXEC)};
+    if (!stop_event) {
+      return std::unexpected{detail::last_error()};
+    }
+
+    std::stop_callback wake{stop, [&] {
+                              std::uint64_t one = 1;
+                              [[maybe_unused]] auto written = ::write(
+                                  stop_event.get(), &one, sizeof(one));
+                            }};
+
+    SerialStats stats;
+    ParseContext context;
+    SentenceFramer<> framer;
+    std::array<char, 4096> buffer;
+    std::array<pollfd, 2> events{{{port_.get(), POLLIN, 0},
+                                  {stop_event.get(), POLLIN, 0}}};
+
+    while (!stop.stop_requested()) {
+      if (::poll(events.data(), events.size(), -1) < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return std::unexpected{detail::last_error()};
+      }
+
+      if (events[1].revents != 0) {
+        break;
+      }
+
+      auto received = steady_clock::now();
+      ssize_t size = ::read(port_.get(), buffer.data(), buffer.size());
+
+      if (size < 0) {
+        if (errno == EAGAIN || errno == EINTR) {
+          continue;
+        }
+        // A pseudo-terminal reports EIO once its controlling side closes.
+        if (errno == EIO && (events[0].revents & POLLHUP)) {
+          break;
+        }
+        return std::unexpected{detail::last_error()};
+      }
+
+      if (size == 0) {
+        break;
+      }
+
+      ++stats.reads;
+      stats.bytes += static_cast<std::size_t>(size);
+
+      framer.push({buffer.data(), static_cast<std::size_t>(size)},
+                  [&](std::string_view line) {
+                    auto sample = parse(line, context);
+                    if (!sample) {
+                      ++stats.errors;
+                      return;
+                    }
+
+                    stats.latency.add(steady_clock::now() - received);
+                    handler(line, *sample);
+                    ++stats.sentences;
+                  });
+    }
+
+    stats.dropped = framer.dropped();
+
+    return stats;
+  }
+
+private:
+  /**
+   * @brief Constructs a reader over a configured port.
+   * @param port The serial port.
+   */
+  explicit SerialReader(detail::FileDescriptor port) : port_{std::move(port)} {}
+
+  detail::FileDescriptor port_; ///< Serial port.
+};
+
+/**
+ * @brief A pseudo-terminal pair that stands in for a receiver in tests.
+ *
+ * Bytes written to the controlling side arrive at the device side, which a
+ * SerialReader opens like any serial port.
+ */
+class PseudoTerminal {
+public:
+  /**
+   * @brief Allocates a pseudo-terminal pair.
+   * @return  std::expected<PseudoTerminal, std::error_code>     The pair, or
+   * the system error that prevented allocating it.
+   */
+  static std::expected<PseudoTerminal, std::error_code> open() {
+    detail::FileDescriptor controller{
+        ::posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC)};
+    std::array<char, 64> name{};
+
+    if (!controller || ::grantpt(controller.get()) != 0 ||
+        ::unlockpt(controller.get()) != 0) {
+      return std::unexpected{detail::last_error()};
+    }
+
+    // Unlike the calls above, ptsname_r returns its error instead of setting
+    // errno.
+    if (int error = ::ptsname_r(controller.get(), name.data(), name.size());
+        error != 0) {
+      return std::unexpected{std::error_code{error, std::system_category()}};
+    }
+
+    return PseudoTerminal{std::move(controller), name.data()};
+  }
+
+  /**
+   * @brief Returns the path of the device side.
+   * @return  const std::filesystem::path&   The path, e.g. /dev/pts/3.
+   */
+  const std::filesystem::path &device() const { return device_; }
+
+  /**
+   * @brief Writes bytes as if the receiver had sent them.
+   * @param data The bytes to send.
+   * @return  bool    True if every byte was written.
+   */
+  bool write(std::string_view data) const {
+    while (!data.empty()) {
+      ssize_t written = ::write(controller_.get(), data.data(), data.size());
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      data.remove_prefix(static_cast<std::size_t>(written));
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Closes the controlling side, which ends reading on the device
+   * side like unplugging a receiver.
+   * @return  void    This function does not return a value.
+   */
+  void close() { controller_.reset(); }
+
+private:
+  /**
+   * @brief Constructs a pair over an open controlling side.
+   * @param controller The controlling side.
+   * @param device The path of the device side.
+   */
+  PseudoTerminal(detail::FileDescriptor controller,
+                 std::filesystem::path device)
+      : controller_{std::move(controller)}, device_{std::move(device)} {}
+
+  detail::FileDescriptor controller_; ///< Controlling side.
+  std::filesystem::path device_;      ///< Path of the device side.
+};
+} // namespace gps_lib
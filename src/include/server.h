@@ -0,0 +1,485 @@
+#pragma once
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <netinet/in.h>
+#include <string>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "detail/file_descriptor.h"
+#include "detail/io_backend.h"
+#include "detail/lru_map.h"
+#include "detail/socket.h"
+#include "framer.h"
+#include "parse.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Concept for callbacks that receive ingested sentences.
+ *
+ * The handler is called with the source of the sentence, as returned by
+ * source_id(), the raw sentence and its parsed form.
+ */
+template <typename T>
+concept IngestHandler =
+    std::invocable<T &, std::uint64_t, std::string_view, const Sample &>;
+
+/**
+ * @brief This struct holds the configuration of an ingest server.
+ */
+struct ServerOptions {
+  std::string address{"127.0.0.1"}; ///< IPv4 address to listen on.
+  std::uint16_t port{10110};        ///< Port to listen on, 0 for any.
+  std::size_t threads{1};           ///< Worker threads, one epoll each.
+  bool udp{true};                   ///< Accept datagrams.
+  bool tcp{true};                   ///< Accept stream connections.
+  int receive_buffer{0};            ///< SO_RCVBUF in bytes, 0 for default.
+  /// UDP senders whose parse state each worker keeps; the least recently
+  /// heard is forgotten beyond this.
+  std::size_t udp_sources{4096};
+};
+
+/**
+ * @brief This struct holds the counters of an ingest server.
+ */
+struct ServerStats {
+  std::size_t connections{0}; ///< TCP connections accepted.
+  std::size_t datagrams{0};   ///< UDP datagrams received.
+  std::size_t bytes{0};       ///< Bytes received over UDP and TCP.
+  std::size_t sentences{0};   ///< Sentences parsed and dispatched.
+  std::size_t errors{0};      ///< Sentences that failed to parse.
+  std::size_t syscalls{0};    ///< System calls made by the workers.
+  std::size_t evictions{0};   ///< UDP parse states dropped to make room.
+};
+
+/**
+ * @brief Packs an IPv4 address and port into a source identifier.
+ * @param address The peer address.
+ * @return  std::uint64_t   The address in the upper bits and the port in the
+ * lower 16 bits, both in host order.
+ */
+inline std::uint64_t source_id(const sockaddr_in &address) {
+  return static_cast<std::uint64_t>(ntohl(address.sin_addr.s_addr)) << 16 |
+         ntohs(address.sin_port);
+}
+
+/**
+ * @brief Receives NMEA sentences over UDP and TCP and dispatches them parsed
+ * to a handler.
+ *
+ * Every worker thread owns an epoll instance and its own UDP and TCP sockets
+ * bound to the same port with SO_REUSEPORT, so the kernel spreads senders
+ * across workers and no state is shared between them. All sockets are
+ * non-blocking. Datagrams are read in batches with recvmmsg and may carry
+ * several sentences; stream connections get their own framer. Each source
+ * has its own ParseContext, so GGA and GLL sentences are dated with that
+ * source's RMC or ZDA date. UDP source addresses can be spoofed, so each
+ * worker keeps the contexts of at most ServerOptions::udp_sources senders
+ * and forgets the least recently heard one beyond that.
+ *
+ * @tparam Handler The handler type. It is called from all worker threads at
+ * once and must be thread-safe.
+ */
+template <IngestHandler Handler> class IngestServer {
+public:
+  /**
+   * @brief Constructs a stopped server.
+   * @param options The server configuration.
+   * @param handler Callback invoked with every parsed sentence.
+   */
+  IngestServer(ServerOptions options, Handler handler)
+      : options_{std::move(options)}, handler_{std::move(handler)} {}
+
+  IngestServer(const IngestServer &) = delete;
+  IngestServer &operator=(const IngestServer &) = delete;
+
+  ~IngestServer() { stop(); }
+
+  /**
+   * @brief Opens the sockets and starts the worker threads.
+   * @return  std::expected<void, std::error_code>   Nothing on success, or
+   * the system error that prevented opening a socket.
+   */
+  std::expected<void, std::error_code> start() {
+    stop();
+
+    std::optional<sockaddr_in> address =
+        detail::make_address(options_.address, options_.port);
+    if (!address) {
+      return std::unexpected{
+          std::make_error_code(std::errc::invalid_argument)};
+    }
+
+    stop_event_.reset(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+    if (!stop_event_) {
+      return std::unexpected{detail::last_error()};
+    }
+
+    for (std::size_t i = 0; i < std::max<std::size_t>(options_.threads, 1);
+         ++i) {
+      auto worker = std::make_unique<Worker>(options_.udp_sources);
+
+      worker->epoll.reset(::epoll_create1(EPOLL_CLOEXEC));
+      if (!worker->epoll || !watch(*worker, stop_event_.get())) {
+        return fail();
+      }
+
+      // TCP binds first: a port picked for UDP may still be held by TCP
+      // connections in TIME_WAIT.
+      if (options_.tcp &&
+          !(detail::open_socket(worker->tcp, SOCK_STREAM, *address,
+                                options_.receive_buffer) &&
+            watch(*worker, worker->tcp.get()))) {
+        return fail();
+      }
+
+      if (options_.udp &&
+          !(detail::open_socket(worker->udp, SOCK_DGRAM, *address,
+                                options_.receive_buffer) &&
+            watch(*worker, worker->udp.get()))) {
+        return fail();
+      }
+
+      workers_.push_back(std::move(worker));
+    }
+
+    port_ = ntohs(address->sin_port);
+
+    for (const std::unique_ptr<Worker> &worker : workers_) {
+      threads_.emplace_back([this, &worker = *worker] { run(worker); });
+    }
+
+    return {};
+  }
+
+  /**
+   * @brief Stops the worker threads and closes all sockets.
+   * @return  void    This function does not return a value.
+   */
+  void stop() {
+    if (stop_event_) {
+      std::uint64_t signal = 1;
+      [[maybe_unused]] auto written =
+          ::write(stop_event_.get(), &signal, sizeof(signal));
+    }
+
+    threads_.clear();
+    workers_.clear();
+    stop_event_.reset();
+  }
+
+  /**
+   * @brief Returns the port the server listens on, useful when started on
+   * port 0.
+   * @return  std::uint16_t   The bound port.
+   */
+  std::uint16_t port() const { return port_; }
+
+  /**
+   * @brief Returns the I/O mechanism of the server.
+   * @return  IoBackend   Always IoBackend::Posix.
+   */
+  IoBackend backend() const { return IoBackend::Posix; }
+
+  /**
+   * @brief Returns the counters summed over all workers.
+   * @return  ServerStats     The current counters.
+   */
+  ServerStats stats() const {
+    ServerStats total;
+
+    for (const std::unique_ptr<Worker> &worker : workers_) {
+      total.connections += worker->connections.load(std::memory_order_relaxed);
+      total.datagrams += worker->datagrams.load(std::memory_order_relaxed);
+      total.bytes += worker->bytes.load(std::memory_order_relaxed);
+      total.sentences += worker->sentences.load(std::memory_order_relaxed);
+      total.errors += worker->errors.load(std::memory_order_relaxed);
+      total.syscalls += worker->syscalls.load(std::memory_order_relaxed);
+      total.evictions += worker->evictions.load(std::memory_order_relaxed);
+    }
+
+    return total;
+  }
+
+private:
+  static constexpr std::size_t BATCH{32};        ///< Datagrams per recvmmsg.
+  static constexpr std::size_t DATAGRAM{2048};   ///< Datagram buffer size.
+  static constexpr std::size_t READ_SIZE{65536}; ///< Stream read size.
+
+  /**
+   * @brief This struct holds the state of a TCP connection.
+   */
+  struct Connection {
+    detail::FileDescriptor socket; ///< Connected socket.
+    std::uint64_t source;          ///< Source identifier of the peer.
+    SentenceFramer<> framer;       ///< Framer for the byte stream.
+    ParseContext context;          ///< Parse state of the stream.
+  };
+
+  /**
+   * @brief This struct holds everything a worker thread owns. Counters are
+   * only written by the worker and read by stats().
+   */
+  struct alignas(64) Worker {
+    /**
+     * @brief Constructs the state of a worker.
+     * @param udp_sources The number of UDP senders to keep state for.
+     */
+    explicit Worker(std::size_t udp_sources) : peers{udp_sources} {}
+
+    detail::FileDescriptor epoll; ///< Event loop of the worker.
+    detail::FileDescriptor udp;   ///< Datagram socket.
+    detail::FileDescriptor tcp;   ///< Listening socket.
+    /// Stream connections by descriptor.
+    std::unordered_map<int, Connection> streams;
+    /// Parse state of the most recently heard UDP senders.
+    detail::LruMap<std::uint64_t, ParseContext> peers;
+    /// Receive buffers for a batch of datagrams.
+    std::array<std::array<char, DATAGRAM>, BATCH> datagram_buffers{};
+    std::array<char, READ_SIZE> read_buffer{}; ///< Stream receive buffer.
+    std::atomic<std::size_t> connections{0};   ///< Accepted connections.
+    std::atomic<std::size_t> datagrams{0};     ///< Received datagrams.
+    std::atomic<std::size_t> bytes{0};         ///< Received bytes.
+    std::atomic<std::size_t> sentences{0};     ///< Dispatched sentences.
+    std::atomic<std::size_t> errors{0};        ///< Unparsed sentences.
+    std::atomic<std::size_t> syscalls{0};      ///< System calls.
+    std::atomic<std::size_t> evictions{0};     ///< Forgotten UDP senders.
+  };
+
+  /**
+   * @brief Adds one to a counter that only the calling worker writes.
+   * @param counter The counter to increment.
+   * @param amount The amount to add.
+   * @return  void    This function does not return a value.
+   */
+  static void count(std::atomic<std::size_t> &counter, std::size_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Registers a descriptor for input events on a worker's epoll.
+   * @param worker The worker.
+   * @param fd The descriptor to watch.
+   * @return  bool    True on success, false with errno set otherwise.
+   */
+  static bool watch(Worker &worker, int fd) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+
+    return ::epoll_ctl(worker.epoll.get(), EPOLL_CTL_ADD, fd, &event) == 0;
+  }
+
+  /**
+   * @brief Releases everything opened by a failed start().
+   * @return  std::unexpected<std::error_code>   The error of the failed call.
+   */
+  std::unexpected<std::error_code> fail() {
+    std::error_code error = detail::last_error();
+    workers_.clear();
+    stop_event_.reset();
+    return std::unexpected{error};
+  }
+
+  /**
+   * @brief Runs a worker's event loop until the server stops.
+   * @param worker The worker.
+   * @return  void    This function does not return a value.
+   */
+  void run(Worker &worker) {
+    std::array<epoll_event, 64> events;
+
+    while (true) {
+      int ready = ::epoll_wait(worker.epoll.get(), events.data(),
+                               static_cast<int>(events.size()), -1);
+      count(worker.syscalls);
+      if (ready < 0 && errno != EINTR) {
+        return;
+      }
+
+      for (int i = 0; i < ready; ++i) {
+        int fd = events[i].data.fd;
+
+        if (fd == stop_event_.get()) {
+          return;
+        } else if (fd == worker.udp.get()) {
+          receive_datagrams(worker);
+        } else if (fd == worker.tcp.get()) {
+          accept_connections(worker);
+        } else {
+          receive_stream(worker, fd);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Reads all pending datagrams in batches.
+   * @param worker The worker.
+   * @return  void    This function does not return a value.
+   */
+  void receive_datagrams(Worker &worker) {
+    std::array<mmsghdr, BATCH> messages{};
+    std::array<iovec, BATCH> vectors{};
+    std::array<sockaddr_in, BATCH> senders{};
+
+    for (std::size_t i = 0; i < BATCH; ++i) {
+      vectors[i] = {worker.datagram_buffers[i].data(), DATAGRAM};
+      messages[i].msg_hdr.msg_iov = &vectors[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+      messages[i].msg_hdr.msg_name = &senders[i];
+    }
+
+    int received = static_cast<int>(BATCH);
+
+    while (received == static_cast<int>(BATCH)) {
+      for (mmsghdr &message : messages) {
+        message.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      }
+
+      received = ::recvmmsg(worker.udp.get(), messages.data(), BATCH,
+                            MSG_DONTWAIT, nullptr);
+      count(worker.syscalls);
+
+      for (int i = 0; i < received; ++i) {
+        std::uint64_t source = source_id(senders[i]);
+        auto [context, evicted] = worker.peers.acquire(source);
+        if (evicted) {
+          count(worker.evictions);
+        }
+        auto dispatch_line = [&](std::string_view line) {
+          dispatch(worker, source, context, line);
+        };
+
+        // Datagrams are self-contained, so each gets a fresh framer.
+        SentenceFramer<> framer;
+        framer.push({worker.datagram_buffers[i].data(), messages[i].msg_len},
+                    dispatch_line);
+        framer.flush(dispatch_line);
+
+        count(worker.datagrams);
+        count(worker.bytes, messages[i].msg_len);
+      }
+    }
+  }
+
+  /**
+   * @brief Accepts all pending connections.
+   * @param worker The worker.
+   * @return  void    This function does not return a value.
+   */
+  void accept_connections(Worker &worker) {
+    while (true) {
+      sockaddr_in peer{};
+      socklen_t length = sizeof(peer);
+      int fd = ::accept4(worker.tcp.get(), reinterpret_cast<sockaddr *>(&peer),
+                         &length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      // accept4, plus epoll_ctl when a connection was accepted.
+      count(worker.syscalls, fd < 0 ? 1 : 2);
+      if (fd < 0) {
+        return;
+      }
+
+      worker.streams.try_emplace(
+          fd, Connection{detail::FileDescriptor{fd}, source_id(peer), {}, {}});
+
+      if (!watch(worker, fd)) {
+        worker.streams.erase(fd);
+        continue;
+      }
+
+      count(worker.connections);
+    }
+  }
+
+  /**
+   * @brief Reads pending bytes from a connection, closing it on end of
+   * stream or error.
+   * @param worker The worker.
+   * @param fd The connected socket.
+   * @return  void    This function does not return a value.
+   */
+  void receive_stream(Worker &worker, int fd) {
+    auto it = worker.streams.find(fd);
+    if (it == worker.streams.end()) {
+      return;
+    }
+
+    Connection &connection = it->second;
+    auto dispatch_line = [&](std::string_view line) {
+      dispatch(worker, connection.source, connection.context, line);
+    };
+
+    ssize_t size = ::read(fd, worker.read_buffer.data(), READ_SIZE);
+    count(worker.syscalls);
+
+    if (size > 0) {
+      count(worker.bytes, static_cast<std::size_t>(size));
+      connection.framer.push(
+          {worker.read_buffer.data(), static_cast<std::size_t>(size)},
+          dispatch_line);
+      return;
+    }
+
+    if (size < 0 && (errno == EAGAIN || errno == EINTR)) {
+      return;
+    }
+
+    connection.framer.flush(dispatch_line);
+    worker.streams.erase(it);
+  }
+
+  /**
+   * @brief Parses a sentence and passes it to the handler.
+   * @param worker The worker.
+   * @param source The source identifier.
+   * @param context The parse state of the source.
+   * @param line The raw sentence.
+   * @return  void    This function does not return a value.
+   */
+  void dispatch(Worker &worker, std::uint64_t source, ParseContext &context,
+                std::string_view line) {
+    auto sample = parse(line, context);
+
+    if (!sample) {
+      count(worker.errors);
+      return;
+    }
+
+    handler_(source, line, *sample);
+    count(worker.sentences);
+  }
+
+  ServerOptions options_;                        ///< Server configuration.
+  Handler handler_;                              ///< Sentence callback.
+  detail::FileDescriptor stop_event_;            ///< Wakes workers to stop.
+  std::vector<std::unique_ptr<Worker>> workers_; ///< Per-thread state.
+  std::vector<std::jthread> threads_;            ///< Worker threads.
+  std::uint16_t port_{0};                        ///< Bound port.
+};
+} // namespace gps_lib
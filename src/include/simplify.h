@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+
+#include "detail/geodesy.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Simplifies a track online, emitting only the fixes needed to keep
+ * every dropped fix within a distance tolerance of the output polyline.
+ *
+ * The simplifier keeps the last emitted fix as an anchor and the offsets of
+ * the fixes seen since then. A new fix is accepted while the segment from the
+ * anchor to it passes within the tolerance of every buffered fix; otherwise the
+ * previous fix is emitted and becomes the new anchor. This is the opening
+ * window form of Douglas-Peucker, so memory is bounded by Capacity and a
+ * stationary receiver collapses into a single vertex.
+ *
+ * @tparam Capacity Maximum number of fixes buffered between two vertices.
+ */
+template <std::size_t Capacity = 256> class TrackSimplifier {
+  static_assert(Capacity > 0, "TrackSimplifier needs room for one fix");
+
+public:
+  /**
+   * @brief Constructs a track simplifier.
+   * @param tolerance Maximum distance in meters between a dropped fix and the
+   * simplified polyline.
+   */
+  explicit TrackSimplifier(double tolerance) : tolerance_{tolerance} {}
+
+  /**
+   * @brief Consumes the next fix of the track.
+   * @param fix The fix to consume.
+   * @param emit Callback invoked with every vertex of the simplified track.
+   * @return  void    This function does not return a value.
+   */
+  template <std::invocable<const Fix &> Emit>
+  void push(const Fix &fix, Emit &&emit) {
+    if (!anchor_) {
+      anchor_ = fix;
+      emit(fix);
+      return;
+    }
+
+    detail::Offset offset = offset_from_anchor(fix);
+
+    if (size_ == Capacity || !covers(offset)) {
+      emit(*last_);
+      anchor_ = *last_;
+      size_ = 0;
+      offset = offset_from_anchor(fix);
+    }
+
+    offsets_[size_++] = offset;
+    last_ = fix;
+  }
+
+  /**
+   * @brief Emits the pending end of the track and resets the simplifier.
+   * @param emit Callback invoked with the last vertex, if any is pending.
+   * @return  void    This function does not return a value.
+   */
+  template <std::invocable<const Fix &> Emit> void flush(Emit &&emit) {
+    if (size_ > 0) {
+      emit(*last_);
+    }
+
+    anchor_.reset();
+    last_.reset();
+    size_ = 0;
+  }
+
+private:
+  /**
+   * @brief Projects a fix onto the tangent plane of the anchor.
+   * @param fix The fix to project.
+   * @return  detail::Offset  The offset from the anchor in meters.
+   */
+  detail::Offset offset_from_anchor(const Fix &fix) const {
+    return detail::local_offset(anchor_->latitude, anchor_->longitude,
+                                fix.latitude, fix.longitude);
+  }
+
+  /**
+   * @brief Checks whether the segment from the anchor to a point stays within
+   * the tolerance of every buffered fix.
+   * @param end The end of the segment relative to the anchor.
+   * @return  bool    True if no buffered fix is farther than the tolerance.
+   */
+  bool covers(detail::Offset end) const {
+    double length = end.east * end.east + end.north * end.north;
+    double limit = tolerance_ * tolerance_;
+
+    for (std::size_t i = 0; i < size_; ++i) {
+      const detail::Offset &point = offsets_[i];
+      double t = 0.0;
+      if (length > 0.0) {
+        t = std::clamp(
+            (point.east * end.east + point.north * end.north) / length, 0.0,
+            1.0);
+      }
+      double east = point.east - t * end.east;
+      double north = point.north - t * end.north;
+      if (east * east + north * north > limit) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  double tolerance_;                               ///< Tolerance in meters.
+  std::optional<Fix> anchor_;                      ///< Last emitted fix.
+  std::optional<Fix> last_;                        ///< Most recent fix.
+  std::array<detail::Offset, Capacity> offsets_{}; ///< Buffered offsets.
+  std::size_t size_{0};                            ///< Buffered fix count.
+};
+} // namespace gps_lib
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <expected>
+#include <generator>
+#include <istream>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <variant>
+
+#include "parse.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Lazily parses the sentences of a stream, one per line.
+ *
+ * Lines are read only as the generator is advanced, into a single buffer
+ * reused for the whole stream, and the parse state is carried from line to
+ * line, so no intermediate container is built. Invalid lines are yielded as
+ * errors rather than skipped, so callers decide whether to count or ignore
+ * them.
+ *
+ * @code
+ * for (const RMC &rmc : parse_stream(file) | filter_type<RMC>) { ... }
+ * @endcode
+ *
+ * @param input The stream to read. It must outlive the generator.
+ * @return  std::generator<std::expected<Sample, ParseError>>  The parsed
+ * sentences, in stream order.
+ */
+inline std::generator<std::expected<Sample, ParseError>>
+parse_stream(std::istream &input) {
+  ParseContext context;
+  std::string line;
+
+  while (std::getline(input, line)) {
+    if (line.ends_with('\r')) {
+      line.pop_back();
+    }
+    if (line.empty()) {
+      continue;
+    }
+
+    co_yield parse(line, context);
+  }
+}
+
+/**
+ * @brief Lazily parses the sentences read from a file descriptor, such as a
+ * pipe, a serial port or a connected socket.
+ *
+ * The descriptor is read in blocks into one buffer and sentences are parsed
+ * straight from it, so nothing is copied except the partial line moved to
+ * the front before the next read. A read blocks only when the generator is
+ * advanced past the lines already buffered. The generator ends at end of
+ * stream or on a read error; lines longer than the buffer are dropped.
+ *
+ * @param fd The descriptor to read. It is not closed.
+ * @return  std::generator<std::expected<Sample, ParseError>>  The parsed
+ * sentences, in stream order.
+ */
+inline std::generator<std::expected<Sample, ParseError>> parse_stream(int fd) {
+  ParseContext context;
+  std::array<char, 4096> buffer;
+  std::size_t begin = 0;
+  std::size_t end = 0;
+  bool open = true;
+
+  while (open || begin != end) {
+    std::string_view pending{buffer.data() + begin, end - begin};
+    std::size_t newline = pending.find('\n');
+
+    if (newline == std::string_view::npos && open) {
+      std::copy(buffer.begin() + begin, buffer.begin() + end, buffer.begin());
+      end = end - begin == buffer.size() ? 0 : end - begin;
+      begin = 0;
+
+      ssize_t size = ::read(fd, buffer.data() + end, buffer.size() - end);
+      if (size < 0 && errno == EINTR) {
+        continue;
+      }
+
+      open = size > 0;
+      end += open ? static_cast<std::size_t>(size) : 0;
+      continue;
+    }
+
+    // At end of stream the last line may lack its line feed.
+    std::string_view line = pending.substr(0, newline);
+    begin += newline == std::string_view::npos ? pending.size() : newline + 1;
+
+    if (line.ends_with('\r')) {
+      line.remove_suffix(1);
+    }
+    if (!line.empty()) {
+      co_yield parse(line, context);
+    }
+  }
+}
+
+/**
+ * @brief Range adaptor that keeps the parsed sentences of one type.
+ *
+ * Applied to a range of std::expected<Sample, ParseError>, it drops errors
+ * and other sentence types and yields references to the sentences of type T,
+ * valid until the range is advanced.
+ *
+ * @tparam T The sentence type, e.g. RMC or GGA.
+ */
+template <typename T>
+inline constexpr auto filter_type =
+    std::views::filter([](const std::expected<Sample, ParseError> &result) {
+      return result && std::holds_alternative<T>(*result);
+    }) |
+    std::views::transform(
+        [](const std::expected<Sample, ParseError> &result) -> const T & {
+          return std::get<T>(*result);
+        });
+} // namespace gps_lib
@@ -1,11 +1,11 @@
 #pragma once
 
-#include <iomanip>
-#include <sstream>
+#include <array>
+#include <cstddef>
 #include <string_view>
-#include <vector>
 
-#include "detail/split.h"
+#include "detail/trace.h"
+#include "metrics.h"
 
 namespace gps_lib {
 /**
@@ -14,13 +14,22 @@ namespace gps_lib {
  * @return  bool    True if the sample is valid, false otherwise.
  */
 inline bool is_valid_sample(const std::string_view sample) {
-  std::vector<std::string_view> tokens{detail::split(sample, '*')};
+  GPS_LIB_TRACE_SCOPE("is_valid_sample");
 
-  if (tokens.size() < 2 || tokens.at(1).empty()) {
+  std::size_t separator = sample.find('*');
+
+  if (separator == std::string_view::npos) {
+    return false;
+  }
+
+  std::string_view checksum = sample.substr(separator + 1);
+  checksum = checksum.substr(0, checksum.find('*'));
+
+  if (checksum.empty()) {
     return false;
   }
 
-  std::string_view sentence = tokens.at(0);
+  std::string_view sentence = sample.substr(0, separator);
 
   if (sentence.starts_with('$')) {
     sentence.remove_prefix(1);
@@ -32,11 +41,24 @@ inline bool is_valid_sample(const std::string_view sample) {
     check ^= static_cast<unsigned char>(c);
   }
 
-  std::stringstream hex_check;
+  constexpr std::string_view HEX_DIGITS{"0123456789ABCDEF"};
+  std::array<char, 2> hex_check{HEX_DIGITS[check >> 4],
+                                HEX_DIGITS[check & 15]};
 
-  hex_check << std::uppercase << std::hex << std::setfill('0') << std::setw(2)
-            << static_cast<int>(check);
+  if (checksum != std::string_view{hex_check.data(), hex_check.size()}) {
+#ifdef GPS_LIB_METRICS
+    detail::record_checksum_failure();
+#endif
+    return false;
+  }
 
-  return hex_check.str() == tokens.at(1);
+  return true;
 }
+
+/**
+ * @brief Helper to build a visitor or sink from a set of lambdas.
+ */
+template <typename... Ts> struct overloaded : Ts... {
+  using Ts::operator()...;
+};
 } // namespace gps_lib
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "detail/trace.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+namespace detail {
+/**
+ * @brief Identifies a binary trace file and its layout version.
+ */
+constexpr std::array<char, 8> TRACE_MAGIC{'G', 'P', 'S', 'T',
+                                          'R', 'A', 'C', '1'};
+
+/**
+ * @brief Writes a value in native byte order.
+ * @param out The stream to write to.
+ * @param value The value.
+ * @return  void    This function does not return a value.
+ */
+template <typename T> void write_raw(std::ostream &out, const T &value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+/**
+ * @brief Reads a value in native byte order.
+ * @param in The stream to read from.
+ * @param value Receives the value.
+ * @return  bool    True if the value was read.
+ */
+template <typename T> bool read_raw(std::istream &in, T &value) {
+  return static_cast<bool>(
+      in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+/**
+ * @brief Appends a string to JSON output, escaping it.
+ * @param out The stream to write to.
+ * @param text The string.
+ * @return  void    This function does not return a value.
+ */
+inline void write_json_string(std::ostream &out, std::string_view text) {
+  out << '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\';
+    }
+    out << c;
+  }
+  out << '"';
+}
+} // namespace detail
+
+/**
+ * @brief Dumps the spans recorded by GPS_LIB_TRACE_SCOPE to a binary file.
+ *
+ * The file holds the span names followed by fixed-size events, so dumping
+ * is a straight copy of the rings; trace_to_chrome_json() turns it into
+ * something viewable offline. Call it while the traced threads are idle, as
+ * spans recorded during the dump may be torn. The rings of threads that have
+ * exited are emptied by the dump and handed to new threads.
+ *
+ * @param path The output file path.
+ * @return  bool    True if the file was written successfully, false
+ * otherwise.
+ */
+inline bool save_trace(const std::filesystem::path &path) {
+  std::ofstream out{path, std::ios::binary | std::ios::trunc};
+  if (!out) {
+    return false;
+  }
+
+  detail::TraceRegistry::instance().visit([&](const auto &names,
+                                              const auto &rings) {
+    out.write(detail::TRACE_MAGIC.data(), detail::TRACE_MAGIC.size());
+
+    detail::write_raw(out, static_cast<std::uint32_t>(names.size()));
+    for (const std::string &name : names) {
+      detail::write_raw(out, static_cast<std::uint16_t>(name.size()));
+      out.write(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+
+    std::uint64_t total = 0;
+    for (const auto &ring : rings) {
+      total += std::min<std::uint64_t>(
+          ring->head.load(std::memory_order_acquire),
+          detail::TraceRing::CAPACITY);
+    }
+    detail::write_raw(out, total);
+
+    for (const auto &ring : rings) {
+      std::uint64_t head = ring->head.load(std::memory_order_acquire);
+      std::uint64_t count =
+          std::min<std::uint64_t>(head, detail::TraceRing::CAPACITY);
+
+      for (std::uint64_t i = head - count; i != head; ++i) {
+        detail::write_raw(out,
+                          ring->events[i % detail::TraceRing::CAPACITY]);
+      }
+    }
+  });
+
+  return static_cast<bool>(out);
+}
+
+/**
+ * @brief Converts a binary trace written by save_trace() into the Chrome
+ * trace event format, viewable in Perfetto or chrome://tracing.
+ * @param binary The binary trace file.
+ * @param json The output JSON file path.
+ * @return  bool    True if the trace was converted, false if a file could
+ * not be opened or the binary trace is malformed.
+ */
+inline bool trace_to_chrome_json(const std::filesystem::path &binary,
+                                 const std::filesystem::path &json) {
+  std::ifstream in{binary, std::ios::binary};
+  std::array<char, detail::TRACE_MAGIC.size()> magic{};
+
+  if (!in.read(magic.data(), magic.size()) || magic != detail::TRACE_MAGIC) {
+    return false;
+  }
+
+  std::uint32_t name_count = 0;
+  if (!detail::read_raw(in, name_count)) {
+    return false;
+  }
+
+  std::vector<std::string> names(name_count);
+  for (std::string &name : names) {
+    std::uint16_t size = 0;
+    if (!detail::read_raw(in, size)) {
+      return false;
+    }
+    name.resize(size);
+    if (!in.read(name.data(), size)) {
+      return false;
+    }
+  }
+
+  std::uint64_t event_count = 0;
+  if (!detail::read_raw(in, event_count)) {
+    return false;
+  }
+
+  std::vector<detail::TraceEvent> events;
+  events.reserve(static_cast<std::size_t>(
+      std::min<std::uint64_t>(event_count, 1 << 20)));
+
+  for (std::uint64_t i = 0; i < event_count; ++i) {
+    detail::TraceEvent event;
+    if (!detail::read_raw(in, event) || event.name >= names.size()) {
+      return false;
+    }
+    events.push_back(event);
+  }
+
+  std::uint64_t origin = std::numeric_limits<std::uint64_t>::max();
+  for (const detail::TraceEvent &event : events) {
+    origin = std::min(origin, event.start);
+  }
+
+  std::ofstream out{json, std::ios::trunc};
+  if (!out) {
+    return false;
+  }
+
+  // Timestamps are in microseconds; three decimals keep ns resolution.
+  auto micros = [&](std::uint64_t nanoseconds) {
+    std::array<char, 4> fraction{};
+    std::uint64_t rest = nanoseconds % 1000;
+    for (std::size_t i = 3; i-- > 0; rest /= 10) {
+      fraction[i] = static_cast<char>('0' + rest % 10);
+    }
+    out << nanoseconds / 1000 << '.' << fraction.data();
+  };
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  for (std::size_t i = 0; i < events.size(); ++i) {
+    const detail::TraceEvent &event = events[i];
+
+    out << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+    detail::write_json_string(out, names[event.name]);
+    out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread << ",\"ts\":";
+    micros(event.start - origin);
+    out << ",\"dur\":";
+    micros(event.duration);
+    out << '}';
+  }
+  out << "\n]}\n";
+
+  return static_cast<bool>(out);
+}
+} // namespace gps_lib
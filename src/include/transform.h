@@ -0,0 +1,449 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "detail/geodesy.h"
+#include "detail/parse_number.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief This constant represents the WGS84 semi-major axis in meters.
+ */
+constexpr double WGS84_A{6378137.0};
+
+/**
+ * @brief This constant represents the WGS84 flattening.
+ */
+constexpr double WGS84_F{1.0 / 298.257223563};
+
+/**
+ * @brief This constant represents the WGS84 first eccentricity squared.
+ */
+constexpr double WGS84_E2{WGS84_F * (2.0 - WGS84_F)};
+
+/**
+ * @brief Batch of geodetic positions stored as separate arrays.
+ *
+ * Keeping each coordinate in its own contiguous array lets the transform
+ * loops below run without gathers, so the compiler can vectorize them.
+ */
+struct GeodeticBatch {
+  std::vector<double> latitude;  ///< Latitudes in decimal degrees.
+  std::vector<double> longitude; ///< Longitudes in decimal degrees.
+  std::vector<double> height;    ///< Heights above the ellipsoid in meters.
+
+  /**
+   * @brief Appends the position of a GGA sentence.
+   *
+   * The ellipsoidal height is the altitude above mean sea level plus the
+   * geoidal separation; missing fields count as zero.
+   *
+   * @param gga The GGA sentence to append.
+   * @return  void    This function does not return a value.
+   */
+  void push_back(const GGA &gga) {
+    double altitude = detail::parse_number(gga.altitude).value_or(0.0);
+    double separation =
+        detail::parse_number(gga.geoidal_separation).value_or(0.0);
+    push_back(gga.latitude.value, gga.longitude.value, altitude + separation);
+  }
+
+  /**
+   * @brief Appends a position.
+   * @param lat The latitude in decimal degrees.
+   * @param lon The longitude in decimal degrees.
+   * @param h The height above the ellipsoid in meters.
+   * @return  void    This function does not return a value.
+   */
+  void push_back(double lat, double lon, double h = 0.0) {
+    latitude.push_back(lat);
+    longitude.push_back(lon);
+    height.push_back(h);
+  }
+
+  /**
+   * @brief Returns the number of positions in the batch.
+   * @return  std::size_t     The number of positions.
+   */
+  std::size_t size() const { return latitude.size(); }
+};
+
+/**
+ * @brief Converts geodetic positions to Earth-centered Earth-fixed
+ * coordinates.
+ * @param latitude Latitudes in decimal degrees.
+ * @param longitude Longitudes in decimal degrees.
+ * @param height Heights above the ellipsoid in meters.
+ * @param x Output ECEF X coordinates in meters.
+ * @param y Output ECEF Y coordinates in meters.
+ * @param z Output ECEF Z coordinates in meters.
+ * @return  void    This function does not return a value.
+ * @note All spans must have the same size.
+ */
+inline void geodetic_to_ecef(std::span<const double> latitude,
+                             std::span<const double> longitude,
+                             std::span<const double> height,
+                             std::span<double> x, std::span<double> y,
+                             std::span<double> z) {
+  for (std::size_t i = 0; i < latitude.size(); ++i) {
+    double sin_latitude = std::sin(latitude[i] * detail::DEGTORAD);
+    double cos_latitude = std::cos(latitude[i] * detail::DEGTORAD);
+    double sin_longitude = std::sin(longitude[i] * detail::DEGTORAD);
+    double cos_longitude = std::cos(longitude[i] * detail::DEGTORAD);
+    double n =
+        WGS84_A / std::sqrt(1.0 - WGS84_E2 * sin_latitude * sin_latitude);
+
+    x[i] = (n + height[i]) * cos_latitude * cos_longitude;
+    y[i] = (n + height[i]) * cos_latitude * sin_longitude;
+    z[i] = (n * (1.0 - WGS84_E2) + height[i]) * sin_latitude;
+  }
+}
+
+/**
+ * @brief Converts Earth-centered Earth-fixed coordinates to geodetic
+ * positions with Heikkinen's closed-form solution.
+ * @param x ECEF X coordinates in meters.
+ * @param y ECEF Y coordinates in meters.
+ * @param z ECEF Z coordinates in meters.
+ * @param latitude Output latitudes in decimal degrees.
+ * @param longitude Output longitudes in decimal degrees.
+ * @param height Output heights above the ellipsoid in meters.
+ * @return  void    This function does not return a value.
+ * @note All spans must have the same size. Points near the Earth's center
+ * are not supported.
+ */
+inline void ecef_to_geodetic(std::span<const double> x,
+                             std::span<const double> y,
+                             std::span<const double> z,
+                             std::span<double> latitude,
+                             std::span<double> longitude,
+                             std::span<double> height) {
+  constexpr double a2 = WGS84_A * WGS84_A;
+  constexpr double b = WGS84_A * (1.0 - WGS84_F);
+  constexpr double b2 = b * b;
+  constexpr double e4 = WGS84_E2 * WGS84_E2;
+  constexpr double ep2 = (a2 - b2) / b2;
+
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    double z2 = z[i] * z[i];
+    double p2 = x[i] * x[i] + y[i] * y[i];
+    double p = std::sqrt(p2);
+    double f = 54.0 * b2 * z2;
+    double g = p2 + (1.0 - WGS84_E2) * z2 - WGS84_E2 * (a2 - b2);
+    double c = e4 * f * p2 / (g * g * g);
+    double s = std::cbrt(1.0 + c + std::sqrt(c * c + 2.0 * c));
+    double k = s + 1.0 + 1.0 / s;
+    double big_p = f / (3.0 * k * k * g * g);
+    double q = std::sqrt(1.0 + 2.0 * e4 * big_p);
+    double r0 = -big_p * WGS84_E2 * p / (1.0 + q) +
+                std::sqrt(std::max(
+                    a2 / 2.0 * (1.0 + 1.0 / q) -
+                        big_p * (1.0 - WGS84_E2) * z2 / (q * (1.0 + q)) -
+                        big_p * p2 / 2.0,
+                    0.0));
+    double d = p - WGS84_E2 * r0;
+    double u = std::sqrt(d * d + z2);
+    double v = std::sqrt(d * d + (1.0 - WGS84_E2) * z2);
+    double z0 = b2 * z[i] / (WGS84_A * v);
+
+    height[i] = u * (1.0 - b2 / (WGS84_A * v));
+    latitude[i] = std::atan2(z[i] + ep2 * z0, p) / detail::DEGTORAD;
+    longitude[i] = std::atan2(y[i], x[i]) / detail::DEGTORAD;
+  }
+}
+
+/**
+ * @brief Local east-north-up frame anchored at a reference position.
+ *
+ * The reference point in ECEF and the rotation terms are computed once, so
+ * converting a batch costs only a subtraction and a 3x3 rotation per point.
+ */
+class EnuFrame {
+public:
+  /**
+   * @brief Constructs a frame at a reference position.
+   * @param latitude The reference latitude in decimal degrees.
+   * @param longitude The reference longitude in decimal degrees.
+   * @param height The reference height above the ellipsoid in meters.
+   */
+  EnuFrame(double latitude, double longitude, double height = 0.0)
+      : sin_latitude_{std::sin(latitude * detail::DEGTORAD)},
+        cos_latitude_{std::cos(latitude * detail::DEGTORAD)},
+        sin_longitude_{std::sin(longitude * detail::DEGTORAD)},
+        cos_longitude_{std::cos(longitude * detail::DEGTORAD)} {
+    geodetic_to_ecef(std::span{&latitude, 1}, std::span{&longitude, 1},
+                     std::span{&height, 1}, std::span{&x0_, 1},
+                     std::span{&y0_, 1}, std::span{&z0_, 1});
+  }
+
+  /**
+   * @brief Converts ECEF coordinates to local east-north-up offsets.
+   * @param x ECEF X coordinates in meters.
+   * @param y ECEF Y coordinates in meters.
+   * @param z ECEF Z coordinates in meters.
+   * @param east Output east offsets in meters.
+   * @param north Output north offsets in meters.
+   * @param up Output up offsets in meters.
+   * @return  void    This function does not return a value.
+   * @note All spans must have the same size.
+   */
+  void from_ecef(std::span<const double> x, std::span<const double> y,
+                 std::span<const double> z, std::span<double> east,
+                 std::span<double> north, std::span<double> up) const {
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      double dx = x[i] - x0_;
+      double dy = y[i] - y0_;
+      double dz = z[i] - z0_;
+      double t = cos_longitude_ * dx + sin_longitude_ * dy;
+
+      east[i] = -sin_longitude_ * dx + cos_longitude_ * dy;
+      north[i] = -sin_latitude_ * t + cos_latitude_ * dz;
+      up[i] = cos_latitude_ * t + sin_latitude_ * dz;
+    }
+  }
+
+  /**
+   * @brief Converts local east-north-up offsets to ECEF coordinates.
+   * @param east East offsets in meters.
+   * @param north North offsets in meters.
+   * @param up Up offsets in meters.
+   * @param x Output ECEF X coordinates in meters.
+   * @param y Output ECEF Y coordinates in meters.
+   * @param z Output ECEF Z coordinates in meters.
+   * @return  void    This function does not return a value.
+   * @note All spans must have the same size.
+   */
+  void to_ecef(std::span<const double> east, std::span<const double> north,
+               std::span<const double> up, std::span<double> x,
+               std::span<double> y, std::span<double> z) const {
+    for (std::size_t i = 0; i < east.size(); ++i) {
+      double t = -sin_latitude_ * north[i] + cos_latitude_ * up[i];
+
+      x[i] = x0_ - sin_longitude_ * east[i] + cos_longitude_ * t;
+      y[i] = y0_ + cos_longitude_ * east[i] + sin_longitude_ * t;
+      z[i] = z0_ + cos_latitude_ * north[i] + sin_latitude_ * up[i];
+    }
+  }
+
+  /**
+   * @brief Converts geodetic positions to local east-north-up offsets.
+   * @param batch The positions to convert.
+   * @param east Output east offsets in meters.
+   * @param north Output north offsets in meters.
+   * @param up Output up offsets in meters.
+   * @return  void    This function does not return a value.
+   * @note The output spans must have the size of the batch.
+   */
+  void from_geodetic(const GeodeticBatch &batch, std::span<double> east,
+                     std::span<double> north, std::span<double> up) const {
+    // Reuse the outputs as ECEF scratch space; from_ecef() reads each point
+    // before writing it.
+    geodetic_to_ecef(batch.latitude, batch.longitude, batch.height, east,
+                     north, up);
+    from_ecef(east, north, up, east, north, up);
+  }
+
+private:
+  double sin_latitude_;  ///< Sine of the reference latitude.
+  double cos_latitude_;  ///< Cosine of the reference latitude.
+  double sin_longitude_; ///< Sine of the reference longitude.
+  double cos_longitude_; ///< Cosine of the reference longitude.
+  double x0_{};          ///< Reference ECEF X in meters.
+  double y0_{};          ///< Reference ECEF Y in meters.
+  double z0_{};          ///< Reference ECEF Z in meters.
+};
+
+/**
+ * @brief Transverse Mercator projection constants of one UTM zone.
+ *
+ * Uses the Krüger series to third order in the third flattening, which keeps
+ * errors below a millimeter inside the zone. All series coefficients are
+ * computed once per zone, and each series costs one sin, cos and exp per
+ * point.
+ */
+class UtmZone {
+public:
+  /**
+   * @brief Constructs the constants of a UTM zone.
+   * @param zone The zone number, from 1 to 60.
+   * @param north True for the northern hemisphere.
+   */
+  UtmZone(int zone, bool north)
+      : zone_{zone}, north_{north},
+        central_meridian_{(zone * 6.0 - 183.0) * detail::DEGTORAD},
+        false_northing_{north ? 0.0 : 10000000.0} {
+    constexpr double n = WGS84_F / (2.0 - WGS84_F);
+    constexpr double n2 = n * n;
+    constexpr double n3 = n2 * n;
+
+    scale_ = 0.9996 * WGS84_A / (1.0 + n) * (1.0 + n2 / 4.0 + n2 * n2 / 64.0);
+    alpha_[0] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0;
+    alpha_[1] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0;
+    alpha_[2] = 61.0 * n3 / 240.0;
+    beta_[0] = n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0;
+    beta_[1] = n2 / 48.0 + n3 / 15.0;
+    beta_[2] = 17.0 * n3 / 480.0;
+    delta_[0] = 2.0 * n - 2.0 * n2 / 3.0 - 2.0 * n3;
+    delta_[1] = 7.0 * n2 / 3.0 - 8.0 * n3 / 5.0;
+    delta_[2] = 56.0 * n3 / 15.0;
+    conformal_ = 2.0 * std::sqrt(n) / (1.0 + n);
+  }
+
+  /**
+   * @brief Returns the zone that contains a position, including the Norway
+   * and Svalbard exceptions.
+   * @param latitude The latitude in decimal degrees.
+   * @param longitude The longitude in decimal degrees.
+   * @return  UtmZone The zone of the position.
+   */
+  static UtmZone containing(double latitude, double longitude) {
+    double wrapped = std::remainder(longitude, 360.0);
+    int zone =
+        std::clamp(static_cast<int>((wrapped + 180.0) / 6.0) + 1, 1, 60);
+
+    if (latitude >= 56.0 && latitude < 64.0 && wrapped >= 3.0 &&
+        wrapped < 12.0) {
+      zone = 32;
+    } else if (latitude >= 72.0 && latitude < 84.0 && wrapped >= 0.0 &&
+               wrapped < 42.0) {
+      // Svalbard only uses the odd zones 31 to 37.
+      zone = wrapped < 9.0    ? 31
+             : wrapped < 21.0 ? 33
+             : wrapped < 33.0 ? 35
+                              : 37;
+    }
+
+    return UtmZone{zone, latitude >= 0.0};
+  }
+
+  /**
+   * @brief Projects geodetic positions onto the zone.
+   * @param latitude Latitudes in decimal degrees.
+   * @param longitude Longitudes in decimal degrees.
+   * @param easting Output eastings in meters.
+   * @param northing Output northings in meters.
+   * @return  void    This function does not return a value.
+   * @note All spans must have the same size.
+   */
+  void forward(std::span<const double> latitude,
+               std::span<const double> longitude, std::span<double> easting,
+               std::span<double> northing) const {
+    for (std::size_t i = 0; i < latitude.size(); ++i) {
+      double sin_latitude = std::sin(latitude[i] * detail::DEGTORAD);
+      double delta_longitude =
+          longitude[i] * detail::DEGTORAD - central_meridian_;
+      double t = std::sinh(std::atanh(sin_latitude) -
+                           conformal_ * std::atanh(conformal_ * sin_latitude));
+      double xi_prime = std::atan2(t, std::cos(delta_longitude));
+      double eta_prime =
+          std::atanh(std::sin(delta_longitude) / std::sqrt(1.0 + t * t));
+      Series terms = series(alpha_, xi_prime, eta_prime);
+
+      easting[i] = 500000.0 + scale_ * (eta_prime + terms.eta);
+      northing[i] = false_northing_ + scale_ * (xi_prime + terms.xi);
+    }
+  }
+
+  /**
+   * @brief Converts projected coordinates of the zone back to geodetic
+   * positions.
+   * @param easting Eastings in meters.
+   * @param northing Northings in meters.
+   * @param latitude Output latitudes in decimal degrees.
+   * @param longitude Output longitudes in decimal degrees.
+   * @return  void    This function does not return a value.
+   * @note All spans must have the same size.
+   */
+  void inverse(std::span<const double> easting,
+               std::span<const double> northing, std::span<double> latitude,
+               std::span<double> longitude) const {
+    for (std::size_t i = 0; i < easting.size(); ++i) {
+      double xi = (northing[i] - false_northing_) / scale_;
+      double eta = (easting[i] - 500000.0) / scale_;
+      Series terms = series(beta_, xi, eta);
+      double xi_prime = xi - terms.xi;
+      double eta_prime = eta - terms.eta;
+      double chi = std::asin(std::sin(xi_prime) / std::cosh(eta_prime));
+      double phi = chi + series(delta_, chi, 0.0).xi;
+
+      latitude[i] = phi / detail::DEGTORAD;
+      longitude[i] = (central_meridian_ + std::atan2(std::sinh(eta_prime),
+                                                     std::cos(xi_prime))) /
+                     detail::DEGTORAD;
+    }
+  }
+
+  /**
+   * @brief Returns the zone number.
+   * @return  int     The zone number, from 1 to 60.
+   */
+  int zone() const { return zone_; }
+
+  /**
+   * @brief Returns the hemisphere of the zone.
+   * @return  bool    True for the northern hemisphere.
+   */
+  bool north() const { return north_; }
+
+private:
+  /**
+   * @brief This struct holds the two sums of a Krüger series.
+   */
+  struct Series {
+    double xi;  ///< Sum of c[j] sin(2jx) cosh(2jy).
+    double eta; ///< Sum of c[j] cos(2jx) sinh(2jy).
+  };
+
+  /**
+   * @brief Evaluates a third-order Krüger series.
+   *
+   * The multiple angles are built from a single sin, cos and exp with the
+   * angle addition identities, instead of calling them for every order.
+   *
+   * @param c The series coefficients.
+   * @param x The angle argument.
+   * @param y The hyperbolic argument.
+   * @return  Series  The two sums of the series.
+   */
+  static Series series(const std::array<double, 3> &c, double x, double y) {
+    double s1 = std::sin(2.0 * x);
+    double c1 = std::cos(2.0 * x);
+    double e = std::exp(2.0 * y);
+    double sh1 = (e - 1.0 / e) / 2.0;
+    double ch1 = (e + 1.0 / e) / 2.0;
+
+    double s2 = 2.0 * s1 * c1;
+    double c2 = c1 * c1 - s1 * s1;
+    double s3 = s2 * c1 + c2 * s1;
+    double c3 = c2 * c1 - s2 * s1;
+    double sh2 = 2.0 * sh1 * ch1;
+    double ch2 = ch1 * ch1 + sh1 * sh1;
+    double sh3 = sh2 * ch1 + ch2 * sh1;
+    double ch3 = ch2 * ch1 + sh2 * sh1;
+
+    return {c[0] * s1 * ch1 + c[1] * s2 * ch2 + c[2] * s3 * ch3,
+            c[0] * c1 * sh1 + c[1] * c2 * sh2 + c[2] * c3 * sh3};
+  }
+
+  int zone_;                      ///< Zone number.
+  bool north_;                    ///< Northern hemisphere.
+  double central_meridian_;       ///< Central meridian in radians.
+  double false_northing_;         ///< False northing in meters.
+  double scale_{};                ///< Scale factor times the rectifying radius.
+  double conformal_{};            ///< Conformal latitude coefficient.
+  std::array<double, 3> alpha_{}; ///< Forward series coefficients.
+  std::array<double, 3> beta_{};  ///< Inverse series coefficients.
+  std::array<double, 3> delta_{}; ///< Latitude series coefficients.
+};
+} // namespace gps_lib
@@ -1,9 +1,17 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#include "intern.h"
+
 /**
  * @namespace gps_lib
  * @brief A header-only C++ library for parsing and processing NMEA GPS
@@ -29,7 +37,12 @@ enum class TokensPerSentence {
   GSV = 4,  ///< Number of tokens for GSV sentence
   RMC = 12, ///< Number of tokens for RMC sentence
   VTG = 10, ///< Number of tokens for VTG sentence
-  ZDA = 7   ///< Number of tokens for ZDA sentence
+  ZDA = 7,  ///< Number of tokens for ZDA sentence
+  GST = 9,  ///< Number of tokens for GST sentence
+  GBS = 9,  ///< Number of tokens for GBS sentence
+  GNS = 13, ///< Number of tokens for GNS sentence
+  RMB = 14, ///< Number of tokens for RMB sentence
+  HDT = 3   ///< Number of tokens for HDT sentence
 };
 
 /**
@@ -44,12 +57,17 @@ constexpr double KNTOMS{0.514444444};
  */
 constexpr double KNTOKMH{1.85};
 
+/**
+ * @brief This alias represents a UTC instant with millisecond resolution.
+ */
+using Timestamp = std::chrono::sys_time<std::chrono::milliseconds>;
+
 /**
  * @brief Stores the latitude value in decimal degrees and direction ('N' or
  * 'S').
  */
 struct Latitude {
-  double value;   ///< Latitude in decimal degrees.
+  double value;   ///< Latitude in decimal degrees, negative south.
   char direction; ///< Direction of latitude ('N' or 'S').
 };
 
@@ -57,7 +75,7 @@ struct Latitude {
  * @brief This struct represents the longitude in a GPS coordinate.
  */
 struct Longitude {
-  double value;   ///< Longitude in decimal degrees.
+  double value;   ///< Longitude in decimal degrees, negative west.
   char direction; ///< Direction of longitude ('E' or 'W').
 };
 
@@ -66,18 +84,51 @@ struct Longitude {
  * sentence.
  */
 struct GGA {
-  std::string type;     ///< Type of the NMEA sentence (GGA).
-  std::string utc_time; ///< UTC time in the format HHMMSS.
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  GGA() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit GGA(const allocator_type &alloc)
+      : satellites_used{alloc}, hdop{alloc}, altitude{alloc},
+        geoidal_separation{alloc}, dgps{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  GGA(const GGA &other, const allocator_type &alloc) : GGA{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  GGA(GGA &&other, const allocator_type &alloc) : GGA{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPGGA".
+  Address type{.type = SentenceType::GGA};
+  Timestamp utc_time; ///< UTC time, dated from the last RMC or ZDA sentence.
   Latitude
       latitude; ///< Latitude in decimal degrees and direction ('N' or 'S').
   Longitude
       longitude; ///< Longitude in decimal degrees and direction ('E' or 'W').
-  std::string quality;            ///< GPS fix quality indicator.
-  std::string satellites_used;    ///< Number of satellites used for the fix.
-  std::string hdop;               ///< Horizontal dilution of precision.
-  std::string altitude;           ///< Altitude in meters.
-  std::string geoidal_separation; ///< Geoidal separation in meters.
-  std::string dgps;               ///< Differential GPS data.
+  char quality{};                   ///< GPS fix quality indicator.
+  std::pmr::string satellites_used; ///< Number of satellites used for the fix.
+  std::pmr::string hdop;            ///< Horizontal dilution of precision.
+  std::pmr::string altitude;        ///< Altitude in meters.
+  std::pmr::string geoidal_separation; ///< Geoidal separation in meters.
+  std::pmr::string dgps;               ///< Differential GPS data.
 };
 
 /**
@@ -85,13 +136,44 @@ struct GGA {
  * sentence.
  */
 struct GLL {
-  std::string type; ///< Type of the NMEA sentence (GLL).
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  GLL() = default;
+
+  /**
+   * @brief Constructs an empty sentence. GLL has no allocating members; the
+   * allocator is accepted so that containers construct it like the others.
+   */
+  explicit GLL(const allocator_type &) {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  GLL(const GLL &other, const allocator_type &alloc) : GLL{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  GLL(GLL &&other, const allocator_type &alloc) : GLL{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPGLL".
+  Address type{.type = SentenceType::GLL};
   Latitude
       latitude; ///< Latitude in decimal degrees and direction ('N' or 'S').
   Longitude
       longitude; ///< Longitude in decimal degrees and direction ('E' or 'W').
-  std::string utc_time; ///< UTC time in the format HHMMSS.
-  std::string status;   ///< Status of the fix ('A' for active, 'V' for void).
+  Timestamp utc_time; ///< UTC time, dated from the last RMC or ZDA sentence.
+  char status{};      ///< Status of the fix ('A' for active, 'V' for void).
 };
 
 /**
@@ -99,35 +181,134 @@ struct GLL {
  * sentence.
  */
 struct GSA {
-  std::string type;     ///< Type of the NMEA sentence (GSA).
-  std::string mode;     ///< Mode (1 = no fix, 2 = 2D fix, 3 = 3D fix).
-  std::string fix_type; ///< Fix type (0 = no fix, 1 = GPS fix, 2 = DGPS fix).
-  std::vector<std::string> satellites; ///< List of satellites used for the fix.
-  std::string pdop;                    ///< Position dilution of precision.
-  std::string hdop;                    ///< Horizontal dilution of precision.
-  std::string vdop;                    ///< Vertical dilution of precision.
-  std::string checksum;                ///< Checksum for the sentence.
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  GSA() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit GSA(const allocator_type &alloc)
+      : pdop{alloc}, hdop{alloc}, vdop{alloc}, checksum{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  GSA(const GSA &other, const allocator_type &alloc) : GSA{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  GSA(GSA &&other, const allocator_type &alloc) : GSA{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPGSA".
+  Address type{.type = SentenceType::GSA};
+  char mode{};     ///< Mode (1 = no fix, 2 = 2D fix, 3 = 3D fix).
+  char fix_type{}; ///< Fix type (0 = no fix, 1 = GPS fix, 2 = DGPS fix).
+  /// IDs of the satellites used for the fix, 0 for an empty slot.
+  std::array<std::uint16_t, 12> satellites{};
+  std::pmr::string pdop;     ///< Position dilution of precision.
+  std::pmr::string hdop;     ///< Horizontal dilution of precision.
+  std::pmr::string vdop;     ///< Vertical dilution of precision.
+  std::pmr::string checksum; ///< Checksum for the sentence.
 };
 
 /**
  * @brief This struct represents a satellite in the GPS system.
  */
 struct Satellite {
-  std::string id;        ///< Satellite ID.
-  std::string elevation; ///< Satellite elevation in degrees.
-  std::string azimuth;   ///< Satellite azimuth in degrees.
-  std::string snr;       ///< Satellite signal-to-noise ratio.
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  Satellite() = default;
+
+  /**
+   * @brief Constructs an empty satellite allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit Satellite(const allocator_type &alloc)
+      : elevation{alloc}, azimuth{alloc}, snr{alloc} {}
+
+  /**
+   * @brief Copies a satellite into storage from the given allocator.
+   * @param other The satellite to copy.
+   * @param alloc The allocator of the copy.
+   */
+  Satellite(const Satellite &other, const allocator_type &alloc)
+      : Satellite{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a satellite into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The satellite to move.
+   * @param alloc The allocator of the result.
+   */
+  Satellite(Satellite &&other, const allocator_type &alloc)
+      : Satellite{alloc} {
+    *this = std::move(other);
+  }
+
+  std::uint16_t id{};         ///< Satellite ID, 0 if empty.
+  std::pmr::string elevation; ///< Satellite elevation in degrees.
+  std::pmr::string azimuth;   ///< Satellite azimuth in degrees.
+  std::pmr::string snr;       ///< Satellite signal-to-noise ratio.
 };
 
 /**
  * @brief This struct represents the GSV (GNSS Satellites in View) sentence.
  */
 struct GSV {
-  std::string type;                  ///< Type of the NMEA sentence (GSV).
-  std::string number_of_messages;    ///< Total number of messages.
-  std::string sequence_number;       ///< Sequence number of this message.
-  std::string satellites_in_view;    ///< Number of satellites in view.
-  std::vector<Satellite> satellites; ///< List of satellites.
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  GSV() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit GSV(const allocator_type &alloc)
+      : number_of_messages{alloc}, sequence_number{alloc},
+        satellites_in_view{alloc}, satellites{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  GSV(const GSV &other, const allocator_type &alloc) : GSV{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  GSV(GSV &&other, const allocator_type &alloc) : GSV{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPGSV".
+  Address type{.type = SentenceType::GSV};
+  std::pmr::string number_of_messages;    ///< Total number of messages.
+  std::pmr::string sequence_number;       ///< Sequence number of this message.
+  std::pmr::string satellites_in_view;    ///< Number of satellites in view.
+  std::pmr::vector<Satellite> satellites; ///< List of satellites.
 };
 
 /**
@@ -135,17 +316,48 @@ struct GSV {
  * GPS/Transit Data) sentence.
  */
 struct RMC {
-  std::string type;     ///< Type of the NMEA sentence (RMC).
-  std::string utc_time; ///< UTC time in the format HHMMSS.
-  std::string status;   ///< Status of the fix ('A' for active, 'V' for void).
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  RMC() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit RMC(const allocator_type &alloc)
+      : speed{alloc}, course{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  RMC(const RMC &other, const allocator_type &alloc) : RMC{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  RMC(RMC &&other, const allocator_type &alloc) : RMC{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPRMC".
+  Address type{.type = SentenceType::RMC};
+  Timestamp utc_time; ///< UTC date and time.
+  char status{};      ///< Status of the fix ('A' for active, 'V' for void).
   Latitude
       latitude; ///< Latitude in decimal degrees and direction ('N' or 'S').
   Longitude
       longitude; ///< Longitude in decimal degrees and direction ('E' or 'W').
-  std::string speed;    ///< Speed over ground in knots.
-  std::string course;   ///< Course over ground in degrees.
-  std::string utc_date; ///< UTC date in the format DDMMYY.
-  std::string mode; ///< Mode (A = autonomous, D = differential, E = estimated).
+  std::pmr::string speed;  ///< Speed over ground in knots.
+  std::pmr::string course; ///< Course over ground in degrees.
+  char mode{}; ///< Mode (A = autonomous, D = differential, E = estimated).
 };
 
 /**
@@ -153,25 +365,334 @@ struct RMC {
  * sentence.
  */
 struct VTG {
-  std::string type;            ///< Type of the NMEA sentence (VTG).
-  std::string course;          ///< Course over ground in degrees.
-  std::string course_magnetic; ///< Magnetic course in degrees.
-  std::string speed_kn;        ///< Speed over ground in knots.
-  std::string speed_kh;        ///< Speed over ground in kilometers per hour.
-  std::string mode; ///< Mode (A = autonomous, D = differential, E = estimated).
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  VTG() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit VTG(const allocator_type &alloc)
+      : course{alloc}, course_magnetic{alloc}, speed_kn{alloc},
+        speed_kh{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  VTG(const VTG &other, const allocator_type &alloc) : VTG{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  VTG(VTG &&other, const allocator_type &alloc) : VTG{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPVTG".
+  Address type{.type = SentenceType::VTG};
+  std::pmr::string course;          ///< Course over ground in degrees.
+  std::pmr::string course_magnetic; ///< Magnetic course in degrees.
+  std::pmr::string speed_kn;        ///< Speed over ground in knots.
+  std::pmr::string speed_kh; ///< Speed over ground in kilometers per hour.
+  char mode{}; ///< Mode (A = autonomous, D = differential, E = estimated).
 };
 
 /**
  * @brief This struct represents the ZDA (Time and Date) sentence.
  */
 struct ZDA {
-  std::string type;               ///< Type of the NMEA sentence (ZDA).
-  std::string utc_time;           ///< UTC time in the format HHMMSS.
-  std::string utc_day;            ///< UTC day.
-  std::string utc_month;          ///< UTC month.
-  std::string utc_year;           ///< UTC year.
-  std::string local_zone_hours;   ///< Local zone hours.
-  std::string local_zone_minutes; ///< Local zone minutes.
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  ZDA() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit ZDA(const allocator_type &alloc)
+      : local_zone_hours{alloc}, local_zone_minutes{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  ZDA(const ZDA &other, const allocator_type &alloc) : ZDA{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  ZDA(ZDA &&other, const allocator_type &alloc) : ZDA{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPZDA".
+  Address type{.type = SentenceType::ZDA};
+  Timestamp utc_time;                  ///< UTC date and time.
+  std::pmr::string local_zone_hours;   ///< Local zone hours.
+  std::pmr::string local_zone_minutes; ///< Local zone minutes.
+};
+
+/**
+ * @brief This struct represents the GST (GNSS Pseudorange Error Statistics)
+ * sentence.
+ */
+struct GST {
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  GST() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit GST(const allocator_type &alloc)
+      : rms{alloc}, semi_major_error{alloc}, semi_minor_error{alloc},
+        orientation{alloc}, latitude_error{alloc}, longitude_error{alloc},
+        altitude_error{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  GST(const GST &other, const allocator_type &alloc) : GST{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  GST(GST &&other, const allocator_type &alloc) : GST{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPGST".
+  Address type{.type = SentenceType::GST};
+  Timestamp utc_time; ///< UTC time, dated from the last RMC or ZDA sentence.
+  std::pmr::string rms;              ///< RMS of the pseudorange residuals.
+  std::pmr::string semi_major_error; ///< Error ellipse semi-major axis in m.
+  std::pmr::string semi_minor_error; ///< Error ellipse semi-minor axis in m.
+  std::pmr::string orientation;      ///< Error ellipse orientation in degrees.
+  std::pmr::string latitude_error;   ///< Latitude standard deviation in m.
+  std::pmr::string longitude_error;  ///< Longitude standard deviation in m.
+  std::pmr::string altitude_error;   ///< Altitude standard deviation in m.
+};
+
+/**
+ * @brief This struct represents the GBS (GNSS Satellite Fault Detection)
+ * sentence, reported by receivers running RAIM.
+ */
+struct GBS {
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  GBS() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit GBS(const allocator_type &alloc)
+      : latitude_error{alloc}, longitude_error{alloc}, altitude_error{alloc},
+        probability{alloc}, bias{alloc}, bias_deviation{alloc},
+        system_id{alloc}, signal_id{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  GBS(const GBS &other, const allocator_type &alloc) : GBS{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  GBS(GBS &&other, const allocator_type &alloc) : GBS{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPGBS".
+  Address type{.type = SentenceType::GBS};
+  Timestamp utc_time; ///< UTC time, dated from the last RMC or ZDA sentence.
+  std::pmr::string latitude_error;   ///< Expected latitude error in m.
+  std::pmr::string longitude_error;  ///< Expected longitude error in m.
+  std::pmr::string altitude_error;   ///< Expected altitude error in m.
+  std::uint16_t failed_satellite{};  ///< ID of the likely failed one, or 0.
+  std::pmr::string probability;      ///< Probability of missed detection.
+  std::pmr::string bias;             ///< Estimated bias of the satellite in m.
+  std::pmr::string bias_deviation;   ///< Standard deviation of the bias in m.
+  std::pmr::string system_id;        ///< GNSS system ID (NMEA 4.1), or empty.
+  std::pmr::string signal_id;        ///< GNSS signal ID (NMEA 4.1), or empty.
+};
+
+/**
+ * @brief This struct represents the GNS (GNSS Fix Data) sentence, the
+ * multi-constellation counterpart of GGA.
+ */
+struct GNS {
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  GNS() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit GNS(const allocator_type &alloc)
+      : mode{alloc}, satellites_used{alloc}, hdop{alloc}, altitude{alloc},
+        geoidal_separation{alloc}, dgps{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  GNS(const GNS &other, const allocator_type &alloc) : GNS{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  GNS(GNS &&other, const allocator_type &alloc) : GNS{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPGNS".
+  Address type{.type = SentenceType::GNS};
+  Timestamp utc_time; ///< UTC time, dated from the last RMC or ZDA sentence.
+  Latitude
+      latitude; ///< Latitude in decimal degrees and direction ('N' or 'S').
+  Longitude
+      longitude; ///< Longitude in decimal degrees and direction ('E' or 'W').
+  /// One mode character per constellation, e.g. "AAN".
+  std::pmr::string mode;
+  std::pmr::string satellites_used; ///< Number of satellites used for the fix.
+  std::pmr::string hdop;            ///< Horizontal dilution of precision.
+  std::pmr::string altitude;        ///< Altitude in meters.
+  std::pmr::string geoidal_separation; ///< Geoidal separation in meters.
+  std::pmr::string dgps;               ///< Differential reference station.
+};
+
+/**
+ * @brief This struct represents the RMB (Recommended Minimum Navigation
+ * Information) sentence.
+ */
+struct RMB {
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  RMB() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit RMB(const allocator_type &alloc)
+      : cross_track_error{alloc}, origin{alloc}, destination{alloc},
+        range{alloc}, bearing{alloc}, closing_velocity{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  RMB(const RMB &other, const allocator_type &alloc) : RMB{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  RMB(RMB &&other, const allocator_type &alloc) : RMB{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPRMB".
+  Address type{.type = SentenceType::RMB};
+  char status{}; ///< Data status ('A' for valid, 'V' for warning).
+  std::pmr::string cross_track_error; ///< Cross-track error, nautical miles.
+  char steer{};                       ///< Direction to steer ('L' or 'R').
+  std::pmr::string origin;            ///< Origin waypoint ID.
+  std::pmr::string destination;       ///< Destination waypoint ID.
+  Latitude destination_latitude;      ///< Latitude of the destination.
+  Longitude destination_longitude;    ///< Longitude of the destination.
+  std::pmr::string range;             ///< Range to destination, nautical miles.
+  std::pmr::string bearing;           ///< True bearing to destination, degrees.
+  std::pmr::string closing_velocity;  ///< Closing velocity in knots.
+  char arrival{};                     ///< Arrival status ('A' if arrived).
+  char mode{}; ///< Mode (NMEA 2.3), '\0' if not reported.
+};
+
+/**
+ * @brief This struct represents the HDT (Heading, True) sentence.
+ */
+struct HDT {
+  /// Allocator of the string and vector members, see SampleArena.
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  HDT() = default;
+
+  /**
+   * @brief Constructs an empty sentence allocating from the given allocator.
+   * @param alloc The allocator of the members.
+   */
+  explicit HDT(const allocator_type &alloc) : heading{alloc} {}
+
+  /**
+   * @brief Copies a sentence into storage from the given allocator.
+   * @param other The sentence to copy.
+   * @param alloc The allocator of the copy.
+   */
+  HDT(const HDT &other, const allocator_type &alloc) : HDT{alloc} {
+    *this = other;
+  }
+
+  /**
+   * @brief Moves a sentence into storage from the given allocator, copying
+   * the members if it allocates elsewhere.
+   * @param other The sentence to move.
+   * @param alloc The allocator of the result.
+   */
+  HDT(HDT &&other, const allocator_type &alloc) : HDT{alloc} {
+    *this = std::move(other);
+  }
+
+  /// Address of the NMEA sentence, e.g. "$GPHDT".
+  Address type{.type = SentenceType::HDT};
+  std::pmr::string heading; ///< True heading in degrees.
 };
 
 /**
@@ -185,8 +706,48 @@ enum class ParseError {
   UnsupportedType,  ///< The NMEA sentence type is not supported.
 };
 
+/**
+ * @brief This struct carries state between consecutive parse() calls on one
+ * stream.
+ *
+ * GGA, GLL, GNS, GST and GBS sentences only carry the time of day, so they
+ * are dated with the last date seen in an RMC or ZDA sentence, moving to the
+ * next day when the time of day wraps around midnight.
+ */
+struct ParseContext {
+  std::chrono::sys_days date{};            ///< Current UTC date.
+  std::chrono::milliseconds time_of_day{}; ///< Time of the last sentence.
+  /// Memory the parsed sentences allocate from, e.g. a SampleArena.
+  std::pmr::memory_resource *resource{std::pmr::get_default_resource()};
+};
+
 /**
  * @brief This variant represents a sample NMEA sentence.
  */
-using Sample = std::variant<GGA, GLL, GSA, GSV, RMC, VTG, ZDA>;
+using Sample =
+    std::variant<GGA, GLL, GSA, GSV, RMC, VTG, ZDA, GST, GBS, GNS, RMB, HDT>;
+
+/**
+ * @brief This struct represents a position fix extracted from a GGA, GNS, GLL
+ * or RMC sentence.
+ */
+struct Fix {
+  Timestamp utc_time; ///< UTC time of the fix.
+  double latitude;    ///< Latitude in decimal degrees, negative south.
+  double longitude;   ///< Longitude in decimal degrees, negative west.
+  double speed;       ///< Speed over ground in m/s, NaN if not reported.
+  double hdop;        ///< Horizontal dilution of precision, NaN if unknown.
+};
+
+/**
+ * @brief This struct represents a period during which a receiver stayed in
+ * place, collapsing all of its fixes into a single record.
+ */
+struct Dwell {
+  Timestamp start_time; ///< UTC time of the first fix.
+  Timestamp end_time;   ///< UTC time of the last fix.
+  double latitude;      ///< Mean latitude in decimal degrees.
+  double longitude;     ///< Mean longitude in decimal degrees.
+  std::size_t fixes;    ///< Number of fixes collapsed into the dwell.
+};
 } // namespace gps_lib
@@ -0,0 +1,556 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "detail/trace.h"
+#include "intern.h"
+#include "metrics.h"
+#include "types.h"
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief First sync character of a UBX frame.
+ */
+constexpr char UBX_SYNC_1{'\xB5'};
+
+/**
+ * @brief Second sync character of a UBX frame.
+ */
+constexpr char UBX_SYNC_2{'\x62'};
+
+/**
+ * @brief Bytes before the payload: sync characters, class, ID and length.
+ */
+constexpr std::size_t UBX_HEADER_SIZE{6};
+
+/**
+ * @brief Bytes of framing around the payload, header and checksum together.
+ */
+constexpr std::size_t UBX_FRAME_OVERHEAD{UBX_HEADER_SIZE + 2};
+
+/**
+ * @brief Class of the UBX navigation results.
+ */
+constexpr std::uint8_t UBX_CLASS_NAV{0x01};
+
+/**
+ * @brief ID of UBX-NAV-PVT, the navigation position velocity time solution.
+ */
+constexpr std::uint8_t UBX_ID_NAV_PVT{0x07};
+
+/**
+ * @brief ID of UBX-NAV-SAT, the satellite information.
+ */
+constexpr std::uint8_t UBX_ID_NAV_SAT{0x35};
+
+/**
+ * @brief A UBX frame with a valid checksum.
+ */
+struct UbxFrame {
+  std::uint8_t message_class; ///< Message class, e.g. UBX_CLASS_NAV.
+  std::uint8_t message_id;    ///< Message ID within the class.
+  std::string_view payload;   ///< Payload, a view into the decoded bytes.
+};
+
+namespace detail {
+/**
+ * @brief Reads a little-endian field of a UBX payload.
+ * @tparam T The integer type of the field.
+ * @param bytes The payload.
+ * @param offset The offset of the field, which must lie inside the payload.
+ * @return  T       The field.
+ */
+template <typename T>
+constexpr T read_le(std::string_view bytes, std::size_t offset) {
+  using U = std::make_unsigned_t<T>;
+  U value = 0;
+
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    value |= static_cast<U>(
+        static_cast<U>(static_cast<unsigned char>(bytes[offset + i]))
+        << (8 * i));
+  }
+
+  return static_cast<T>(value);
+}
+
+/**
+ * @brief Appends a little-endian field to a UBX payload.
+ * @tparam T The integer type of the field.
+ * @param out The payload.
+ * @param value The field.
+ * @return  void    This function does not return a value.
+ */
+template <typename T> void append_le(std::string &out, T value) {
+  auto bits = static_cast<std::make_unsigned_t<T>>(value);
+
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    out.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+  }
+}
+
+/**
+ * @brief Computes the 8-bit Fletcher checksum of a UBX frame.
+ * @param body The class, ID, length and payload bytes.
+ * @return  std::uint16_t   CK_A in the low byte and CK_B in the high byte,
+ * as they appear on the wire.
+ */
+constexpr std::uint16_t ubx_checksum(std::string_view body) {
+  std::uint8_t a = 0;
+  std::uint8_t b = 0;
+
+  for (char c : body) {
+    a = static_cast<std::uint8_t>(a + static_cast<unsigned char>(c));
+    b = static_cast<std::uint8_t>(b + a);
+  }
+
+  return static_cast<std::uint16_t>(a | (b << 8));
+}
+} // namespace detail
+
+/**
+ * @brief Checks and decodes one UBX frame.
+ * @param frame The frame, from the first sync character to the checksum.
+ * @return  std::expected<UbxFrame, ParseError>     The frame, whose payload
+ * views into the given bytes, or MissingFields if the frame is truncated
+ * and InvalidFormat if its sync characters, length or checksum are wrong.
+ */
+inline std::expected<UbxFrame, ParseError>
+decode_ubx(std::string_view frame) {
+  if (frame.size() < UBX_FRAME_OVERHEAD) {
+    return std::unexpected(ParseError::MissingFields);
+  }
+
+  if (frame[0] != UBX_SYNC_1 || frame[1] != UBX_SYNC_2) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  std::size_t length = detail::read_le<std::uint16_t>(frame, 4);
+
+  if (frame.size() < length + UBX_FRAME_OVERHEAD) {
+    return std::unexpected(ParseError::MissingFields);
+  } else if (frame.size() > length + UBX_FRAME_OVERHEAD) {
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  std::string_view body = frame.substr(2, length + UBX_HEADER_SIZE - 2);
+  if (detail::ubx_checksum(body) !=
+      detail::read_le<std::uint16_t>(frame, length + UBX_HEADER_SIZE)) {
+#ifdef GPS_LIB_METRICS
+    detail::record_checksum_failure();
+#endif
+    return std::unexpected(ParseError::InvalidFormat);
+  }
+
+  return UbxFrame{static_cast<std::uint8_t>(frame[2]),
+                  static_cast<std::uint8_t>(frame[3]),
+                  frame.substr(UBX_HEADER_SIZE, length)};
+}
+
+/**
+ * @brief Appends a UBX frame, with its checksum, to a byte string.
+ * @param out The bytes to append to.
+ * @param message_class The message class.
+ * @param message_id The message ID.
+ * @param payload The payload, at most 65535 bytes.
+ * @return  void    This function does not return a value.
+ */
+inline void encode_ubx(std::string &out, std::uint8_t message_class,
+                       std::uint8_t message_id, std::string_view payload) {
+  std::size_t start = out.size();
+
+  out.push_back(UBX_SYNC_1);
+  out.push_back(UBX_SYNC_2);
+  out.push_back(static_cast<char>(message_class));
+  out.push_back(static_cast<char>(message_id));
+  detail::append_le(out, static_cast<std::uint16_t>(payload.size()));
+  out.append(payload);
+
+  std::string_view body{out.data() + start + 2, out.size() - start - 2};
+  detail::append_le(out, detail::ubx_checksum(body));
+}
+
+/**
+ * @brief A UBX-NAV-PVT message read in place from its payload.
+ *
+ * The accessors decode the little-endian fields on demand, so wrapping a
+ * frame copies nothing. Units are converted to those of the NMEA types:
+ * degrees, meters and meters per second.
+ */
+class UbxNavPvt {
+public:
+  /**
+   * @brief Size of the payload in bytes.
+   */
+  static constexpr std::size_t SIZE{92};
+
+  /**
+   * @brief Wraps the payload of a frame.
+   * @param frame The frame.
+   * @return  std::expected<UbxNavPvt, ParseError>    The message, or
+   * UnsupportedType if the frame is another message and MissingFields if the
+   * payload is too short.
+   */
+  static constexpr std::expected<UbxNavPvt, ParseError>
+  from(const UbxFrame &frame) {
+    if (frame.message_class != UBX_CLASS_NAV ||
+        frame.message_id != UBX_ID_NAV_PVT) {
+      return std::unexpected(ParseError::UnsupportedType);
+    }
+    if (frame.payload.size() < SIZE) {
+      return std::unexpected(ParseError::MissingFields);
+    }
+
+    return UbxNavPvt{frame.payload};
+  }
+
+  /**
+   * @brief Returns the GPS time of week of the navigation epoch.
+   * @return  std::uint32_t   The time of week in ms.
+   */
+  constexpr std::uint32_t time_of_week() const {
+    return detail::read_le<std::uint32_t>(payload_, 0);
+  }
+
+  /**
+   * @brief Checks whether the UTC date and time are valid.
+   * @return  bool    True if the receiver flags both as valid.
+   */
+  constexpr bool valid_time() const { return (byte(11) & 0x03) == 0x03; }
+
+  /**
+   * @brief Returns the UTC time of the solution.
+   * @return  Timestamp   The time, rounded to the millisecond. Meaningless
+   * unless valid_time() is true.
+   */
+  constexpr Timestamp utc_time() const {
+    using namespace std::chrono;
+
+    year_month_day date{year{detail::read_le<std::uint16_t>(payload_, 4)},
+                        month{byte(6)}, day{byte(7)}};
+    nanoseconds fraction{detail::read_le<std::int32_t>(payload_, 16)};
+
+    return sys_days{date} + hours{byte(8)} + minutes{byte(9)} +
+           seconds{byte(10)} + round<milliseconds>(fraction);
+  }
+
+  /**
+   * @brief Returns the fix type.
+   * @return  std::uint8_t    0 = no fix, 1 = dead reckoning, 2 = 2D fix,
+   * 3 = 3D fix, 4 = GNSS and dead reckoning, 5 = time only.
+   */
+  constexpr std::uint8_t fix_type() const { return byte(20); }
+
+  /**
+   * @brief Checks whether the fix is within the receiver's accuracy masks.
+   * @return  bool    True if the gnssFixOK flag is set.
+   */
+  constexpr bool fix_ok() const { return (byte(21) & 0x01) != 0; }
+
+  /**
+   * @brief Returns the number of satellites used in the solution.
+   * @return  std::uint8_t    The number of satellites.
+   */
+  constexpr std::uint8_t satellites_used() const { return byte(23); }
+
+  /**
+   * @brief Returns the longitude.
+   * @return  double  The longitude in decimal degrees, negative west.
+   */
+  constexpr double longitude() const {
+    return detail::read_le<std::int32_t>(payload_, 24) * 1e-7;
+  }
+
+  /**
+   * @brief Returns the latitude.
+   * @return  double  The latitude in decimal degrees, negative south.
+   */
+  constexpr double latitude() const {
+    return detail::read_le<std::int32_t>(payload_, 28) * 1e-7;
+  }
+
+  /**
+   * @brief Returns the height above the ellipsoid.
+   * @return  double  The height in meters.
+   */
+  constexpr double height() const {
+    return detail::read_le<std::int32_t>(payload_, 32) * 1e-3;
+  }
+
+  /**
+   * @brief Returns the height above mean sea level.
+   * @return  double  The altitude in meters.
+   */
+  constexpr double altitude() const {
+    return detail::read_le<std::int32_t>(payload_, 36) * 1e-3;
+  }
+
+  /**
+   * @brief Returns the horizontal accuracy estimate.
+   * @return  double  The accuracy in meters.
+   */
+  constexpr double horizontal_accuracy() const {
+    return detail::read_le<std::uint32_t>(payload_, 40) * 1e-3;
+  }
+
+  /**
+   * @brief Returns the vertical accuracy estimate.
+   * @return  double  The accuracy in meters.
+   */
+  constexpr double vertical_accuracy() const {
+    return detail::read_le<std::uint32_t>(payload_, 44) * 1e-3;
+  }
+
+  /**
+   * @brief Returns the north component of the velocity.
+   * @return  double  The velocity in m/s.
+   */
+  constexpr double velocity_north() const {
+    return detail::read_le<std::int32_t>(payload_, 48) * 1e-3;
+  }
+
+  /**
+   * @brief Returns the east component of the velocity.
+   * @return  double  The velocity in m/s.
+   */
+  constexpr double velocity_east() const {
+    return detail::read_le<std::int32_t>(payload_, 52) * 1e-3;
+  }
+
+  /**
+   * @brief Returns the down component of the velocity.
+   * @return  double  The velocity in m/s.
+   */
+  constexpr double velocity_down() const {
+    return detail::read_le<std::int32_t>(payload_, 56) * 1e-3;
+  }
+
+  /**
+   * @brief Returns the ground speed.
+   * @return  double  The speed in m/s.
+   */
+  constexpr double ground_speed() const {
+    return detail::read_le<std::int32_t>(payload_, 60) * 1e-3;
+  }
+
+  /**
+   * @brief Returns the heading of motion.
+   * @return  double  The heading in degrees.
+   */
+  constexpr double heading() const {
+    return detail::read_le<std::int32_t>(payload_, 64) * 1e-5;
+  }
+
+  /**
+   * @brief Returns the position dilution of precision.
+   * @return  double  The PDOP.
+   */
+  constexpr double pdop() const {
+    return detail::read_le<std::uint16_t>(payload_, 76) * 1e-2;
+  }
+
+private:
+  /**
+   * @brief Wraps a payload of at least SIZE bytes.
+   * @param payload The payload.
+   */
+  explicit constexpr UbxNavPvt(std::string_view payload)
+      : payload_{payload} {}
+
+  /**
+   * @brief Reads a one-byte field.
+   * @param offset The offset of the field.
+   * @return  std::uint8_t    The field.
+   */
+  constexpr std::uint8_t byte(std::size_t offset) const {
+    return static_cast<std::uint8_t>(payload_[offset]);
+  }
+
+  std::string_view payload_; ///< The payload, not owned.
+};
+
+/**
+ * @brief A satellite of a UBX-NAV-SAT message.
+ */
+struct UbxSatellite {
+  std::uint8_t gnss_id;  ///< GNSS: 0 GPS, 1 SBAS, 2 Galileo, 3 BeiDou, ...
+  std::uint8_t sv_id;    ///< Satellite ID within its GNSS.
+  std::uint8_t cno;      ///< Carrier-to-noise density ratio in dB-Hz.
+  std::int8_t elevation; ///< Elevation in degrees, -91 if unknown.
+  std::int16_t azimuth;  ///< Azimuth in degrees.
+  std::uint32_t flags;   ///< Signal quality and usage flags.
+};
+
+/**
+ * @brief A UBX-NAV-SAT message read in place from its payload.
+ */
+class UbxNavSat {
+public:
+  /**
+   * @brief Size of the payload before the satellites.
+   */
+  static constexpr std::size_t HEADER_SIZE{8};
+
+  /**
+   * @brief Size of each satellite block.
+   */
+  static constexpr std::size_t SATELLITE_SIZE{12};
+
+  /**
+   * @brief Wraps the payload of a frame.
+   * @param frame The frame.
+   * @return  std::expected<UbxNavSat, ParseError>    The message, or
+   * UnsupportedType if the frame is another message and MissingFields if the
+   * payload is shorter than its satellite count requires.
+   */
+  static constexpr std::expected<UbxNavSat, ParseError>
+  from(const UbxFrame &frame) {
+    if (frame.message_class != UBX_CLASS_NAV ||
+        frame.message_id != UBX_ID_NAV_SAT) {
+      return std::unexpected(ParseError::UnsupportedType);
+    }
+    if (frame.payload.size() < HEADER_SIZE) {
+      return std::unexpected(ParseError::MissingFields);
+    }
+
+    std::size_t count = static_cast<std::uint8_t>(frame.payload[5]);
+    if (frame.payload.size() < HEADER_SIZE + SATELLITE_SIZE * count) {
+      return std::unexpected(ParseError::MissingFields);
+    }
+
+    return UbxNavSat{frame.payload};
+  }
+
+  /**
+   * @brief Returns the GPS time of week of the navigation epoch.
+   * @return  std::uint32_t   The time of week in ms.
+   */
+  constexpr std::uint32_t time_of_week() const {
+    return detail::read_le<std::uint32_t>(payload_, 0);
+  }
+
+  /**
+   * @brief Returns the number of satellites.
+   * @return  std::size_t     The number of satellites.
+   */
+  constexpr std::size_t size() const {
+    return static_cast<std::uint8_t>(payload_[5]);
+  }
+
+  /**
+   * @brief Returns a satellite.
+   * @param index The position of the satellite, below size().
+   * @return  UbxSatellite    The satellite.
+   */
+  constexpr UbxSatellite operator[](std::size_t index) const {
+    std::size_t at = HEADER_SIZE + SATELLITE_SIZE * index;
+
+    return {static_cast<std::uint8_t>(payload_[at]),
+            static_cast<std::uint8_t>(payload_[at + 1]),
+            static_cast<std::uint8_t>(payload_[at + 2]),
+            static_cast<std::int8_t>(payload_[at + 3]),
+            detail::read_le<std::int16_t>(payload_, at + 4),
+            detail::read_le<std::uint32_t>(payload_, at + 8)};
+  }
+
+private:
+  /**
+   * @brief Wraps a payload holding all of its satellites.
+   * @param payload The payload.
+   */
+  explicit constexpr UbxNavSat(std::string_view payload)
+      : payload_{payload} {}
+
+  std::string_view payload_; ///< The payload, not owned.
+};
+
+/**
+ * @brief Extracts a position fix from a UBX-NAV-PVT message, like the NMEA
+ * to_fix().
+ * @param pvt The message.
+ * @return  std::optional<Fix>  The fix, or std::nullopt if the receiver has
+ * no valid 2D or 3D fix or no valid time. The HDOP is NaN, as NAV-PVT only
+ * reports the PDOP.
+ */
+constexpr std::optional<Fix> to_fix(const UbxNavPvt &pvt) {
+  std::uint8_t type = pvt.fix_type();
+
+  if (!pvt.fix_ok() || type < 2 || type > 4 || !pvt.valid_time()) {
+    return std::nullopt;
+  }
+
+  return Fix{pvt.utc_time(), pvt.latitude(), pvt.longitude(),
+             pvt.ground_speed(), std::numeric_limits<double>::quiet_NaN()};
+}
+
+/**
+ * @brief Returns the NMEA satellite ID of a UBX satellite, using the NMEA
+ * 4.10 numbering: GPS 1-32, SBAS 33-64, GLONASS 65-96, and the
+ * constellation's own IDs for Galileo, BeiDou and QZSS.
+ * @param satellite The satellite.
+ * @return  int     The NMEA ID.
+ */
+constexpr int nmea_satellite_id(const UbxSatellite &satellite) {
+  switch (satellite.gnss_id) {
+  case 1:
+    return satellite.sv_id - 87;
+  case 6:
+    return satellite.sv_id + 64;
+  default:
+    return satellite.sv_id;
+  }
+}
+
+/**
+ * @brief Converts the satellites of a UBX-NAV-SAT message to the records of
+ * an NMEA GSV sentence.
+ * @param sat The message.
+ * @param satellites Receives the satellites, replacing its contents.
+ * @return  void    This function does not return a value.
+ */
+inline void to_satellites(const UbxNavSat &sat,
+                          std::pmr::vector<Satellite> &satellites) {
+  GPS_LIB_TRACE_SCOPE("to_satellites");
+
+  satellites.resize(sat.size());
+
+  auto assign = [](std::pmr::string &field, int value) {
+    std::array<char, 8> buffer;
+    auto [end, error] =
+        std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    field.assign(buffer.data(), end);
+  };
+
+  for (std::size_t i = 0; i < sat.size(); ++i) {
+    UbxSatellite satellite = sat[i];
+    Satellite &out = satellites[i];
+    out.id = static_cast<std::uint16_t>(nmea_satellite_id(satellite));
+    assign(out.azimuth, satellite.azimuth);
+    assign(out.snr, satellite.cno);
+
+    // -91 marks an unknown elevation.
+    if (satellite.elevation < -90) {
+      out.elevation.clear();
+    } else {
+      assign(out.elevation, satellite.elevation);
+    }
+  }
+}
+} // namespace gps_lib
@@ -0,0 +1,866 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <fcntl.h>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <sys/uio.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "detail/file_descriptor.h"
+#include "detail/io_backend.h"
+#include "detail/io_uring.h"
+#include "framer.h"
+#include "parse.h"
+#include "types.h"
+
+// The socket servers need epoll and eventfd; file reads work on any POSIX
+// system, such as macOS, through read_files_posix().
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#include "detail/lru_map.h"
+#include "detail/socket.h"
+#include "server.h"
+#endif
+
+/**
+ * @namespace gps_lib
+ * @brief A header-only C++ library for parsing and processing NMEA GPS
+ * sentences.
+ */
+namespace gps_lib {
+/**
+ * @brief Concept for callbacks that receive sentences read from files.
+ *
+ * The handler is called with the index of the file, the raw sentence and its
+ * parsed form.
+ */
+template <typename T>
+concept ReadHandler =
+    std::invocable<T &, std::size_t, std::string_view, const Sample &>;
+
+/**
+ * @brief This struct holds the counters of a batch of file reads.
+ */
+struct IoStats {
+  IoBackend backend{IoBackend::Posix}; ///< Mechanism actually used.
+  std::size_t syscalls{0};             ///< Read or io_uring_enter calls.
+  std::size_t bytes{0};                ///< Bytes read.
+  std::size_t sentences{0};            ///< Sentences parsed and dispatched.
+  std::size_t errors{0};               ///< Sentences that failed to parse.
+};
+
+namespace detail {
+/**
+ * @brief This struct holds the read state of one log file.
+ */
+struct FileStream {
+  FileDescriptor file;     ///< Open log file.
+  std::size_t index{0};    ///< Index of the file in the batch.
+  std::uint64_t offset{0}; ///< Offset of the next read.
+  SentenceFramer<> framer; ///< Framer for the file contents.
+  ParseContext context;    ///< Parse state of the file.
+};
+
+/**
+ * @brief Frames a chunk of a file, or flushes the framer at end of file, and
+ * dispatches the parsed sentences.
+ * @param stream The file state.
+ * @param data The bytes read, empty at end of file.
+ * @param handler Callback invoked with every parsed sentence.
+ * @param stats Counters to update.
+ * @return  void    This function does not return a value.
+ */
+template <typename Handler>
+void consume(FileStream &stream, std::string_view data, Handler &handler,
+             IoStats &stats) {
+  auto dispatch = [&](std::string_view line) {
+    auto sample = parse(line, stream.context);
+
+    if (!sample) {
+      ++stats.errors;
+      return;
+    }
+
+    handler(stream.index, line, *sample);
+    ++stats.sentences;
+  };
+
+  stats.bytes += data.size();
+
+  if (data.empty()) {
+    stream.framer.flush(dispatch);
+  } else {
+    stream.framer.push(data, dispatch);
+  }
+}
+
+/**
+ * @brief Reads files one after the other with plain read() calls.
+ * @param paths The files to read.
+ * @param handler Callback invoked with every parsed sentence.
+ * @param chunk_size The size of each read.
+ * @return  std::expected<IoStats, std::error_code>    The counters, or the
+ * error that stopped the reads.
+ */
+template <typename Handler>
+std::expected<IoStats, std::error_code>
+read_files_posix(std::span<const std::filesystem::path> paths,
+                 Handler &handler, std::size_t chunk_size) {
+  IoStats stats;
+  std::vector<char> buffer(chunk_size);
+
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    FileStream stream{
+        FileDescriptor{::open(paths[i].c_str(), O_RDONLY | O_CLOEXEC)},
+        i,
+        0,
+        {},
+        {}};
+    if (!stream.file) {
+      return std::unexpected{last_error()};
+    }
+
+    while (true) {
+      ssize_t size = ::read(stream.file.get(), buffer.data(), buffer.size());
+      ++stats.syscalls;
+
+      if (size < 0 && errno == EINTR) {
+        continue;
+      } else if (size < 0) {
+        return std::unexpected{last_error()};
+      }
+
+      consume(stream, {buffer.data(), static_cast<std::size_t>(size)},
+              handler, stats);
+
+      if (size == 0) {
+        break;
+      }
+    }
+  }
+
+  return stats;
+}
+
+#if GPS_LIB_HAS_IO_URING
+/**
+ * @brief Reads many files concurrently through io_uring.
+ *
+ * A fixed number of files are in flight at once, each with one outstanding
+ * read into its own registered buffer, so the kernel skips mapping the
+ * buffer on every read and a single io_uring_enter submits the next reads
+ * and collects the finished ones for all files.
+ */
+class UringFileReader {
+public:
+  /**
+   * @brief Creates a reader.
+   * @param slots The number of files read concurrently.
+   * @param chunk_size The size of each read.
+   * @return  std::optional<UringFileReader>  The reader, or std::nullopt if
+   * io_uring is not available.
+   */
+  static std::optional<UringFileReader> create(std::size_t slots,
+                                               std::size_t chunk_size) {
+    auto ring = Ring::create(static_cast<unsigned>(slots));
+    if (!ring) {
+      return std::nullopt;
+    }
+
+    std::optional<UringFileReader> reader{
+        UringFileReader{std::move(*ring), slots, chunk_size}};
+
+    if (!reader->ring_.register_buffers(reader->buffers_)) {
+      return std::nullopt;
+    }
+
+    return reader;
+  }
+
+  /**
+   * @brief Reads all files.
+   * @param paths The files to read.
+   * @param handler Callback invoked with every parsed sentence.
+   * @return  std::expected<IoStats, std::error_code>  The counters, or the
+   * error that stopped the reads.
+   */
+  template <typename Handler>
+  std::expected<IoStats, std::error_code>
+  run(std::span<const std::filesystem::path> paths, Handler &handler) {
+    IoStats stats{IoBackend::Uring};
+    std::error_code error;
+    std::size_t next = 0;
+    std::size_t active = 0;
+
+    auto open_next = [&](std::size_t slot) {
+      if (next == paths.size()) {
+        return false;
+      }
+
+      streams_[slot] = FileStream{
+          FileDescriptor{::open(paths[next].c_str(), O_RDONLY | O_CLOEXEC)},
+          next,
+          0,
+          {},
+          {}};
+      ++next;
+
+      if (!streams_[slot].file) {
+        error = last_error();
+        return false;
+      }
+
+      queue_read(slot);
+      return true;
+    };
+
+    for (std::size_t slot = 0; slot < streams_.size() && !error; ++slot) {
+      active += open_next(slot);
+    }
+
+    while (active > 0 && !error) {
+      int result = ring_.submit(1);
+      if (result < 0 && result != -EINTR) {
+        error = std::error_code{-result, std::system_category()};
+        break;
+      }
+
+      ring_.drain([&](const io_uring_cqe &cqe) {
+        std::size_t slot = cqe.user_data;
+        FileStream &stream = streams_[slot];
+
+        if (cqe.res > 0) {
+          auto size = static_cast<std::size_t>(cqe.res);
+          stream.offset += size;
+          consume(stream,
+                  {static_cast<char *>(buffers_[slot].iov_base), size},
+                  handler, stats);
+          queue_read(slot);
+        } else if (cqe.res == 0) {
+          consume(stream, {}, handler, stats);
+          stream.file.reset();
+          active -= !open_next(slot);
+        } else if (cqe.res == -EAGAIN || cqe.res == -EINTR) {
+          queue_read(slot);
+        } else {
+          error = std::error_code{-cqe.res, std::system_category()};
+        }
+      });
+    }
+
+    stats.syscalls = ring_.syscalls();
+
+    if (error) {
+      return std::unexpected{error};
+    }
+
+    return stats;
+  }
+
+private:
+  /**
+   * @brief Constructs a reader over a ring.
+   * @param ring The io_uring instance.
+   * @param slots The number of files read concurrently.
+   * @param chunk_size The size of each read.
+   */
+  UringFileReader(Ring ring, std::size_t slots, std::size_t chunk_size)
+      : storage_(slots * chunk_size), buffers_(slots), streams_(slots),
+        ring_{std::move(ring)} {
+    for (std::size_t i = 0; i < slots; ++i) {
+      buffers_[i] = {storage_.data() + i * chunk_size, chunk_size};
+    }
+  }
+
+  /**
+   * @brief Queues the next read of a slot into its registered buffer.
+   * @param slot The slot to read into.
+   * @return  void    This function does not return a value.
+   */
+  void queue_read(std::size_t slot) {
+    io_uring_sqe &sqe = ring_.next_sqe();
+    sqe.opcode = IORING_OP_READ_FIXED;
+    sqe.fd = streams_[slot].file.get();
+    sqe.addr = reinterpret_cast<std::uintptr_t>(buffers_[slot].iov_base);
+    sqe.len = static_cast<std::uint32_t>(buffers_[slot].iov_len);
+    sqe.off = streams_[slot].offset;
+    sqe.buf_index = static_cast<std::uint16_t>(slot);
+    sqe.user_data = slot;
+  }
+
+  std::vector<char> storage_;       ///< Memory of the registered buffers.
+  std::vector<iovec> buffers_;      ///< One registered buffer per slot.
+  std::vector<FileStream> streams_; ///< File being read by each slot.
+  /// Declared last so it is torn down before the buffers.
+  Ring ring_;
+};
+#endif
+} // namespace detail
+
+/**
+ * @brief Reads and parses a batch of log files.
+ *
+ * With IoBackend::Uring the files are read concurrently through io_uring;
+ * if io_uring is not compiled in or the kernel refuses it, the files are
+ * read one after the other with read(). Compare IoStats::syscalls between
+ * the backends to measure the system calls saved per sentence.
+ *
+ * @param paths The files to read.
+ * @param handler Callback invoked with every parsed sentence, on the calling
+ * thread and in order within each file.
+ * @param backend The preferred I/O mechanism.
+ * @param chunk_size The size of each read in bytes.
+ * @return  std::expected<IoStats, std::error_code>    The counters, or the
+ * error that stopped the reads.
+ */
+template <ReadHandler Handler>
+std::expected<IoStats, std::error_code>
+read_files(std::span<const std::filesystem::path> paths, Handler &&handler,
+           IoBackend backend = IoBackend::Uring,
+           std::size_t chunk_size = 65536) {
+#if GPS_LIB_HAS_IO_URING
+  constexpr std::size_t max_slots = 32;
+
+  if (backend == IoBackend::Uring && !paths.empty()) {
+    if (auto reader = detail::UringFileReader::create(
+            std::min(paths.size(), max_slots), chunk_size)) {
+      return reader->run(paths, handler);
+    }
+  }
+#else
+  (void)backend;
+#endif
+
+  return detail::read_files_posix(paths, handler, chunk_size);
+}
+
+#ifdef __linux__
+/**
+ * @brief Receives NMEA sentences over UDP and TCP through io_uring and
+ * dispatches them parsed to a handler.
+ *
+ * Workers are laid out like IngestServer, one per thread with SO_REUSEPORT
+ * sockets, but each one drives an io_uring instead of epoll. Datagrams are
+ * received with a multishot recvmsg, connections are accepted with a
+ * multishot accept and every connection has a multishot recv, all selecting
+ * from a ring of registered buffers. Once armed, these requests keep
+ * producing completions without being resubmitted, so a worker makes one
+ * io_uring_enter per batch of completions instead of a system call per
+ * datagram or read.
+ *
+ * If io_uring is not compiled in or the kernel does not support multishot
+ * receives with buffer rings, start() falls back to an IngestServer and
+ * backend() reports IoBackend::Posix. Like IngestServer, it is only
+ * available on Linux.
+ *
+ * @tparam Handler The handler type. It is called from all worker threads at
+ * once and must be thread-safe.
+ */
+template <IngestHandler Handler> class UringIngestServer {
+public:
+  /**
+   * @brief Constructs a stopped server.
+   * @param options The server configuration.
+   * @param handler Callback invoked with every parsed sentence.
+   */
+  UringIngestServer(ServerOptions options, Handler handler)
+      : options_{std::move(options)}, handler_{std::move(handler)} {}
+
+  UringIngestServer(const UringIngestServer &) = delete;
+  UringIngestServer &operator=(const UringIngestServer &) = delete;
+
+  ~UringIngestServer() { stop(); }
+
+  /**
+   * @brief Opens the sockets and starts the worker threads.
+   * @return  std::expected<void, std::error_code>   Nothing on success, or
+   * the system error that prevented opening a socket.
+   */
+  std::expected<void, std::error_code> start() {
+    stop();
+
+#if GPS_LIB_HAS_IO_URING
+    std::optional<sockaddr_in> address =
+        detail::make_address(options_.address, options_.port);
+    if (!address) {
+      return std::unexpected{
+          std::make_error_code(std::errc::invalid_argument)};
+    }
+
+    stop_event_.reset(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+    if (!stop_event_) {
+      return std::unexpected{detail::last_error()};
+    }
+
+    for (std::size_t i = 0; i < std::max<std::size_t>(options_.threads, 1);
+         ++i) {
+      auto worker = std::make_unique<Worker>(options_.udp_sources);
+
+      if (!worker->open()) {
+        workers_.clear();
+        stop_event_.reset();
+        return start_fallback();
+      }
+
+      if ((options_.tcp &&
+           !detail::open_socket(worker->tcp, SOCK_STREAM, *address,
+                                options_.receive_buffer)) ||
+          (options_.udp &&
+           !detail::open_socket(worker->udp, SOCK_DGRAM, *address,
+                                options_.receive_buffer))) {
+        std::error_code error = detail::last_error();
+        workers_.clear();
+        stop_event_.reset();
+        return std::unexpected{error};
+      }
+
+      workers_.push_back(std::move(worker));
+    }
+
+    port_ = ntohs(address->sin_port);
+
+    for (const std::unique_ptr<Worker> &worker : workers_) {
+      threads_.emplace_back([this, &worker = *worker] { run(worker); });
+    }
+
+    return {};
+#else
+    return start_fallback();
+#endif
+  }
+
+  /**
+   * @brief Stops the worker threads and closes all sockets.
+   * @return  void    This function does not return a value.
+   */
+  void stop() {
+    if (fallback_) {
+      fallback_->stop();
+      fallback_.reset();
+    }
+
+#if GPS_LIB_HAS_IO_URING
+    if (stop_event_) {
+      std::uint64_t signal = 1;
+      [[maybe_unused]] auto written =
+          ::write(stop_event_.get(), &signal, sizeof(signal));
+    }
+
+    threads_.clear();
+    workers_.clear();
+    stop_event_.reset();
+#endif
+  }
+
+  /**
+   * @brief Returns the port the server listens on, useful when started on
+   * port 0.
+   * @return  std::uint16_t   The bound port.
+   */
+  std::uint16_t port() const { return fallback_ ? fallback_->port() : port_; }
+
+  /**
+   * @brief Returns the I/O mechanism in use.
+   * @return  IoBackend   IoBackend::Uring, or IoBackend::Posix after falling
+   * back.
+   */
+  IoBackend backend() const {
+    return fallback_ ? IoBackend::Posix : IoBackend::Uring;
+  }
+
+  /**
+   * @brief Returns the counters summed over all workers.
+   * @return  ServerStats     The current counters.
+   */
+  ServerStats stats() const {
+    if (fallback_) {
+      return fallback_->stats();
+    }
+
+    ServerStats total;
+
+#if GPS_LIB_HAS_IO_URING
+    for (const std::unique_ptr<Worker> &worker : workers_) {
+      total.connections += worker->connections.load(std::memory_order_relaxed);
+      total.datagrams += worker->datagrams.load(std::memory_order_relaxed);
+      total.bytes += worker->bytes.load(std::memory_order_relaxed);
+      total.sentences += worker->sentences.load(std::memory_order_relaxed);
+      total.errors += worker->errors.load(std::memory_order_relaxed);
+      total.syscalls += worker->syscalls.load(std::memory_order_relaxed);
+      total.evictions += worker->evictions.load(std::memory_order_relaxed);
+    }
+#endif
+
+    return total;
+  }
+
+private:
+  /**
+   * @brief Starts an epoll server in place of the io_uring workers.
+   * @return  std::expected<void, std::error_code>   The result of its start().
+   */
+  std::expected<void, std::error_code> start_fallback() {
+    fallback_.emplace(options_, std::ref(handler_));
+    return fallback_->start();
+  }
+
+#if GPS_LIB_HAS_IO_URING
+  static constexpr std::uint16_t BUFFERS{1024};     ///< Receive buffers.
+  static constexpr std::uint32_t BUFFER_SIZE{2048}; ///< Receive buffer size.
+  static constexpr std::uint64_t TAG_MASK{0xFFFFFFFFULL << 32};
+  static constexpr std::uint64_t STOP_TAG{1ULL << 32};     ///< Stop event.
+  static constexpr std::uint64_t DATAGRAM_TAG{2ULL << 32}; ///< UDP receive.
+  static constexpr std::uint64_t ACCEPT_TAG{3ULL << 32};   ///< TCP accept.
+  static constexpr std::uint64_t STREAM_TAG{4ULL << 32};   ///< TCP receive.
+
+  /**
+   * @brief This struct holds the state of a TCP connection.
+   */
+  struct Connection {
+    detail::FileDescriptor socket; ///< Connected socket.
+    std::uint64_t source;          ///< Source identifier of the peer.
+    SentenceFramer<> framer;       ///< Framer for the byte stream.
+    ParseContext context;          ///< Parse state of the stream.
+  };
+
+  /**
+   * @brief This struct holds everything a worker thread owns. Counters are
+   * only written by the worker and read by stats().
+   */
+  struct alignas(64) Worker {
+    /**
+     * @brief Constructs the state of a worker.
+     * @param udp_sources The number of UDP senders to keep state for.
+     */
+    explicit Worker(std::size_t udp_sources) : peers{udp_sources} {}
+
+    /**
+     * @brief Creates the ring and its receive buffers.
+     * @return  bool    False if io_uring or buffer rings are not supported.
+     */
+    bool open() {
+      auto created = detail::Ring::create(256);
+      if (!created) {
+        return false;
+      }
+
+      ring.emplace(std::move(*created));
+
+      auto registered =
+          detail::BufferRing::create(*ring, 0, BUFFERS, BUFFER_SIZE);
+      if (!registered) {
+        return false;
+      }
+
+      buffers.emplace(std::move(*registered));
+      udp_header.msg_namelen = sizeof(sockaddr_in);
+
+      return true;
+    }
+
+    detail::FileDescriptor udp; ///< Datagram socket.
+    detail::FileDescriptor tcp; ///< Listening socket.
+    /// Stream connections by descriptor.
+    std::unordered_map<int, Connection> streams;
+    /// Parse state of the most recently heard UDP senders.
+    detail::LruMap<std::uint64_t, ParseContext> peers;
+    /// Layout of multishot recvmsg buffers: sender address, no control data.
+    msghdr udp_header{};
+    std::optional<detail::BufferRing> buffers; ///< Kernel-selected buffers.
+    /// Declared after the buffers so it is torn down before them.
+    std::optional<detail::Ring> ring;
+    std::atomic<std::size_t> connections{0}; ///< Accepted connections.
+    std::atomic<std::size_t> datagrams{0};   ///< Received datagrams.
+    std::atomic<std::size_t> bytes{0};       ///< Received bytes.
+    std::atomic<std::size_t> sentences{0};   ///< Dispatched sentences.
+    std::atomic<std::size_t> errors{0};      ///< Unparsed sentences.
+    std::atomic<std::size_t> syscalls{0};    ///< System calls.
+    std::atomic<std::size_t> evictions{0};   ///< Forgotten UDP senders.
+  };
+
+  /**
+   * @brief Adds to a counter that only the calling worker writes.
+   * @param counter The counter to increment.
+   * @param amount The amount to add.
+   * @return  void    This function does not return a value.
+   */
+  static void count(std::atomic<std::size_t> &counter, std::size_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Queues a multishot receive that selects from the buffer ring.
+   * @param worker The worker.
+   * @param opcode IORING_OP_RECV or IORING_OP_RECVMSG.
+   * @param fd The socket.
+   * @param user_data The completion tag.
+   * @return  io_uring_sqe&   The queued entry, to set opcode arguments.
+   */
+  static io_uring_sqe &queue_receive(Worker &worker, std::uint8_t opcode,
+                                     int fd, std::uint64_t user_data) {
+    io_uring_sqe &sqe = worker.ring->next_sqe();
+    sqe.opcode = opcode;
+    sqe.fd = fd;
+    sqe.flags = IOSQE_BUFFER_SELECT;
+    sqe.buf_group = 0;
+    sqe.ioprio = IORING_RECV_MULTISHOT;
+    sqe.user_data = user_data;
+    return sqe;
+  }
+
+  /**
+   * @brief Queues a multishot recvmsg on the UDP socket.
+   * @param worker The worker.
+   * @return  void    This function does not return a value.
+   */
+  static void arm_datagrams(Worker &worker) {
+    io_uring_sqe &sqe = queue_receive(worker, IORING_OP_RECVMSG,
+                                      worker.udp.get(), DATAGRAM_TAG);
+    sqe.addr = reinterpret_cast<std::uintptr_t>(&worker.udp_header);
+    sqe.len = 1;
+  }
+
+  /**
+   * @brief Queues a multishot accept on the listening socket.
+   * @param worker The worker.
+   * @return  void    This function does not return a value.
+   */
+  static void arm_accept(Worker &worker) {
+    io_uring_sqe &sqe = worker.ring->next_sqe();
+    sqe.opcode = IORING_OP_ACCEPT;
+    sqe.fd = worker.tcp.get();
+    sqe.ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe.accept_flags = SOCK_CLOEXEC;
+    sqe.user_data = ACCEPT_TAG;
+  }
+
+  /**
+   * @brief Runs a worker's event loop until the server stops.
+   * @param worker The worker.
+   * @return  void    This function does not return a value.
+   */
+  void run(Worker &worker) {
+    // The eventfd is never drained, so the poll completes in every worker.
+    io_uring_sqe &stop = worker.ring->next_sqe();
+    stop.opcode = IORING_OP_POLL_ADD;
+    stop.fd = stop_event_.get();
+    stop.poll32_events = POLLIN;
+    stop.user_data = STOP_TAG;
+
+    if (worker.udp) {
+      arm_datagrams(worker);
+    }
+    if (worker.tcp) {
+      arm_accept(worker);
+    }
+
+    bool stopping = false;
+
+    while (!stopping) {
+      int result = worker.ring->submit(1);
+      count(worker.syscalls);
+
+      if (result < 0 && result != -EINTR && result != -EBUSY) {
+        return;
+      }
+
+      worker.ring->drain([&](const io_uring_cqe &cqe) {
+        switch (cqe.user_data & TAG_MASK) {
+        case STOP_TAG:
+          stopping = true;
+          break;
+        case DATAGRAM_TAG:
+          receive_datagram(worker, cqe);
+          break;
+        case ACCEPT_TAG:
+          accept_connection(worker, cqe);
+          break;
+        case STREAM_TAG:
+          receive_stream(worker, cqe);
+          break;
+        }
+      });
+    }
+  }
+
+  /**
+   * @brief Handles a datagram completion.
+   * @param worker The worker.
+   * @param cqe The completion.
+   * @return  void    This function does not return a value.
+   */
+  void receive_datagram(Worker &worker, const io_uring_cqe &cqe) {
+    if (cqe.res >= 0 && (cqe.flags & IORING_CQE_F_BUFFER)) {
+      auto id =
+          static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+      char *buffer = worker.buffers->buffer(id);
+      auto size = static_cast<std::size_t>(cqe.res);
+
+      // The buffer holds a header, the sender address and the payload.
+      io_uring_recvmsg_out header;
+      std::size_t name = sizeof(header);
+      std::size_t payload = name + worker.udp_header.msg_namelen;
+
+      if (size >= payload) {
+        std::memcpy(&header, buffer, sizeof(header));
+        sockaddr_in sender{};
+        std::memcpy(&sender, buffer + name, sizeof(sender));
+
+        std::uint64_t source = source_id(sender);
+        auto [context, evicted] = worker.peers.acquire(source);
+        if (evicted) {
+          count(worker.evictions);
+        }
+        auto dispatch_line = [&](std::string_view line) {
+          dispatch(worker, source, context, line);
+        };
+
+        std::string_view data{buffer + payload,
+                              std::min<std::size_t>(header.payloadlen,
+                                                    size - payload)};
+        SentenceFramer<> framer;
+        framer.push(data, dispatch_line);
+        framer.flush(dispatch_line);
+
+        count(worker.datagrams);
+        count(worker.bytes, data.size());
+      }
+
+      worker.buffers->recycle(id);
+    }
+
+    if (!(cqe.flags & IORING_CQE_F_MORE)) {
+      arm_datagrams(worker);
+    }
+  }
+
+  /**
+   * @brief Handles an accept completion and arms a receive on the new
+   * connection.
+   * @param worker The worker.
+   * @param cqe The completion.
+   * @return  void    This function does not return a value.
+   */
+  void accept_connection(Worker &worker, const io_uring_cqe &cqe) {
+    if (cqe.res >= 0) {
+      int fd = cqe.res;
+      sockaddr_in peer{};
+      socklen_t length = sizeof(peer);
+
+      ::getpeername(fd, reinterpret_cast<sockaddr *>(&peer), &length);
+      count(worker.syscalls);
+
+      worker.streams.insert_or_assign(
+          fd, Connection{detail::FileDescriptor{fd}, source_id(peer), {}, {}});
+      queue_receive(worker, IORING_OP_RECV, fd,
+                    STREAM_TAG | static_cast<std::uint32_t>(fd));
+      count(worker.connections);
+    }
+
+    if (!(cqe.flags & IORING_CQE_F_MORE)) {
+      arm_accept(worker);
+    }
+  }
+
+  /**
+   * @brief Handles a stream completion, closing the connection on end of
+   * stream or error.
+   * @param worker The worker.
+   * @param cqe The completion.
+   * @return  void    This function does not return a value.
+   */
+  void receive_stream(Worker &worker, const io_uring_cqe &cqe) {
+    auto fd = static_cast<int>(cqe.user_data & ~TAG_MASK);
+    auto it = worker.streams.find(fd);
+    bool more = cqe.flags & IORING_CQE_F_MORE;
+
+    if (cqe.res > 0 && (cqe.flags & IORING_CQE_F_BUFFER)) {
+      auto id =
+          static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+
+      if (it != worker.streams.end()) {
+        Connection &connection = it->second;
+        auto size = static_cast<std::size_t>(cqe.res);
+
+        count(worker.bytes, size);
+        connection.framer.push(
+            {worker.buffers->buffer(id), size}, [&](std::string_view line) {
+              dispatch(worker, connection.source, connection.context, line);
+            });
+      }
+
+      worker.buffers->recycle(id);
+    }
+
+    if (more || it == worker.streams.end()) {
+      return;
+    }
+
+    // A receive that ran out of buffers or data simply needs re-arming.
+    if (cqe.res > 0 || cqe.res == -ENOBUFS) {
+      queue_receive(worker, IORING_OP_RECV, fd, cqe.user_data);
+      return;
+    }
+
+    Connection &connection = it->second;
+    connection.framer.flush([&](std::string_view line) {
+      dispatch(worker, connection.source, connection.context, line);
+    });
+    worker.streams.erase(it);
+  }
+
+  /**
+   * @brief Parses a sentence and passes it to the handler.
+   * @param worker The worker.
+   * @param source The source identifier.
+   * @param context The parse state of the source.
+   * @param line The raw sentence.
+   * @return  void    This function does not return a value.
+   */
+  void dispatch(Worker &worker, std::uint64_t source, ParseContext &context,
+                std::string_view line) {
+    auto sample = parse(line, context);
+
+    if (!sample) {
+      count(worker.errors);
+      return;
+    }
+
+    handler_(source, line, *sample);
+    count(worker.sentences);
+  }
+
+  detail::FileDescriptor stop_event_;            ///< Wakes workers to stop.
+  std::vector<std::unique_ptr<Worker>> workers_; ///< Per-thread state.
+  std::vector<std::jthread> threads_;            ///< Worker threads.
+#endif
+
+  ServerOptions options_; ///< Server configuration.
+  Handler handler_;       ///< Sentence callback.
+  std::uint16_t port_{0}; ///< Bound port.
+  /// Epoll server used when io_uring is not available.
+  std::optional<IngestServer<std::reference_wrapper<Handler>>> fallback_;
+};
+#endif
+} // namespace gps_lib
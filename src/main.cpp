@@ -1,11 +1,15 @@
 #include <cstdlib>
 #include <filesystem>
 #include <print>
+#include <string>
+#include <string_view>
 
 #include "json.h"
+#include "metrics.h"
 #include "parse.h"
 #include "print.h"
 #include "tools.h"
+#include "trace.h"
 
 int main() {
   std::filesystem::path exe_path = std::filesystem::current_path();
@@ -19,10 +23,11 @@ int main() {
   }
 
   std::string line;
+  gps_lib::ParseContext context;
 
   while (std::getline(file, line)) {
     if (gps_lib::is_valid_sample(line)) {
-      auto data = gps_lib::parse(line);
+      auto data = gps_lib::parse(line, context);
       gps_lib::print_sample(data);
     } else {
       std::println("Invalid sample: {}", line);
@@ -41,5 +46,19 @@ int main() {
     std::println("Failed to parse sample for JSON export.");
   }
 
+#ifdef GPS_LIB_METRICS
+  if (!gps_lib::write_prometheus(exe_path / "data/metrics.prom")) {
+    std::println("Failed to write parser metrics.");
+  }
+#endif
+
+#ifdef GPS_LIB_TRACE
+  if (!gps_lib::save_trace(exe_path / "data/trace.bin") ||
+      !gps_lib::trace_to_chrome_json(exe_path / "data/trace.bin",
+                                     exe_path / "data/trace.json")) {
+    std::println("Failed to write parser trace.");
+  }
+#endif
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include "allocations.h"
+#include "check.h"
+#include "parse.h"
+
+GPS_LIB_COUNT_ALLOCATIONS();
+
+namespace {
+/**
+ * @brief Allocations made by one library call, per sentence type.
+ */
+struct AllocationCheck {
+  std::string_view name; ///< Function measured.
+  std::size_t limit;     ///< Allowed per call.
+  std::array<std::size_t, std::variant_size_v<gps_lib::Sample>>
+      calls{}; ///< Calls measured, by sentence type.
+  std::array<std::size_t, std::variant_size_v<gps_lib::Sample>>
+      worst{}; ///< Most allocations in one call, by sentence type.
+
+  /**
+   * @brief Adds the allocations of one call.
+   * @param type The index in Sample of the sentence type.
+   * @param count The allocations of the call.
+   * @return  void    This function does not return a value.
+   */
+  void add(std::size_t type, gps_lib::AllocationCount count) {
+    worst[type] = std::max(worst[type], count.allocations);
+    ++calls[type];
+  }
+
+  /**
+   * @brief Checks every sentence type against the budget.
+   * @return  void    This function does not return a value.
+   */
+  void verify() const {
+    for (std::size_t type = 0; type < calls.size(); ++type) {
+      if (calls[type] != 0 && !CHECK(worst[type] <= limit)) {
+        std::println(stderr, "{} {}: {} allocations in one call, budget {}",
+                     name, gps_lib::SENTENCE_NAMES[type], worst[type], limit);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Every hot-path call on every sentence of the sample log stays
+ * within its allocation budget. parse() may allocate the satellite list of
+ * a new sample; parse_into() into a warm sample and is_valid_sample() must
+ * not allocate at all.
+ *
+ * With GPS_LIB_METRICS the first parse of a thread leases the thread's
+ * counter block, a one-off that the warm-up parse takes before counting.
+ */
+void hot_paths_within_budget() {
+  std::array<AllocationCheck, 3> checks{
+      {{"is_valid_sample", 0}, {"parse", 1}, {"parse_into", 0}}};
+  std::ifstream file{"data/samples.txt"};
+  std::string line;
+  gps_lib::ParseContext context;
+  gps_lib::ParseContext reuse_context;
+  std::array<std::optional<gps_lib::Sample>,
+             std::variant_size_v<gps_lib::Sample>>
+      reused;
+  std::size_t lines = 0;
+
+  static_cast<void>(gps_lib::parse(
+      "$GNRMC,211041.00,A,4024.98796,N,00340.22512,W,0.027,,010218,,,D*7B"));
+
+  while (std::getline(file, line)) {
+    ++lines;
+
+    bool valid = false;
+    auto validate = gps_lib::count_allocations(
+        [&] { valid = gps_lib::is_valid_sample(line); });
+    std::expected<gps_lib::Sample, gps_lib::ParseError> result;
+    auto parse = gps_lib::count_allocations(
+        [&] { result = gps_lib::parse(line, context); });
+
+    CHECK(valid && result);
+    if (!valid || !result) {
+      continue;
+    }
+
+    std::size_t type = result->index();
+    checks[0].add(type, validate);
+    checks[1].add(type, parse);
+
+    // The first sentence of each type only warms up the reused sample.
+    if (reused[type]) {
+      checks[2].add(type, gps_lib::count_allocations([&] {
+        static_cast<void>(
+            gps_lib::parse_into(*reused[type], line, reuse_context));
+      }));
+    } else {
+      reused[type].emplace(*result);
+      static_cast<void>(
+          gps_lib::parse_into(*reused[type], line, reuse_context));
+    }
+  }
+
+  CHECK(lines > 1000);
+  for (const AllocationCheck &check : checks) {
+    check.verify();
+  }
+}
+} // namespace
+
+int main() {
+  hot_paths_within_budget();
+
+  return gps_lib::test::result();
+}
@@ -0,0 +1,102 @@
+#include <cstddef>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "allocations.h"
+#include "arena.h"
+#include "check.h"
+#include "parse.h"
+
+GPS_LIB_COUNT_ALLOCATIONS();
+
+namespace {
+/**
+ * @brief Reads the sample log.
+ * @return  std::vector<std::string>    Its lines.
+ */
+std::vector<std::string> read_samples() {
+  std::ifstream file{"data/samples.txt"};
+  std::vector<std::string> lines;
+
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+
+  return lines;
+}
+
+/**
+ * @brief Parses a batch into an arena.
+ * @param arena The arena.
+ * @param lines The sentences.
+ * @return  void    This function does not return a value.
+ */
+void parse_batch(gps_lib::SampleArena &arena,
+                 const std::vector<std::string> &lines) {
+  gps_lib::ParseContext context{.resource = arena.resource()};
+
+  arena.samples().reserve(lines.size());
+  for (const std::string &line : lines) {
+    if (auto sample = gps_lib::parse(line, context)) {
+      arena.samples().push_back(std::move(*sample));
+    }
+  }
+}
+
+/**
+ * @brief Samples parsed into an arena keep their members in it.
+ */
+void members_in_arena() {
+  std::vector<std::string> lines = read_samples();
+  gps_lib::SampleArena arena{4 * gps_lib::SampleArena::DEFAULT_SIZE};
+
+  parse_batch(arena, lines);
+  CHECK(arena.samples().size() == lines.size());
+
+  bool inside = true;
+  for (const gps_lib::Sample &sample : arena.samples()) {
+    if (const auto *gsa = std::get_if<gps_lib::GSA>(&sample)) {
+      inside =
+          inside && gsa->pdop.get_allocator().resource() == arena.resource();
+    } else if (const auto *rmc = std::get_if<gps_lib::RMC>(&sample)) {
+      inside =
+          inside && rmc->speed.get_allocator().resource() == arena.resource();
+    }
+  }
+  CHECK(inside);
+
+  arena.reset();
+  CHECK(arena.samples().empty());
+}
+
+/**
+ * @brief Once warm, an arena parses a batch of the same size without
+ * touching the heap, and reset() keeps it that way for the next batch.
+ */
+void warm_batches_do_not_allocate() {
+  std::vector<std::string> lines = read_samples();
+  gps_lib::SampleArena arena{4 * gps_lib::SampleArena::DEFAULT_SIZE};
+
+  parse_batch(arena, lines);
+  arena.reset();
+
+  for (int batch = 0; batch < 3; ++batch) {
+    gps_lib::AllocationCount count =
+        gps_lib::count_allocations([&] { parse_batch(arena, lines); });
+    CHECK(count.allocations == 0);
+    CHECK(arena.samples().size() == lines.size());
+    arena.reset();
+  }
+}
+} // namespace
+
+int main() {
+  members_in_arena();
+  warm_batches_do_not_allocate();
+
+  return gps_lib::test::result();
+}
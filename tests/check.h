@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <print>
+#include <source_location>
+#include <string_view>
+
+/**
+ * @namespace gps_lib::test
+ * @brief Minimal checking helpers shared by the test executables.
+ */
+namespace gps_lib::test {
+/**
+ * @brief Returns the number of failed checks so far.
+ * @return  int&    The failure count.
+ */
+inline int &failures() {
+  static int count = 0;
+  return count;
+}
+
+/**
+ * @brief Records a check, reporting it if it failed.
+ * @param passed The result of the check.
+ * @param expression The checked expression, as written.
+ * @param location Where the check was made.
+ * @return  bool    The result of the check.
+ */
+inline bool check(bool passed, std::string_view expression,
+                  std::source_location location) {
+  if (!passed) {
+    std::println(stderr, "{}:{}: check failed: {}", location.file_name(),
+                 location.line(), expression);
+    ++failures();
+  }
+  return passed;
+}
+
+/**
+ * @brief Returns the exit status of the test executable.
+ * @return  int     EXIT_SUCCESS if every check passed.
+ */
+inline int result() { return failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE; }
+} // namespace gps_lib::test
+
+/**
+ * @brief Checks a condition, reporting it with its location if it fails.
+ *
+ * Unlike assert(), checks run in every build type and do not stop the test.
+ */
+#define CHECK(...)                                                             \
+  gps_lib::test::check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__,           \
+                       std::source_location::current())
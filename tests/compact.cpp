@@ -0,0 +1,387 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "check.h"
+#include "compact.h"
+#include "parse.h"
+
+namespace {
+/**
+ * @brief Sentences of the types data/samples.txt does not contain.
+ */
+constexpr std::array<std::string_view, 8> OTHER_TYPES{
+    "$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*76",
+    "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K,A*25",
+    "$GPZDA,201530.00,04,07,2002,-03,30*4D",
+    "$GPGST,172814.0,0.006,0.023,0.020,273.6,0.023,0.020,0.031*6A",
+    "$GNGBS,015509.00,0.03,0.19,0.22,19,0.0000,-0.35,6.97,1,1*59",
+    "$GNGNS,014035.00,4332.69262,S,17235.48549,E,RRA,13,0.9,25.63,11.24,,*31",
+    "$GNRMB,A,4.08,R,EGLL,EGLM,5130.02,N,00046.34,W,004.6,213.9,-12.9,A,D*4A",
+    "$GPHDT,274.07,T*03"};
+
+/**
+ * @brief Checks that a numeric field survived a round trip, to the
+ * precision of its compact record.
+ * @param parsed The field as parsed.
+ * @param expanded The field as expanded.
+ * @param decimals Decimal digits the compact record keeps.
+ * @return  bool    True if both are empty or differ by at most half a unit.
+ */
+bool same_number(std::string_view parsed, std::string_view expanded,
+                 int decimals = 0) {
+  auto before = gps_lib::detail::parse_number(parsed);
+  auto after = gps_lib::detail::parse_number(expanded);
+
+  if (!before || !after) {
+    return !before && !after;
+  }
+  return std::abs(*before - *after) <= 0.5 * std::pow(10.0, -decimals) + 1e-9;
+}
+
+/**
+ * @brief Checks that a coordinate survived a round trip to 1e-7 degrees.
+ * @param parsed The coordinate as parsed.
+ * @param expanded The coordinate as expanded.
+ * @return  bool    True if the values and directions match.
+ */
+template <typename Coordinate>
+bool same_coordinate(const Coordinate &parsed, const Coordinate &expanded) {
+  return std::abs(parsed.value - expanded.value) <= 1e-7 &&
+         parsed.direction == expanded.direction;
+}
+
+/**
+ * @brief Checks every field a compact record keeps.
+ * @param parsed The sentence as parsed.
+ * @param expanded The sentence as expanded from its compact record.
+ */
+void check_same(const gps_lib::GGA &parsed, const gps_lib::GGA &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(parsed.utc_time == expanded.utc_time);
+  CHECK(same_coordinate(parsed.latitude, expanded.latitude));
+  CHECK(same_coordinate(parsed.longitude, expanded.longitude));
+  CHECK(parsed.quality == expanded.quality);
+  CHECK(same_number(parsed.satellites_used, expanded.satellites_used));
+  CHECK(same_number(parsed.hdop, expanded.hdop, 2));
+  CHECK(same_number(parsed.altitude, expanded.altitude, 3));
+  CHECK(same_number(parsed.geoidal_separation, expanded.geoidal_separation,
+                    3));
+  CHECK(same_number(parsed.dgps, expanded.dgps));
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::GLL &parsed, const gps_lib::GLL &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(same_coordinate(parsed.latitude, expanded.latitude));
+  CHECK(same_coordinate(parsed.longitude, expanded.longitude));
+  CHECK(parsed.utc_time == expanded.utc_time);
+  CHECK(parsed.status == expanded.status);
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::GSA &parsed, const gps_lib::GSA &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(parsed.mode == expanded.mode);
+  CHECK(parsed.fix_type == expanded.fix_type);
+  CHECK(same_number(parsed.pdop, expanded.pdop, 2));
+  CHECK(same_number(parsed.hdop, expanded.hdop, 2));
+  CHECK(same_number(parsed.vdop, expanded.vdop, 2));
+
+  // Empty slots are dropped and the rest moved to the front.
+  std::size_t next = 0;
+  for (std::uint16_t id : parsed.satellites) {
+    if (id != 0) {
+      CHECK(expanded.satellites[next++] == id);
+    }
+  }
+  for (; next < expanded.satellites.size(); ++next) {
+    CHECK(expanded.satellites[next] == 0);
+  }
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::GSV &parsed, const gps_lib::GSV &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(same_number(parsed.number_of_messages, expanded.number_of_messages));
+  CHECK(same_number(parsed.sequence_number, expanded.sequence_number));
+  CHECK(same_number(parsed.satellites_in_view, expanded.satellites_in_view));
+
+  if (!CHECK(parsed.satellites.size() == expanded.satellites.size())) {
+    return;
+  }
+  for (std::size_t i = 0; i < parsed.satellites.size(); ++i) {
+    const gps_lib::Satellite &before = parsed.satellites[i];
+    const gps_lib::Satellite &after = expanded.satellites[i];
+    CHECK(before.id == after.id);
+    CHECK(same_number(before.elevation, after.elevation));
+    CHECK(same_number(before.azimuth, after.azimuth));
+    CHECK(same_number(before.snr, after.snr));
+  }
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::RMC &parsed, const gps_lib::RMC &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(parsed.utc_time == expanded.utc_time);
+  CHECK(parsed.status == expanded.status);
+  CHECK(same_coordinate(parsed.latitude, expanded.latitude));
+  CHECK(same_coordinate(parsed.longitude, expanded.longitude));
+  CHECK(same_number(parsed.speed, expanded.speed, 3));
+  CHECK(same_number(parsed.course, expanded.course, 2));
+  CHECK(parsed.mode == expanded.mode);
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::VTG &parsed, const gps_lib::VTG &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(same_number(parsed.course, expanded.course, 2));
+  CHECK(same_number(parsed.course_magnetic, expanded.course_magnetic, 2));
+  CHECK(same_number(parsed.speed_kn, expanded.speed_kn, 3));
+  CHECK(same_number(parsed.speed_kh, expanded.speed_kh, 3));
+  CHECK(parsed.mode == expanded.mode);
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::ZDA &parsed, const gps_lib::ZDA &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(parsed.utc_time == expanded.utc_time);
+  CHECK(same_number(parsed.local_zone_hours, expanded.local_zone_hours));
+  CHECK(same_number(parsed.local_zone_minutes, expanded.local_zone_minutes));
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::GST &parsed, const gps_lib::GST &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(parsed.utc_time == expanded.utc_time);
+  CHECK(same_number(parsed.rms, expanded.rms, 3));
+  CHECK(same_number(parsed.semi_major_error, expanded.semi_major_error, 3));
+  CHECK(same_number(parsed.semi_minor_error, expanded.semi_minor_error, 3));
+  CHECK(same_number(parsed.orientation, expanded.orientation, 2));
+  CHECK(same_number(parsed.latitude_error, expanded.latitude_error, 3));
+  CHECK(same_number(parsed.longitude_error, expanded.longitude_error, 3));
+  CHECK(same_number(parsed.altitude_error, expanded.altitude_error, 3));
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::GBS &parsed, const gps_lib::GBS &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(parsed.utc_time == expanded.utc_time);
+  CHECK(same_number(parsed.latitude_error, expanded.latitude_error, 2));
+  CHECK(same_number(parsed.longitude_error, expanded.longitude_error, 2));
+  CHECK(same_number(parsed.altitude_error, expanded.altitude_error, 2));
+  CHECK(parsed.failed_satellite == expanded.failed_satellite);
+  CHECK(same_number(parsed.probability, expanded.probability, 4));
+  CHECK(same_number(parsed.bias, expanded.bias, 2));
+  CHECK(same_number(parsed.bias_deviation, expanded.bias_deviation, 2));
+  CHECK(parsed.system_id == expanded.system_id);
+  CHECK(parsed.signal_id == expanded.signal_id);
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::GNS &parsed, const gps_lib::GNS &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(parsed.utc_time == expanded.utc_time);
+  CHECK(same_coordinate(parsed.latitude, expanded.latitude));
+  CHECK(same_coordinate(parsed.longitude, expanded.longitude));
+  CHECK(parsed.mode == expanded.mode);
+  CHECK(same_number(parsed.satellites_used, expanded.satellites_used));
+  CHECK(same_number(parsed.hdop, expanded.hdop, 2));
+  CHECK(same_number(parsed.altitude, expanded.altitude, 3));
+  CHECK(same_number(parsed.geoidal_separation, expanded.geoidal_separation,
+                    3));
+  CHECK(same_number(parsed.dgps, expanded.dgps));
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::RMB &parsed, const gps_lib::RMB &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(parsed.status == expanded.status);
+  CHECK(same_number(parsed.cross_track_error, expanded.cross_track_error, 2));
+  CHECK(parsed.steer == expanded.steer);
+  CHECK(parsed.origin == expanded.origin);
+  CHECK(parsed.destination == expanded.destination);
+  CHECK(same_coordinate(parsed.destination_latitude,
+                        expanded.destination_latitude));
+  CHECK(same_coordinate(parsed.destination_longitude,
+                        expanded.destination_longitude));
+  CHECK(same_number(parsed.range, expanded.range, 2));
+  CHECK(same_number(parsed.bearing, expanded.bearing, 2));
+  CHECK(same_number(parsed.closing_velocity, expanded.closing_velocity, 2));
+  CHECK(parsed.arrival == expanded.arrival);
+  CHECK(parsed.mode == expanded.mode);
+}
+
+/// @copydoc check_same(const gps_lib::GGA &, const gps_lib::GGA &)
+void check_same(const gps_lib::HDT &parsed, const gps_lib::HDT &expanded) {
+  CHECK(parsed.type == expanded.type);
+  CHECK(same_number(parsed.heading, expanded.heading, 2));
+}
+
+/**
+ * @brief Every sentence of the sample log, and one of each type the log
+ * lacks, comes back from push_back() and expand() with the same fields, to
+ * the precision of its compact record.
+ */
+void round_trip() {
+  std::vector<std::string> lines;
+  std::ifstream file{"data/samples.txt"};
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  CHECK(lines.size() > 1000);
+  lines.insert(lines.end(), OTHER_TYPES.begin(), OTHER_TYPES.end());
+
+  gps_lib::ParseContext context;
+  std::vector<gps_lib::Sample> parsed;
+  gps_lib::CompactBatch batch;
+
+  for (const std::string &line : lines) {
+    auto result = gps_lib::parse(line, context);
+    if (CHECK(result.has_value())) {
+      batch.push_back(*result);
+      parsed.push_back(std::move(*result));
+    }
+  }
+
+  std::array<std::size_t, std::variant_size_v<gps_lib::Sample>> seen{};
+  CHECK(batch.size() == parsed.size());
+
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    gps_lib::Sample expanded = batch.expand(i);
+    if (!CHECK(expanded.index() == parsed[i].index())) {
+      continue;
+    }
+
+    ++seen[parsed[i].index()];
+    std::visit(
+        [&](const auto &before) {
+          using T = std::decay_t<decltype(before)>;
+          check_same(before, std::get<T>(expanded));
+        },
+        parsed[i]);
+  }
+
+  for (std::size_t count : seen) {
+    CHECK(count > 0);
+  }
+}
+
+/**
+ * @brief A GNS mode keeps its first four indicators.
+ */
+void gns_mode_limit() {
+  gps_lib::GNS gns;
+  gns.mode = "ADNRF";
+  gps_lib::CompactBatch batch;
+  batch.push_back(gns);
+
+  CHECK(std::get<gps_lib::GNS>(batch.expand(0)).mode == "ADNR");
+}
+
+/**
+ * @brief RMB sentences parse with and without the NMEA 2.3 mode, and their
+ * waypoint IDs, of any length, are kept out of line. HDT needs its unit
+ * field.
+ */
+void rmb_and_hdt() {
+  constexpr std::array<std::string_view, 2> LINES{
+      "$GPRMB,A,0.66,L,003,004,4917.24,N,12309.57,W,001.3,052.5,000.5,V*20",
+      "$GNRMB,A,4.08,R,EGLL,EGLM,5130.02,N,00046.34,W,004.6,213.9,-12.9,A,"
+      "D*4A"};
+
+  gps_lib::CompactBatch batch;
+  for (std::string_view line : LINES) {
+    auto result = gps_lib::parse(line);
+    if (CHECK(result.has_value())) {
+      batch.push_back(*result);
+    }
+  }
+
+  if (CHECK(batch.size() == 2)) {
+    gps_lib::Sample expanded = batch.expand(0);
+    const auto &first = std::get<gps_lib::RMB>(expanded);
+    CHECK(first.status == 'A' && first.steer == 'L' && first.arrival == 'V');
+    CHECK(first.mode == '\0');
+    CHECK(first.cross_track_error == "0.66");
+    CHECK(std::abs(first.destination_latitude.value - (49 + 17.24 / 60)) <
+          1e-7);
+    CHECK(first.destination_longitude.direction == 'W');
+    CHECK(first.closing_velocity == "0.50");
+
+    std::span<const gps_lib::CompactSample> samples = batch.samples();
+    CHECK(batch.origin(samples[0]) == "003");
+    CHECK(batch.destination(samples[0]) == "004");
+    CHECK(batch.origin(samples[1]) == "EGLL");
+    CHECK(batch.destination(samples[1]) == "EGLM");
+
+    expanded = batch.expand(1);
+    const auto &second = std::get<gps_lib::RMB>(expanded);
+    CHECK(second.mode == 'D');
+    CHECK(second.closing_velocity == "-12.90");
+  }
+
+  gps_lib::RMB long_ids;
+  long_ids.origin.assign(300, 'O');
+  long_ids.destination = "D";
+  batch.push_back(long_ids);
+  gps_lib::Sample truncated = batch.expand(2);
+  const auto &cut = std::get<gps_lib::RMB>(truncated);
+  CHECK(cut.origin == std::string_view{std::string(255, 'O')} &&
+        cut.destination == "D");
+
+  auto hdt = gps_lib::parse("$GPHDT,274.07,T*03");
+  CHECK(hdt.has_value() && std::get<gps_lib::HDT>(*hdt).heading == "274.07");
+  CHECK(gps_lib::parse("$HEHDT,274.07*61").error() ==
+        gps_lib::ParseError::MissingFields);
+  CHECK(gps_lib::parse("$GPRMB,A,0.66,L,003,004,4917.24,X,12309.57,W,001.3,"
+                       "052.5,000.5,V*36")
+            .error() == gps_lib::ParseError::InvalidDirection);
+}
+
+/**
+ * @brief A talker without a name keeps its characters through parse(),
+ * formatting and a compact round trip.
+ */
+void unknown_talker() {
+  constexpr std::array<std::string_view, 2> LINES{
+      "$BDGSA,A,3,07,10,21,,,,,,,,,,2.1,1.2,1.7*20",
+      "$GBGSV,1,1,02,07,45,120,38,10,30,200,35*61"};
+  constexpr std::array<std::string_view, 2> ADDRESSES{"$BDGSA", "$GBGSV"};
+
+  gps_lib::ParseContext context;
+  gps_lib::CompactBatch batch;
+
+  for (std::size_t i = 0; i < LINES.size(); ++i) {
+    auto result = gps_lib::parse(LINES[i], context);
+    if (!CHECK(result.has_value())) {
+      continue;
+    }
+
+    batch.push_back(*result);
+    auto address = [](const auto &data) {
+      return std::format("{}", data.type);
+    };
+    CHECK(std::visit(address, *result) == ADDRESSES[i]);
+    CHECK(std::visit(address, batch.expand(batch.size() - 1)) ==
+          ADDRESSES[i]);
+  }
+}
+} // namespace
+
+int main() {
+  round_trip();
+  gns_mode_limit();
+  rmb_and_hdt();
+  unknown_talker();
+
+  return gps_lib::test::result();
+}
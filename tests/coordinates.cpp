@@ -0,0 +1,83 @@
+#include <cmath>
+
+#include "check.h"
+#include "detail/parse_degrees_minutes.h"
+#include "detail/parse_latitude.h"
+#include "detail/parse_longitude.h"
+
+using gps_lib::ParseError;
+using gps_lib::detail::parse_degrees_minutes;
+using gps_lib::detail::parse_latitude;
+using gps_lib::detail::parse_longitude;
+
+// The kernel is constexpr, so its contract is checked at compile time too.
+static_assert(parse_degrees_minutes("4807.038").value() ==
+              48.0 + 7.038 / 60.0);
+static_assert(parse_degrees_minutes("00000.000").value() == 0.0);
+static_assert(parse_degrees_minutes("").error() == ParseError::MissingFields);
+static_assert(parse_degrees_minutes("12").error() == ParseError::InvalidFormat);
+static_assert(parse_degrees_minutes("4860.000").error() ==
+              ParseError::InvalidFormat);
+static_assert(parse_degrees_minutes("48a7.038").error() ==
+              ParseError::InvalidFormat);
+static_assert(parse_degrees_minutes("180000.0").error() ==
+              ParseError::InvalidFormat);
+static_assert(parse_latitude("4807.038", "S").value().value < 0.0);
+static_assert(parse_longitude("01131.000", "E").value().value > 0.0);
+
+namespace {
+/**
+ * @brief Compares two coordinates to well below the NMEA resolution.
+ */
+bool near(double a, double b) { return std::abs(a - b) < 1e-12; }
+
+void hemispheres() {
+  CHECK(near(parse_latitude("4807.038", "N")->value, 48.1173));
+  CHECK(near(parse_latitude("4807.038", "S")->value, -48.1173));
+  CHECK(near(parse_longitude("01131.000", "E")->value, 11.516666666666667));
+  CHECK(near(parse_longitude("01131.000", "W")->value, -11.516666666666667));
+  CHECK(parse_latitude("4807.038", "S")->direction == 'S');
+  CHECK(parse_latitude("4807.038", "E").error() ==
+        ParseError::InvalidDirection);
+  CHECK(parse_longitude("01131.000", "").error() ==
+        ParseError::InvalidDirection);
+}
+
+void edges() {
+  CHECK(parse_latitude("0000.0000", "N")->value == 0.0);
+  CHECK(parse_latitude("9000.0000", "S")->value == -90.0);
+  CHECK(parse_longitude("18000.0000", "W")->value == -180.0);
+  CHECK(parse_longitude("00000.0000", "E")->value == 0.0);
+  CHECK(!parse_latitude("9000.0001", "N"));
+  CHECK(!parse_longitude("18000.0001", "E"));
+  CHECK(near(*parse_degrees_minutes("8959.999999999"),
+             89.0 + 59.999999999 / 60.0));
+}
+
+void malformed() {
+  CHECK(parse_degrees_minutes("").error() == ParseError::MissingFields);
+  CHECK(parse_degrees_minutes(".5").error() == ParseError::InvalidFormat);
+  CHECK(parse_degrees_minutes("-4807.038").error() ==
+        ParseError::InvalidFormat);
+  CHECK(parse_degrees_minutes("4807.03 8").error() ==
+        ParseError::InvalidFormat);
+  CHECK(parse_degrees_minutes("4807.0380000000").error() ==
+        ParseError::InvalidFormat);
+  CHECK(parse_degrees_minutes("4807..038").error() ==
+        ParseError::InvalidFormat);
+
+  // Without the digit bound these wrap the 64-bit mantissa into a value
+  // that passes the range checks.
+  CHECK(!parse_latitude("1844674407370955161600.0", "N"));
+  CHECK(!parse_longitude("00000000000000000000004807.038", "E"));
+  CHECK(!parse_latitude("000004807.038", "N"));
+}
+} // namespace
+
+int main() {
+  hemispheres();
+  edges();
+  malformed();
+
+  return gps_lib::test::result();
+}
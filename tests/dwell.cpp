@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <variant>
+#include <vector>
+
+#include "check.h"
+#include "dwell.h"
+
+namespace {
+constexpr double NaN{std::numeric_limits<double>::quiet_NaN()};
+
+constexpr double MAX_SPEED{0.5};    ///< Stationary speed threshold in m/s.
+constexpr double RADIUS{10.0};      ///< Jitter radius in meters.
+constexpr std::size_t MIN_FIXES{5}; ///< Fixes needed to confirm a dwell.
+constexpr double LATITUDE{40.4};    ///< Latitude of the test area.
+constexpr double LONGITUDE{-3.67};  ///< Longitude of the test area.
+
+/// What a detector emits.
+using Output = std::variant<gps_lib::Fix, gps_lib::Dwell>;
+
+/**
+ * @brief Returns a fix at an offset from the origin of the test area.
+ * @param second The time in seconds, which identifies the fix.
+ * @param east The offset towards the east in meters.
+ * @param north The offset towards the north in meters.
+ * @param speed The speed in m/s.
+ * @return  gps_lib::Fix    The fix.
+ */
+gps_lib::Fix fix_at(int second, double east, double north, double speed) {
+  double meters = gps_lib::detail::EARTH_RADIUS * gps_lib::detail::DEGTORAD;
+  return {gps_lib::Timestamp{std::chrono::seconds{second}},
+          LATITUDE + north / meters,
+          LONGITUDE +
+              east / (meters * std::cos(LATITUDE * gps_lib::detail::DEGTORAD)),
+          speed, 1.0};
+}
+
+/**
+ * @brief Runs fixes through a detector, then flushes it.
+ * @param fixes The fixes.
+ * @return  std::vector<Output>     The fixes and dwells, in emission order.
+ */
+std::vector<Output> detect(const std::vector<gps_lib::Fix> &fixes) {
+  gps_lib::DwellDetector detector{MAX_SPEED, RADIUS, MIN_FIXES};
+  std::vector<Output> output;
+  auto sink = [&](const auto &item) { output.emplace_back(item); };
+
+  for (const gps_lib::Fix &fix : fixes) {
+    detector.push(fix, sink);
+  }
+  detector.flush(sink);
+  return output;
+}
+
+/**
+ * @brief Checks that an output is a given fix.
+ * @param output The output.
+ * @param fix The expected fix.
+ * @return  bool    True if the output is the fix, unchanged.
+ */
+bool is_fix(const Output &output, const gps_lib::Fix &fix) {
+  const auto *emitted = std::get_if<gps_lib::Fix>(&output);
+  return emitted != nullptr && emitted->utc_time == fix.utc_time &&
+         emitted->latitude == fix.latitude &&
+         emitted->longitude == fix.longitude;
+}
+
+/**
+ * @brief Clusters shorter than min_fixes, whether ended by a fast fix, by
+ * leaving the radius or by the flush, are released as their original fixes
+ * in order.
+ */
+void short_clusters() {
+  std::vector<gps_lib::Fix> fixes{
+      fix_at(0, 0.0, 0.0, 5.0),   fix_at(1, 1.0, 0.0, 0.1),
+      fix_at(2, 2.0, 1.0, 0.2),   fix_at(3, -1.0, 2.0, 0.0),
+      fix_at(4, 50.0, 0.0, 5.0),  fix_at(5, 60.0, 0.0, 0.1),
+      fix_at(6, 61.0, 0.0, 0.1),  fix_at(7, 100.0, 0.0, 0.1),
+      fix_at(8, 101.0, 0.0, 0.1), fix_at(9, 102.0, 0.0, 0.1)};
+
+  std::vector<Output> output = detect(fixes);
+  if (CHECK(output.size() == fixes.size())) {
+    for (std::size_t i = 0; i < fixes.size(); ++i) {
+      CHECK(is_fix(output[i], fixes[i]));
+    }
+  }
+}
+
+/**
+ * @brief A confirmed cluster becomes one dwell, at the mean position of its
+ * fixes, between the fixes around it.
+ */
+void confirmed() {
+  std::vector<gps_lib::Fix> fixes{fix_at(0, -40.0, 0.0, 5.0)};
+  double east = 0.0;
+  double north = 0.0;
+  for (int second = 1; second <= 8; ++second) {
+    double jitter_east = 4.0 * std::sin(second);
+    double jitter_north = 4.0 * std::cos(second * 1.3);
+    fixes.push_back(fix_at(second, jitter_east, jitter_north, 0.2));
+    east += jitter_east;
+    north += jitter_north;
+  }
+  fixes.push_back(fix_at(9, 40.0, 0.0, 5.0));
+
+  std::vector<Output> output = detect(fixes);
+  if (!CHECK(output.size() == 3)) {
+    return;
+  }
+  CHECK(is_fix(output[0], fixes[0]));
+  CHECK(is_fix(output[2], fixes[9]));
+
+  const auto *dwell = std::get_if<gps_lib::Dwell>(&output[1]);
+  if (CHECK(dwell != nullptr)) {
+    gps_lib::Fix mean = fix_at(0, east / 8.0, north / 8.0, 0.0);
+    CHECK(dwell->fixes == 8);
+    CHECK(dwell->start_time == fixes[1].utc_time);
+    CHECK(dwell->end_time == fixes[8].utc_time);
+    CHECK(std::abs(dwell->latitude - mean.latitude) < 1e-9);
+    CHECK(std::abs(dwell->longitude - mean.longitude) < 1e-9);
+  }
+}
+
+/**
+ * @brief Fixes without a speed are judged on position alone: they start
+ * and grow a cluster within the radius, and end it outside.
+ */
+void missing_speed() {
+  std::vector<gps_lib::Fix> fixes;
+  for (int second = 0; second < 6; ++second) {
+    fixes.push_back(fix_at(second, 0.5 * second, 0.0, NaN));
+  }
+  fixes.push_back(fix_at(6, 30.0, 0.0, NaN));
+
+  std::vector<Output> output = detect(fixes);
+  if (CHECK(output.size() == 2)) {
+    const auto *dwell = std::get_if<gps_lib::Dwell>(&output[0]);
+    CHECK(dwell != nullptr && dwell->fixes == 6);
+    CHECK(is_fix(output[1], fixes[6]));
+  }
+}
+} // namespace
+
+int main() {
+  short_clusters();
+  confirmed();
+  missing_speed();
+
+  return gps_lib::test::result();
+}
@@ -0,0 +1,181 @@
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+#include "detail/work_deque.h"
+#include "executor.h"
+
+namespace {
+constexpr std::size_t RECEIVERS{16};
+constexpr std::size_t SUBMITTERS{4};
+
+/**
+ * @brief Records what a receiver's stage is handed, in order.
+ */
+struct Recorder {
+  std::vector<std::string> lines;
+
+  void operator()(std::string_view line, const gps_lib::Sample &) {
+    lines.emplace_back(line);
+  }
+};
+
+/**
+ * @brief Reads the sample log.
+ * @return  std::vector<std::string>    Its lines.
+ */
+std::vector<std::string> read_samples() {
+  std::ifstream file{"data/samples.txt"};
+  std::vector<std::string> lines;
+
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+
+  return lines;
+}
+
+/**
+ * @brief Sentences submitted from several threads reach each receiver's
+ * stage in the order they were submitted, and bad ones are only counted.
+ */
+void order_per_receiver() {
+  std::vector<std::string> lines = read_samples();
+  CHECK(!lines.empty());
+
+  gps_lib::ParseExecutor<Recorder, 8> executor{
+      RECEIVERS, [](std::size_t) { return Recorder{}; },
+      {.threads = 3, .batch = 4}};
+
+  // Each submitter owns every SUBMITTERS-th receiver, and every receiver
+  // gets the whole log starting at a different line, plus one bad sentence.
+  std::vector<std::jthread> submitters;
+  for (std::size_t s = 0; s < SUBMITTERS; ++s) {
+    submitters.emplace_back([&, s] {
+      for (std::size_t i = 0; i < lines.size(); ++i) {
+        for (std::size_t r = s; r < RECEIVERS; r += SUBMITTERS) {
+          executor.submit(r, lines[(i + r) % lines.size()]);
+        }
+      }
+      for (std::size_t r = s; r < RECEIVERS; r += SUBMITTERS) {
+        executor.submit(r, "$GNRMC,garbage*00");
+      }
+    });
+  }
+  submitters.clear();
+  executor.stop();
+
+  for (std::size_t r = 0; r < RECEIVERS; ++r) {
+    const std::vector<std::string> &seen = executor.stage(r).lines;
+    bool ordered = seen.size() == lines.size();
+    for (std::size_t i = 0; ordered && i < seen.size(); ++i) {
+      ordered = seen[i] == lines[(i + r) % lines.size()];
+    }
+    CHECK(ordered);
+  }
+
+  gps_lib::ExecutorStats stats = executor.stats();
+  CHECK(stats.sentences == RECEIVERS * lines.size());
+  CHECK(stats.errors == RECEIVERS);
+  CHECK(stats.tasks >= stats.sentences / 4);
+}
+
+/**
+ * @brief Sentences longer than a frame are refused, not truncated.
+ */
+void oversized() {
+  gps_lib::ParseExecutor<Recorder> executor{
+      1, [](std::size_t) { return Recorder{}; }, {.threads = 1}};
+
+  CHECK(!executor.submit(0, std::string(200, 'x')));
+  CHECK(!executor.try_submit(0, std::string(200, 'x')));
+  executor.stop();
+  CHECK(executor.stage(0).lines.empty());
+}
+
+/**
+ * @brief The owner pops newest first and thieves take oldest first.
+ */
+void deque_ends() {
+  std::array<int, 3> tasks{0, 1, 2};
+  gps_lib::detail::WorkDeque<int> deque{3};
+
+  CHECK(deque.pop() == nullptr);
+  CHECK(deque.steal() == nullptr);
+  for (int &task : tasks) {
+    deque.push(&task);
+  }
+
+  CHECK(deque.steal() == &tasks[0]);
+  CHECK(deque.pop() == &tasks[2]);
+  CHECK(deque.pop() == &tasks[1]);
+  CHECK(deque.pop() == nullptr);
+  CHECK(deque.steal() == nullptr);
+}
+
+/**
+ * @brief While the owner pushes and pops, thieves steal concurrently, and
+ * every task is taken exactly once.
+ */
+void deque_steal_race() {
+  constexpr std::size_t TASKS{200'000};
+  constexpr std::size_t THIEVES{3};
+
+  std::vector<std::size_t> tasks(TASKS);
+  std::vector<std::atomic<int>> taken(TASKS);
+  gps_lib::detail::WorkDeque<std::size_t> deque{TASKS};
+  std::atomic<bool> done{false};
+
+  auto take = [&](std::size_t *task) { taken[*task].fetch_add(1); };
+
+  std::vector<std::jthread> thieves;
+  for (std::size_t t = 0; t < THIEVES; ++t) {
+    thieves.emplace_back([&] {
+      while (!done.load()) {
+        if (std::size_t *task = deque.steal()) {
+          take(task);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for (std::size_t i = 0; i < TASKS; ++i) {
+    tasks[i] = i;
+    deque.push(&tasks[i]);
+    if (i % 3 == 0) {
+      if (std::size_t *task = deque.pop()) {
+        take(task);
+      }
+    }
+  }
+  while (std::size_t *task = deque.pop()) {
+    take(task);
+  }
+  done.store(true);
+  thieves.clear();
+
+  bool once = true;
+  for (const std::atomic<int> &count : taken) {
+    once = once && count.load() == 1;
+  }
+  CHECK(once);
+}
+} // namespace
+
+int main() {
+  order_per_receiver();
+  oversized();
+  deque_ends();
+  deque_steal_race();
+
+  return gps_lib::test::result();
+}
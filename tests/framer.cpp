@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "check.h"
+#include "framer.h"
+#include "tools.h"
+
+namespace {
+using namespace std::string_view_literals;
+
+/**
+ * @brief Sentences of the sample log, each with its line ending.
+ */
+constexpr std::array<std::string_view, 3> SENTENCES{
+    "$GNGLL,4025.00283,N,00340.22044,W,215102.00,A,D*68\r\n",
+    "$GNGLL,4025.00310,N,00340.22050,W,215103.00,A,D*67\r\n",
+    "$GNGLL,4025.00342,N,00340.22061,W,215104.00,A,D*65\r\n"};
+
+/**
+ * @brief What a MixedFramer made of a stream.
+ */
+struct Framed {
+  std::vector<std::string> items;   ///< Sentences and frame summaries.
+  std::size_t checksum_failures{0}; ///< From checksum_failures().
+  std::size_t dropped{0};           ///< From dropped().
+  std::size_t resyncs{0};           ///< From resyncs().
+};
+
+/**
+ * @brief Frames a stream fed in chunks of a given size, then flushes.
+ * @param stream The bytes.
+ * @param chunk The chunk size.
+ * @return  Framed  The sentences, each frame as "UBX <class> <id> <size>"
+ * or "RTCM <type> <size>", and the counters.
+ */
+Framed frame(std::string_view stream, std::size_t chunk) {
+  gps_lib::MixedFramer<> framer;
+  Framed framed;
+  auto emit = gps_lib::overloaded{
+      [&](std::string_view sentence) {
+        framed.items.emplace_back(sentence);
+      },
+      [&](const gps_lib::UbxFrame &frame) {
+        framed.items.push_back(std::format("UBX {} {} {}",
+                                           frame.message_class,
+                                           frame.message_id,
+                                           frame.payload.size()));
+      },
+      [&](const gps_lib::RtcmFrame &frame) {
+        framed.items.push_back(std::format("RTCM {} {}", frame.message_type,
+                                           frame.payload.size()));
+      }};
+
+  for (std::size_t i = 0; i < stream.size(); i += chunk) {
+    framer.push(stream.substr(i, chunk), emit);
+  }
+  framer.flush(emit);
+
+  framed.checksum_failures = framer.checksum_failures();
+  framed.dropped = framer.dropped();
+  framed.resyncs = framer.resyncs();
+  return framed;
+}
+
+/**
+ * @brief Returns a sentence without its line ending.
+ * @param index The index in SENTENCES.
+ * @return  std::string     The sentence as the framer emits it.
+ */
+std::string sentence(std::size_t index) {
+  std::string_view line = SENTENCES[index];
+  return std::string{line.substr(0, line.size() - 2)};
+}
+
+/**
+ * @brief Returns a UBX frame with a payload of the given size.
+ * @param size The payload size.
+ * @return  std::string     The frame.
+ */
+std::string ubx_frame(std::size_t size) {
+  std::string frame;
+  gps_lib::encode_ubx(frame, 0x01, 0x07, std::string(size, '\x11'));
+  return frame;
+}
+
+/**
+ * @brief Returns an RTCM3 frame of a given message type.
+ * @param message_type The message number.
+ * @param size The payload size, at least 2.
+ * @return  std::string     The frame.
+ */
+std::string rtcm_frame(std::uint16_t message_type, std::size_t size) {
+  std::string payload(size, '\x22');
+  payload[0] = static_cast<char>(message_type >> 4);
+  payload[1] = static_cast<char>(((message_type & 0xF) << 4) | 0x2);
+
+  std::string frame;
+  gps_lib::encode_rtcm(frame, payload);
+  return frame;
+}
+
+/**
+ * @brief Chunk sizes every stream is fed in: whole, byte by byte and uneven.
+ */
+constexpr std::array<std::size_t, 3> CHUNKS{4096, 1, 7};
+
+/**
+ * @brief A false UBX sync whose length ends inside the next sentence fails
+ * its checksum; only its first byte is skipped, so the sentence and the
+ * frame after it still come out.
+ */
+void false_ubx_sync() {
+  std::string stream{SENTENCES[0]};
+  stream += "\xB5\x62\x01\x07\x20\x00"sv; // Claims a 32-byte payload.
+  stream += SENTENCES[1];
+  stream += ubx_frame(16);
+  stream += SENTENCES[2];
+
+  for (std::size_t chunk : CHUNKS) {
+    Framed framed = frame(stream, chunk);
+    CHECK(framed.items == std::vector<std::string>{sentence(0), sentence(1),
+                                                   "UBX 1 7 16",
+                                                   sentence(2)});
+    CHECK(framed.checksum_failures == 1);
+    CHECK(framed.dropped == 0);
+    CHECK(framed.resyncs == 0);
+  }
+}
+
+/**
+ * @brief A false UBX sync whose length runs past the end of the stream is
+ * rescanned when the stream is flushed.
+ */
+void false_ubx_sync_at_end() {
+  std::string stream{"\xB5\x62\x01\x07\xF0\x00"sv}; // Claims 240 bytes.
+  stream += SENTENCES[0];
+  stream += ubx_frame(8);
+  stream += SENTENCES[1];
+
+  for (std::size_t chunk : CHUNKS) {
+    Framed framed = frame(stream, chunk);
+    CHECK(framed.items == std::vector<std::string>{sentence(0), "UBX 1 7 8",
+                                                   sentence(1)});
+    CHECK(framed.checksum_failures == 0);
+    CHECK(framed.dropped == 1);
+    CHECK(framed.resyncs == 0);
+  }
+}
+
+/**
+ * @brief A corrupt UBX frame is counted and skipped, and a valid frame is
+ * not rescanned, even if its payload looks like a sentence.
+ */
+void corrupt_and_nested_ubx() {
+  std::string corrupt = ubx_frame(24);
+  corrupt[10] ^= 0x01;
+
+  std::string nested;
+  gps_lib::encode_ubx(nested, 0x02, 0x13, SENTENCES[2]);
+
+  std::string stream = corrupt;
+  stream += SENTENCES[0];
+  stream += nested;
+  stream += SENTENCES[1];
+
+  for (std::size_t chunk : CHUNKS) {
+    Framed framed = frame(stream, chunk);
+    CHECK(framed.items ==
+          std::vector<std::string>{sentence(0),
+                                   std::format("UBX 2 19 {}",
+                                               SENTENCES[2].size()),
+                                   sentence(1)});
+    CHECK(framed.checksum_failures == 1);
+  }
+}
+
+/**
+ * @brief A false RTCM3 preamble whose length ends inside the next sentence
+ * fails its CRC; only the preamble is skipped.
+ */
+void false_rtcm_preamble() {
+  std::string stream{SENTENCES[0]};
+  stream += "\xD3\x00\x20"sv; // Claims a 32-byte payload.
+  stream += SENTENCES[1];
+  stream += rtcm_frame(1005, 19);
+  stream += SENTENCES[2];
+
+  for (std::size_t chunk : CHUNKS) {
+    Framed framed = frame(stream, chunk);
+    CHECK(framed.items == std::vector<std::string>{sentence(0), sentence(1),
+                                                   "RTCM 1005 19",
+                                                   sentence(2)});
+    CHECK(framed.checksum_failures == 1);
+    CHECK(framed.resyncs == 0);
+  }
+}
+
+/**
+ * @brief A false RTCM3 preamble that ends inside a real frame does not take
+ * the frame with it, even when both are buffered across chunks.
+ */
+void false_rtcm_preamble_before_frame() {
+  std::string stream{"\xD3\x00\x04"sv}; // Ends 4 bytes into the frame.
+  stream += rtcm_frame(1077, 20);
+  stream += SENTENCES[0];
+
+  for (std::size_t chunk : CHUNKS) {
+    Framed framed = frame(stream, chunk);
+    CHECK(framed.items ==
+          std::vector<std::string>{"RTCM 1077 20", sentence(0)});
+    CHECK(framed.checksum_failures == 1);
+    CHECK(framed.resyncs == 0);
+  }
+}
+
+/**
+ * @brief Start bytes that are not followed by a valid header are counted as
+ * resyncs, not as checksum failures.
+ */
+void false_starts_are_resyncs() {
+  std::string stream{"\xD3\xFF"sv}; // Reserved bits set.
+  stream += SENTENCES[0];
+  stream += "\xB5\x00"sv; // No second sync byte.
+  stream += SENTENCES[1];
+  stream += "\xB5\x62\x01\x07\xFF\xFF"sv; // Longer than the buffer.
+  stream += SENTENCES[2];
+
+  for (std::size_t chunk : CHUNKS) {
+    Framed framed = frame(stream, chunk);
+    CHECK(framed.items ==
+          std::vector<std::string>{sentence(0), sentence(1), sentence(2)});
+    CHECK(framed.resyncs == 3);
+    CHECK(framed.checksum_failures == 0);
+    CHECK(framed.dropped == 0);
+  }
+}
+} // namespace
+
+int main() {
+  false_ubx_sync();
+  false_ubx_sync_at_end();
+  corrupt_and_nested_ubx();
+  false_rtcm_preamble();
+  false_rtcm_preamble_before_frame();
+  false_starts_are_resyncs();
+
+  return gps_lib::test::result();
+}
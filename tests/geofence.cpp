@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "check.h"
+#include "geofence.h"
+
+namespace {
+/**
+ * @brief The unit square from (0, 0) to (1, 1), as latitude and longitude.
+ */
+constexpr std::array<gps_lib::Vertex, 4> SQUARE{
+    {{0.0, 0.0}, {0.0, 1.0}, {1.0, 1.0}, {1.0, 0.0}}};
+
+/**
+ * @brief A U-shaped polygon: two arms of width 1 joined at the bottom,
+ * around a notch from longitude 1 to 2 above latitude 1.
+ */
+constexpr std::array<gps_lib::Vertex, 8> U_SHAPE{{{0.0, 0.0},
+                                                  {0.0, 3.0},
+                                                  {3.0, 3.0},
+                                                  {3.0, 2.0},
+                                                  {1.0, 2.0},
+                                                  {1.0, 1.0},
+                                                  {3.0, 1.0},
+                                                  {3.0, 0.0}}};
+
+/**
+ * @brief Returns the identifiers of the fences that contain a position.
+ * @param index The index to query.
+ * @param latitude The latitude in decimal degrees.
+ * @param longitude The longitude in decimal degrees.
+ * @return  std::vector<std::uint32_t>  The identifiers, sorted.
+ */
+std::vector<std::uint32_t> query(const gps_lib::GeofenceIndex &index,
+                                 double latitude, double longitude) {
+  std::vector<std::uint32_t> fences;
+  index.query(latitude, longitude,
+              [&](std::uint32_t fence) { fences.push_back(fence); });
+  std::sort(fences.begin(), fences.end());
+  return fences;
+}
+
+/**
+ * @brief Returns a fix at a position.
+ * @param latitude The latitude in decimal degrees.
+ * @param longitude The longitude in decimal degrees.
+ * @return  gps_lib::Fix    The fix.
+ */
+gps_lib::Fix fix_at(double latitude, double longitude) {
+  return {{}, latitude, longitude, 0.0, 1.0};
+}
+
+/**
+ * @brief Points inside, outside and on the edges of a square. The south and
+ * west edges are inside and the north and east edges outside, so a point on
+ * the north-east corner of the grid, where the row equals the grid side, is
+ * outside too.
+ */
+void square() {
+  gps_lib::GeofenceIndex index;
+  index.add(7, SQUARE);
+  index.build();
+
+  using Fences = std::vector<std::uint32_t>;
+  CHECK(query(index, 0.5, 0.5) == Fences{7});
+  CHECK(query(index, 1.5, 0.5).empty());
+  CHECK(query(index, 0.5, -0.5).empty());
+  CHECK(query(index, -1e-12, 0.5).empty());
+
+  CHECK(query(index, 0.0, 0.5) == Fences{7});
+  CHECK(query(index, 0.5, 0.0) == Fences{7});
+  CHECK(query(index, 0.0, 0.0) == Fences{7});
+  CHECK(query(index, 1.0, 0.5).empty());
+  CHECK(query(index, 0.5, 1.0).empty());
+  CHECK(query(index, 1.0, 1.0).empty());
+  CHECK(query(index, std::numeric_limits<double>::quiet_NaN(), 0.5).empty());
+}
+
+/**
+ * @brief A concave polygon contains its arms but not its notch, even though
+ * the notch lies inside its bounding box.
+ */
+void concave() {
+  gps_lib::GeofenceIndex index;
+  index.add(1, U_SHAPE);
+  index.build();
+
+  CHECK(query(index, 0.5, 1.5).size() == 1);
+  CHECK(query(index, 2.5, 0.5).size() == 1);
+  CHECK(query(index, 2.5, 2.5).size() == 1);
+  CHECK(query(index, 2.5, 1.5).empty());
+  CHECK(query(index, 1.5, 1.5).empty());
+  CHECK(query(index, 1.0, 1.5).empty());
+}
+
+/**
+ * @brief A position inside several fences reports all of them, and a grid
+ * over many fences finds the same ones as testing every fence.
+ */
+void overlapping() {
+  gps_lib::GeofenceIndex index;
+  constexpr std::size_t SIDE{8};
+
+  // Squares of side 1 every 0.5 degrees, so most points are in four.
+  for (std::size_t row = 0; row < SIDE; ++row) {
+    for (std::size_t column = 0; column < SIDE; ++column) {
+      std::array<gps_lib::Vertex, 4> square = SQUARE;
+      for (gps_lib::Vertex &vertex : square) {
+        vertex.latitude += 0.5 * static_cast<double>(row);
+        vertex.longitude += 0.5 * static_cast<double>(column);
+      }
+      index.add(static_cast<std::uint32_t>(row * SIDE + column), square);
+    }
+  }
+  index.build();
+  CHECK(index.size() == SIDE * SIDE);
+
+  using Fences = std::vector<std::uint32_t>;
+  CHECK(query(index, 0.75, 0.75) == Fences{0, 1, SIDE, SIDE + 1});
+  CHECK(query(index, 0.25, 0.25) == Fences{0});
+
+  for (double latitude = -0.1; latitude < 5.0; latitude += 0.13) {
+    for (double longitude = -0.1; longitude < 5.0; longitude += 0.17) {
+      Fences expected;
+      for (std::size_t row = 0; row < SIDE; ++row) {
+        for (std::size_t column = 0; column < SIDE; ++column) {
+          double south = 0.5 * static_cast<double>(row);
+          double west = 0.5 * static_cast<double>(column);
+          if (latitude >= south && latitude < south + 1.0 &&
+              longitude >= west && longitude < west + 1.0) {
+            expected.push_back(static_cast<std::uint32_t>(row * SIDE + column));
+          }
+        }
+      }
+      CHECK(query(index, latitude, longitude) == expected);
+    }
+  }
+}
+
+/**
+ * @brief An index without fences, built or not, contains nothing.
+ */
+void empty() {
+  gps_lib::GeofenceIndex unbuilt;
+  CHECK(query(unbuilt, 0.0, 0.0).empty());
+
+  gps_lib::GeofenceIndex index;
+  index.build();
+  CHECK(index.size() == 0);
+  CHECK(query(index, 0.0, 0.0).empty());
+  CHECK(query(index, 45.0, -3.0).empty());
+}
+
+/**
+ * @brief The tracker reports each fence a receiver enters or leaves once,
+ * and keeps receivers apart.
+ */
+void enter_and_exit() {
+  gps_lib::GeofenceIndex index;
+  std::array<gps_lib::Vertex, 4> east = SQUARE;
+  for (gps_lib::Vertex &vertex : east) {
+    vertex.longitude += 0.5;
+  }
+  index.add(1, SQUARE);
+  index.add(2, east);
+  index.build();
+
+  gps_lib::GeofenceTracker tracker{index};
+  std::vector<gps_lib::GeofenceEvent> events;
+  auto update = [&](std::uint64_t receiver, double longitude) {
+    events.clear();
+    tracker.update(receiver, fix_at(0.5, longitude),
+                   [&](const gps_lib::GeofenceEvent &event) {
+                     events.push_back(event);
+                   });
+  };
+  auto is = [&](std::size_t i, std::uint64_t receiver, std::uint32_t fence,
+                bool entered) {
+    return i < events.size() && events[i].receiver == receiver &&
+           events[i].fence == fence && events[i].entered == entered;
+  };
+
+  update(10, -1.0);
+  CHECK(events.empty());
+  update(10, 0.25);
+  CHECK(events.size() == 1 && is(0, 10, 1, true));
+  update(10, 0.3);
+  CHECK(events.empty());
+  update(10, 0.75);
+  CHECK(events.size() == 1 && is(0, 10, 2, true));
+
+  // Another receiver enters both at once, in fence order.
+  update(20, 0.75);
+  CHECK(events.size() == 2 && is(0, 20, 1, true) && is(1, 20, 2, true));
+
+  update(10, 1.25);
+  CHECK(events.size() == 1 && is(0, 10, 1, false));
+
+  // Leaving one fence and entering another in the same update.
+  update(20, 0.25);
+  CHECK(events.size() == 1 && is(0, 20, 2, false));
+  update(20, 1.25);
+  CHECK(events.size() == 2 && is(0, 20, 1, false) && is(1, 20, 2, true));
+
+  update(10, 2.0);
+  CHECK(events.size() == 1 && is(0, 10, 2, false));
+  update(10, 2.0);
+  CHECK(events.empty());
+}
+} // namespace
+
+int main() {
+  square();
+  concave();
+  overlapping();
+  empty();
+  enter_and_exit();
+
+  return gps_lib::test::result();
+}
@@ -0,0 +1,196 @@
+#include <cmath>
+#include <limits>
+
+#include "check.h"
+#include "kalman.h"
+
+namespace {
+constexpr double NaN{std::numeric_limits<double>::quiet_NaN()};
+
+/// Seconds after a start before the velocity of an exact track has settled.
+constexpr int WARM_UP{10};
+
+/**
+ * @brief Returns the distance between two nearby points.
+ * @param a The first point.
+ * @param b The second point.
+ * @return  double  The distance in meters, on a flat local projection.
+ */
+template <typename A, typename B> double distance(const A &a, const B &b) {
+  double scale = std::cos(a.latitude * gps_lib::detail::DEGTORAD);
+  double east = std::remainder(b.longitude - a.longitude, 360.0) * scale;
+  double north = b.latitude - a.latitude;
+  return std::hypot(east, north) * gps_lib::METERS_PER_DEGREE;
+}
+
+/**
+ * @brief A receiver moving at a constant velocity.
+ */
+struct Track {
+  double latitude;       ///< Latitude at time 0.
+  double longitude;      ///< Longitude at time 0.
+  double east_velocity;  ///< Velocity towards the east in m/s.
+  double north_velocity; ///< Velocity towards the north in m/s.
+  double error{3.0};     ///< Amplitude of the measurement error in meters.
+
+  /**
+   * @brief Returns the measurement of the receiver at a time, off by a
+   * deterministic error of up to error meters on each axis.
+   * @param time The time in seconds.
+   * @param hdop The HDOP to report.
+   * @return  gps_lib::KalmanMeasurement     The measurement.
+   */
+  gps_lib::KalmanMeasurement at(double time, double hdop = 1.0) const {
+    double scale = gps_lib::METERS_PER_DEGREE *
+                   std::cos(latitude * gps_lib::detail::DEGTORAD);
+    double east = east_velocity * time + error * std::sin(time * 1.7);
+    double north = north_velocity * time + error * std::cos(time * 2.3);
+    return {0, time, latitude + north / gps_lib::METERS_PER_DEGREE,
+            std::remainder(longitude + east / scale, 360.0), hdop};
+  }
+
+  /**
+   * @brief Returns the true position of the receiver at a time.
+   * @param time The time in seconds.
+   * @return  gps_lib::KalmanMeasurement     The position, without error.
+   */
+  gps_lib::KalmanMeasurement truth(double time) const {
+    Track exact = *this;
+    exact.error = 0.0;
+    return exact.at(time);
+  }
+};
+
+/**
+ * @brief On a constant-velocity track the velocity converges to the true
+ * one, and the position ends up closer to the truth than the measurements.
+ */
+void converges() {
+  Track track{40.4, -3.67, 8.0, -6.0};
+  gps_lib::KalmanState state;
+  gps_lib::KalmanEstimate estimate{};
+
+  for (int t = 0; t <= 120; ++t) {
+    estimate = gps_lib::kalman_update(state, track.at(t), {});
+  }
+
+  CHECK(std::abs(estimate.east_velocity - track.east_velocity) < 0.5);
+  CHECK(std::abs(estimate.north_velocity - track.north_velocity) < 0.5);
+  CHECK(distance(estimate, track.truth(120)) < 2.0);
+  CHECK(distance(track.at(120), track.truth(120)) > 2.0);
+}
+
+/**
+ * @brief The filter restarts on the measurement after a gap longer than
+ * max_gap, and on one whose time goes backwards.
+ */
+void restarts() {
+  Track track{40.4, -3.67, 8.0, -6.0};
+  gps_lib::KalmanParameters params;
+  gps_lib::KalmanState state;
+
+  for (int t = 0; t <= 30; ++t) {
+    gps_lib::kalman_update(state, track.at(t), params);
+  }
+
+  for (double time : {30.0 + params.max_gap + 1.0, 5.0}) {
+    gps_lib::KalmanMeasurement measurement = track.at(time);
+    gps_lib::KalmanEstimate estimate =
+        gps_lib::kalman_update(state, measurement, params);
+
+    CHECK(estimate.latitude == measurement.latitude);
+    CHECK(estimate.longitude == measurement.longitude);
+    CHECK(estimate.east_velocity == 0.0);
+    CHECK(estimate.north_velocity == 0.0);
+    CHECK(state.time == time);
+  }
+
+  // A gap of exactly max_gap is still filtered.
+  gps_lib::KalmanMeasurement measurement = track.at(5.0 + params.max_gap);
+  gps_lib::KalmanEstimate estimate =
+      gps_lib::kalman_update(state, measurement, params);
+  CHECK(estimate.latitude != measurement.latitude);
+}
+
+/**
+ * @brief A measurement without HDOP is weighted with the last known one,
+ * or with 1 before any is known.
+ */
+void missing_hdop() {
+  Track track{40.4, -3.67, 8.0, -6.0};
+  gps_lib::KalmanState known;
+  gps_lib::KalmanState unknown;
+
+  for (int t = 0; t <= 20; ++t) {
+    double hdop = t < 10 ? 1.0 : 4.0;
+    gps_lib::KalmanEstimate expected =
+        gps_lib::kalman_update(known, track.at(t, hdop), {});
+    gps_lib::KalmanEstimate estimate =
+        gps_lib::kalman_update(unknown, track.at(t, t == 10 ? hdop : NaN), {});
+
+    CHECK(estimate.latitude == expected.latitude);
+    CHECK(estimate.longitude == expected.longitude);
+    CHECK(unknown.position_var == known.position_var);
+  }
+}
+
+/**
+ * @brief Moving the local origin after 1 km does not make the estimate
+ * jump, and keeps the offsets from the origin small.
+ */
+void recenters() {
+  Track track{40.4, -3.67, 25.0, 10.0, 0.0};
+  gps_lib::KalmanState state;
+  double origin = NaN;
+  int moves = 0;
+
+  for (int t = 0; t <= 200; ++t) {
+    gps_lib::KalmanEstimate estimate =
+        gps_lib::kalman_update(state, track.at(t), {});
+
+    // Once the velocity has settled, the estimate follows the track.
+    if (t >= WARM_UP) {
+      CHECK(distance(estimate, track.truth(t)) < 0.5);
+    }
+    CHECK(std::abs(state.east) <= 1000.0F);
+    CHECK(std::abs(state.north) <= 1000.0F);
+
+    moves += t > 0 && state.origin_longitude != origin;
+    origin = state.origin_longitude;
+  }
+
+  CHECK(moves >= 4);
+}
+
+/**
+ * @brief A track that crosses the antimeridian stays continuous, and its
+ * longitude wraps from +180 to -180.
+ */
+void crosses_antimeridian() {
+  Track track{-16.5, 179.99, 20.0, 0.0, 0.0};
+  gps_lib::KalmanState state;
+  gps_lib::KalmanEstimate estimate{};
+
+  for (int t = 0; t <= 120; ++t) {
+    estimate = gps_lib::kalman_update(state, track.at(t), {});
+
+    if (t >= WARM_UP) {
+      CHECK(distance(estimate, track.truth(t)) < 0.5);
+    }
+    CHECK(estimate.longitude >= -180.0 && estimate.longitude <= 180.0);
+  }
+
+  CHECK(estimate.longitude < -179.98);
+  CHECK(std::abs(estimate.east_velocity - 20.0) < 0.1);
+}
+} // namespace
+
+int main() {
+  converges();
+  restarts();
+  missing_hdop();
+  recenters();
+  crosses_antimeridian();
+
+  return gps_lib::test::result();
+}
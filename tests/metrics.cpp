@@ -0,0 +1,216 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "check.h"
+#include "metrics.h"
+#include "parse.h"
+
+#ifndef GPS_LIB_METRICS
+#error "This test needs GPS_LIB_METRICS"
+#endif
+
+namespace {
+using gps_lib::LatencyHistogram;
+
+/**
+ * @brief Sentences that parse: a GPS GGA, two GNSS RMCs and a BeiDou GSA.
+ */
+constexpr std::array<std::string_view, 4> GOOD{
+    "$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*76",
+    "$GNRMC,211041.00,A,4024.98796,N,00340.22512,W,0.027,,010218,,,D*7B",
+    "$GNRMC,211042.00,A,4024.98775,N,00340.22511,W,0.033,,010218,,,D*73",
+    "$BDGSA,A,3,01,02,,,,,,,,,,,1.0,0.8,0.6*2F"};
+
+/**
+ * @brief Sentences that do not parse: a wrong checksum, an unknown type, a
+ * truncated GGA, and an invalid hemisphere.
+ */
+constexpr std::array<std::string_view, 4> BAD{
+    "$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*77",
+    "$GPXYZ,1,2*4F", "$GPGGA,092750.000*6D",
+    "$GPGGA,092750.000,5321.6802,X,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*60"};
+
+/**
+ * @brief Returns the index of a name in a list of names.
+ * @param names The names.
+ * @param name The name to find.
+ * @return  std::size_t     The index, or the size of the list if absent.
+ */
+template <std::size_t N>
+std::size_t index_of(const std::array<std::string_view, N> &names,
+                     std::string_view name) {
+  std::size_t index = 0;
+  while (index < N && names[index] != name) {
+    ++index;
+  }
+  return index;
+}
+
+/**
+ * @brief Parses every good and bad sentence once.
+ * @return  std::uint64_t   The bytes passed to the parser.
+ */
+std::uint64_t parse_all() {
+  std::uint64_t bytes = 0;
+  for (std::string_view line : GOOD) {
+    CHECK(gps_lib::parse(line).has_value());
+    bytes += line.size();
+  }
+  for (std::string_view line : BAD) {
+    CHECK(!gps_lib::parse(line).has_value());
+    bytes += line.size();
+  }
+  return bytes;
+}
+
+/**
+ * @brief Good and bad sentences land in their counters, and the snapshot
+ * is exported with the same values.
+ */
+void counters() {
+  std::uint64_t bytes = parse_all();
+  gps_lib::MetricsSnapshot snapshot = gps_lib::metrics_snapshot();
+
+  auto sentences = [&](std::string_view name) {
+    return snapshot.sentences[index_of(gps_lib::SENTENCE_NAMES, name)];
+  };
+  auto talkers = [&](std::string_view name) {
+    return snapshot.talkers[index_of(gps_lib::TALKER_NAMES, name)];
+  };
+  auto errors = [&](gps_lib::ParseError error) {
+    return snapshot.errors[static_cast<std::size_t>(error)];
+  };
+
+  CHECK(sentences("GGA") == 1);
+  CHECK(sentences("RMC") == 2);
+  CHECK(sentences("GSA") == 1);
+  CHECK(sentences("GLL") == 0);
+  CHECK(talkers("GP") == 1);
+  CHECK(talkers("GN") == 2);
+  CHECK(talkers("other") == 1);
+  CHECK(errors(gps_lib::ParseError::InvalidFormat) == 1);
+  CHECK(errors(gps_lib::ParseError::UnsupportedType) == 1);
+  CHECK(errors(gps_lib::ParseError::MissingFields) == 1);
+  CHECK(errors(gps_lib::ParseError::InvalidDirection) == 1);
+  CHECK(snapshot.checksum_failures == 1);
+  CHECK(snapshot.bytes == bytes);
+  CHECK(snapshot.latency.count == GOOD.size() + BAD.size());
+  CHECK(snapshot.latency.percentile(0.5) <= snapshot.latency.percentile(1.0));
+
+  std::string exposition = gps_lib::to_prometheus(snapshot);
+  auto exports = [&](std::string_view line) {
+    return exposition.find(std::string{line} + "\n") != std::string::npos;
+  };
+  CHECK(exports("# TYPE gps_lib_sentences_total counter"));
+  CHECK(exports("gps_lib_sentences_total{type=\"RMC\"} 2"));
+  CHECK(exports("gps_lib_sentences_total{type=\"GLL\"} 0"));
+  CHECK(exports("gps_lib_talker_sentences_total{talker=\"other\"} 1"));
+  CHECK(exports("gps_lib_parse_errors_total{error=\"InvalidFormat\"} 1"));
+  CHECK(exports("gps_lib_checksum_failures_total 1"));
+  CHECK(exports("gps_lib_bytes_total " + std::to_string(bytes)));
+  CHECK(exports("# TYPE gps_lib_parse_latency_seconds summary"));
+  CHECK(exports("gps_lib_parse_latency_seconds_count 8"));
+  CHECK(exposition.find("gps_lib_parse_latency_seconds{quantile=\"0.999\"} ") !=
+        std::string::npos);
+}
+
+/**
+ * @brief Every value falls in a bucket whose upper bound is within 1/16 of
+ * it, buckets are contiguous, and values past the range share the last one.
+ */
+void buckets() {
+  for (std::uint64_t value = 0; value < LatencyHistogram::SUB_BUCKETS;
+       ++value) {
+    CHECK(LatencyHistogram::bucket(value) == value);
+    CHECK(LatencyHistogram::upper_bound(value) == value);
+  }
+
+  for (std::size_t index = 0; index + 1 < LatencyHistogram::BUCKETS;
+       ++index) {
+    std::uint64_t upper = LatencyHistogram::upper_bound(index);
+    CHECK(LatencyHistogram::bucket(upper) == index);
+    CHECK(LatencyHistogram::bucket(upper + 1) == index + 1);
+  }
+
+  for (std::uint64_t value = 1; value < (std::uint64_t{1} << 39);
+       value = value * 3 + 1) {
+    std::uint64_t upper =
+        LatencyHistogram::upper_bound(LatencyHistogram::bucket(value));
+    CHECK(upper >= value && upper - value <= value / 16);
+  }
+
+  CHECK(LatencyHistogram::bucket(std::numeric_limits<std::uint64_t>::max()) ==
+        LatencyHistogram::BUCKETS - 1);
+  CHECK(LatencyHistogram::bucket(std::uint64_t{1}
+                                 << LatencyHistogram::MAX_BITS) ==
+        LatencyHistogram::BUCKETS - 1);
+}
+
+/**
+ * @brief Percentiles of 1 to 1000 ns are the upper bounds of the buckets of
+ * the values at those ranks.
+ */
+void percentiles() {
+  LatencyHistogram histogram;
+  CHECK(histogram.percentile(0.5) == std::chrono::nanoseconds{0});
+
+  for (std::uint64_t value = 1; value <= 1000; ++value) {
+    ++histogram.counts[LatencyHistogram::bucket(value)];
+    ++histogram.count;
+    histogram.sum += value;
+  }
+
+  auto bound = [](std::uint64_t value) {
+    return std::chrono::nanoseconds{
+        LatencyHistogram::upper_bound(LatencyHistogram::bucket(value))};
+  };
+  CHECK(histogram.percentile(0.0) == bound(1));
+  CHECK(histogram.percentile(0.5) == bound(501));
+  CHECK(histogram.percentile(0.9) == bound(901));
+  CHECK(histogram.percentile(0.999) == bound(1000));
+  CHECK(histogram.percentile(1.0) == bound(1000));
+}
+
+/**
+ * @brief A thread that exits hands its block back with its counts, and the
+ * next thread reuses it instead of registering a new one.
+ */
+void thread_blocks() {
+  gps_lib::MetricsSnapshot before = gps_lib::metrics_snapshot();
+
+  const gps_lib::detail::ThreadMetrics *first = nullptr;
+  const gps_lib::detail::ThreadMetrics *second = nullptr;
+  std::jthread{[&] {
+    parse_all();
+    first = &gps_lib::detail::thread_metrics();
+  }}.join();
+  std::jthread{[&] {
+    parse_all();
+    second = &gps_lib::detail::thread_metrics();
+  }}.join();
+
+  CHECK(first == second);
+  CHECK(first != &gps_lib::detail::thread_metrics());
+
+  gps_lib::MetricsSnapshot after = gps_lib::metrics_snapshot();
+  CHECK(after.latency.count ==
+        before.latency.count + 2 * (GOOD.size() + BAD.size()));
+  CHECK(after.checksum_failures == before.checksum_failures + 2);
+  CHECK(after.bytes == 3 * before.bytes);
+}
+} // namespace
+
+int main() {
+  counters();
+  buckets();
+  percentiles();
+  thread_blocks();
+
+  return gps_lib::test::result();
+}
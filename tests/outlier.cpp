@@ -0,0 +1,114 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "check.h"
+#include "outlier.h"
+
+namespace {
+constexpr double NaN{std::numeric_limits<double>::quiet_NaN()};
+constexpr double LATITUDE{40.4};   ///< Latitude of the test area.
+constexpr double LONGITUDE{-3.67}; ///< Longitude of the test area.
+
+/**
+ * @brief Returns a fix at an offset east of the origin of the test area.
+ * @param second The time in seconds.
+ * @param east The offset towards the east in meters.
+ * @param speed The reported speed in m/s.
+ * @return  gps_lib::Fix    The fix.
+ */
+gps_lib::Fix fix_at(int second, double east, double speed = 10.0) {
+  double meters = gps_lib::detail::EARTH_RADIUS * gps_lib::detail::DEGTORAD *
+                  std::cos(LATITUDE * gps_lib::detail::DEGTORAD);
+  return {gps_lib::Timestamp{std::chrono::seconds{second}}, LATITUDE,
+          LONGITUDE + east / meters, speed, 1.0};
+}
+
+/**
+ * @brief A jump faster than the reported speed allows is rejected, and the
+ * track goes on from the last accepted fix.
+ */
+void rejects_jump() {
+  gps_lib::OutlierFilter filter;
+
+  CHECK(filter.accept(fix_at(0, 0.0)));
+  CHECK(filter.accept(fix_at(1, 10.0)));
+  CHECK(std::abs(filter.implied_speed() - 10.0) < 1e-6);
+
+  // 500 m in a second, with a reported speed of 10 m/s.
+  CHECK(!filter.accept(fix_at(2, 510.0)));
+  CHECK(std::abs(filter.implied_speed() - 500.0) < 1e-3);
+
+  // Measured from the fix at 1 s, not the rejected one: 30 m in 2 s.
+  CHECK(filter.accept(fix_at(3, 40.0)));
+
+  // In a second: 10 m/s reported, 5 m/s speed and 10 m position tolerance.
+  CHECK(!filter.accept(fix_at(4, 40.0 + 26.0)));
+  CHECK(filter.accept(fix_at(4, 40.0 + 24.0)));
+
+  // Without a reported speed only the physical limit applies.
+  gps_lib::OutlierFilter unknown;
+  CHECK(unknown.accept(fix_at(0, 0.0, NaN)));
+  CHECK(unknown.accept(fix_at(1, 75.0, NaN)));
+  CHECK(!unknown.accept(fix_at(2, 75.0 + 85.0, NaN)));
+}
+
+/**
+ * @brief After max_rejections rejections in a row the next fix is accepted
+ * unchecked as the new reference, and implied_speed() keeps the value of
+ * the last rejected fix.
+ */
+void reseeds() {
+  gps_lib::OutlierParameters params;
+  gps_lib::OutlierFilter filter{params};
+
+  CHECK(filter.accept(fix_at(0, 0.0)));
+  for (std::size_t i = 1; i <= params.max_rejections; ++i) {
+    CHECK(!filter.accept(fix_at(static_cast<int>(i), 1000.0)));
+  }
+  double stale = filter.implied_speed();
+
+  int time = static_cast<int>(params.max_rejections) + 1;
+  CHECK(filter.accept(fix_at(time, 1000.0)));
+  CHECK(filter.implied_speed() == stale);
+
+  // The new reference is checked as usual.
+  CHECK(filter.accept(fix_at(time + 1, 1010.0)));
+  CHECK(!filter.accept(fix_at(time + 2, 0.0)));
+
+  // A plausible fix resets the count of rejections.
+  gps_lib::OutlierFilter intermittent{params};
+  CHECK(intermittent.accept(fix_at(0, 0.0)));
+  for (int i = 1; i <= 20; ++i) {
+    CHECK(i % 2 == 0 ? intermittent.accept(fix_at(i, 10.0 * i))
+                     : !intermittent.accept(fix_at(i, 1000.0)));
+  }
+}
+
+/**
+ * @brief Fixes with the same time as the reference, or an earlier one, are
+ * only accepted within the position tolerance, and imply no speed.
+ */
+void no_elapsed_time() {
+  gps_lib::OutlierFilter filter;
+  CHECK(filter.accept(fix_at(10, 0.0)));
+
+  CHECK(filter.accept(fix_at(10, 5.0)));
+  CHECK(filter.implied_speed() == 0.0);
+  CHECK(!filter.accept(fix_at(10, 50.0)));
+  CHECK(filter.implied_speed() == 0.0);
+
+  CHECK(filter.accept(fix_at(9, 0.0)));
+  CHECK(!filter.accept(fix_at(8, 20.0)));
+  CHECK(filter.implied_speed() == 0.0);
+}
+} // namespace
+
+int main() {
+  rejects_jump();
+  reseeds();
+  no_elapsed_time();
+
+  return gps_lib::test::result();
+}
@@ -0,0 +1,129 @@
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "allocations.h"
+#include "check.h"
+#include "parse.h"
+#include "pool.h"
+
+GPS_LIB_COUNT_ALLOCATIONS();
+
+namespace {
+/**
+ * @brief Reads the sample log.
+ * @return  std::vector<std::string>    Its lines.
+ */
+std::vector<std::string> read_samples() {
+  std::ifstream file{"data/samples.txt"};
+  std::vector<std::string> lines;
+
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+
+  return lines;
+}
+
+/**
+ * @brief Parses every line through the pool.
+ * @param pool The pool.
+ * @param lines The sentences.
+ * @return  std::size_t     The number of lines parsed.
+ */
+std::size_t parse_all(gps_lib::SamplePool &pool,
+                      const std::vector<std::string> &lines) {
+  gps_lib::ParseContext context;
+  std::size_t parsed = 0;
+
+  for (const std::string &line : lines) {
+    gps_lib::Sample sample = pool.acquire(line);
+    if (gps_lib::parse_into(sample, line, context)) {
+      ++parsed;
+    }
+    pool.release(std::move(sample));
+  }
+
+  return parsed;
+}
+
+/**
+ * @brief acquire() hands back a released sample of the sentence's type, and
+ * release() keeps at most the limit per type.
+ */
+void acquire_by_type() {
+  gps_lib::SamplePool pool{2};
+
+  for (int i = 0; i < 3; ++i) {
+    pool.release(gps_lib::Sample{std::in_place_type<gps_lib::GSV>});
+  }
+  pool.release(gps_lib::Sample{std::in_place_type<gps_lib::RMC>});
+  CHECK(pool.size() == 3);
+
+  gps_lib::Sample sample = pool.acquire("$GPGSV,3,1,12*00");
+  CHECK(std::holds_alternative<gps_lib::GSV>(sample));
+  CHECK(pool.size() == 2);
+
+  sample = pool.acquire("$GNRMC,211041.00,A");
+  CHECK(std::holds_alternative<gps_lib::RMC>(sample));
+  CHECK(pool.size() == 1);
+
+  sample = pool.acquire("$GNRMC,211041.00,A");
+  CHECK(pool.size() == 1);
+  sample = pool.acquire("not a sentence");
+  CHECK(pool.size() == 1);
+}
+
+/**
+ * @brief Once the pool is warm, parsing through it allocates nothing.
+ */
+void warm_pool_does_not_allocate() {
+  std::vector<std::string> lines = read_samples();
+  gps_lib::SamplePool pool;
+
+  CHECK(parse_all(pool, lines) == lines.size());
+
+  std::size_t parsed = 0;
+  gps_lib::AllocationCount count =
+      gps_lib::count_allocations([&] { parsed = parse_all(pool, lines); });
+  CHECK(parsed == lines.size());
+  CHECK(count.allocations == 0);
+}
+
+/**
+ * @brief Threads sharing a pool parse the same as without one.
+ */
+void shared_between_threads() {
+  std::vector<std::string> lines = read_samples();
+  gps_lib::SamplePool pool{8};
+  std::vector<std::size_t> parsed(4);
+
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t t = 0; t < parsed.size(); ++t) {
+      threads.emplace_back([&, t] {
+        for (int round = 0; round < 5; ++round) {
+          parsed[t] += parse_all(pool, lines);
+        }
+      });
+    }
+  }
+
+  for (std::size_t count : parsed) {
+    CHECK(count == 5 * lines.size());
+  }
+  CHECK(pool.size() <= 8 * std::variant_size_v<gps_lib::Sample>);
+}
+} // namespace
+
+int main() {
+  acquire_by_type();
+  warm_pool_does_not_allocate();
+  shared_between_threads();
+
+  return gps_lib::test::result();
+}
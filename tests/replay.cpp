@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <thread>
+
+#include "check.h"
+#include "detail/socket.h"
+#include "replay.h"
+
+namespace {
+/**
+ * @brief A stop request must end a slow replay promptly, not after the
+ * current gap, which at speed 0.1 is ten seconds per logged second.
+ */
+void stop_during_a_gap() {
+  using namespace std::chrono;
+
+  std::ifstream log{"data/samples.txt"};
+  CHECK(log.is_open());
+
+  gps_lib::Replayer replayer{{.speed = 0.1}};
+  gps_lib::ReplayStats stats;
+  std::stop_source stop;
+  auto start = steady_clock::now();
+
+  std::jthread replay{[&] {
+    stats = replayer.run(
+        log, [](std::size_t, std::string_view, const gps_lib::Sample &) {},
+        stop.get_token());
+  }};
+  std::this_thread::sleep_for(milliseconds{100});
+  stop.request_stop();
+  replay.join();
+
+  CHECK(steady_clock::now() - start < seconds{2});
+  CHECK(stats.sentences >= 1);
+  CHECK(stats.sentences < 10);
+}
+
+/**
+ * @brief Every sentence replayed into a UdpSink arrives as one datagram.
+ */
+void udp_sink() {
+  gps_lib::detail::FileDescriptor receiver;
+  auto address = gps_lib::detail::make_address("127.0.0.1", 0);
+  CHECK(address && gps_lib::detail::open_socket(receiver, SOCK_DGRAM,
+                                                *address, 1 << 20));
+
+  auto sink = gps_lib::UdpSink::open(ntohs(address->sin_port));
+  CHECK(sink.has_value());
+  if (!sink) {
+    return;
+  }
+
+  std::ifstream file{"data/samples.txt"};
+  std::stringstream log;
+  std::string line;
+  for (int i = 0; i < 50 && std::getline(file, line); ++i) {
+    log << line << '\n';
+  }
+
+  gps_lib::Replayer replayer{{.speed = 0.0}};
+  gps_lib::ReplayStats stats = replayer.run(log, *sink);
+
+  std::size_t received = 0;
+  char datagram[256];
+  ssize_t size = 0;
+  while ((size = ::recv(receiver.get(), datagram, sizeof(datagram), 0)) > 0) {
+    CHECK(std::string_view(datagram, static_cast<std::size_t>(size))
+              .ends_with("\r\n"));
+    ++received;
+  }
+
+  CHECK(stats.sentences == 50);
+  CHECK(received == stats.sentences);
+  CHECK(sink->failures() == 0);
+}
+} // namespace
+
+int main() {
+  stop_during_a_gap();
+  udp_sink();
+
+  return gps_lib::test::result();
+}
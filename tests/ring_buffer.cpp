@@ -0,0 +1,170 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+#include "ring_buffer.h"
+
+namespace {
+constexpr std::size_t PRODUCERS{4};
+constexpr std::size_t PER_PRODUCER{100'000};
+
+/**
+ * @brief A frame keeps its source and bytes, and refuses what does not fit.
+ */
+void sentence_frame() {
+  gps_lib::SentenceFrame<16> frame;
+
+  CHECK(frame.assign(7, "$GPGLL,,,,*00"));
+  CHECK(frame.source == 7);
+  CHECK(frame.view() == "$GPGLL,,,,*00");
+  CHECK(!frame.assign(8, std::string(17, 'x')));
+  CHECK(frame.source == 7);
+}
+
+/**
+ * @brief One producer and one consumer see every element once, in order,
+ * through a ring much smaller than the stream, using both pop and drain.
+ */
+void spsc_order() {
+  static gps_lib::SpscRing<std::uint64_t, 64> ring;
+  constexpr std::uint64_t COUNT{1'000'000};
+
+  std::jthread producer{[] {
+    for (std::uint64_t i = 0; i < COUNT; ++i) {
+      ring.push(i);
+    }
+  }};
+
+  std::uint64_t expected = 0;
+  bool ordered = true;
+  while (expected < COUNT) {
+    std::uint64_t value = 0;
+    if (expected % 2 == 0 && ring.try_pop(value)) {
+      ordered = ordered && value == expected++;
+    }
+    if (ring.drain([&](std::uint64_t v) {
+          ordered = ordered && v == expected++;
+        }) == 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  CHECK(ordered);
+  CHECK(ring.size() == 0);
+
+  std::uint64_t value = 0;
+  CHECK(!ring.try_pop(value));
+}
+
+/**
+ * @brief A full ring refuses a push until the consumer makes room.
+ */
+void spsc_full() {
+  gps_lib::SpscRing<int, 4> ring;
+
+  for (int i = 0; i < 4; ++i) {
+    CHECK(ring.try_push(i));
+  }
+  CHECK(!ring.try_push(4));
+  CHECK(ring.size() == 4);
+
+  int value = -1;
+  CHECK(ring.try_pop(value) && value == 0);
+  CHECK(ring.try_push(4));
+  CHECK(ring.drain([](int) {}) == 4);
+}
+
+/**
+ * @brief Several producers push and one consumer drains: every element
+ * arrives exactly once and each producer's elements keep their order.
+ */
+void mpsc_many_producers() {
+  static gps_lib::MpscRing<std::uint64_t, 256> ring;
+
+  std::vector<std::jthread> producers;
+  for (std::uint64_t p = 0; p < PRODUCERS; ++p) {
+    producers.emplace_back([p] {
+      for (std::uint64_t i = 0; i < PER_PRODUCER; ++i) {
+        ring.push(p << 32 | i);
+      }
+    });
+  }
+
+  std::array<std::uint64_t, PRODUCERS> next{};
+  std::size_t received = 0;
+  bool ordered = true;
+  auto consume = [&](std::uint64_t value) {
+    std::uint64_t producer = value >> 32;
+    ordered = ordered && producer < PRODUCERS &&
+              (value & 0xFFFFFFFF) == next[producer]++;
+    ++received;
+  };
+
+  while (received < PRODUCERS * PER_PRODUCER) {
+    std::uint64_t value = 0;
+    if (received % 3 == 0 && ring.try_pop(value)) {
+      consume(value);
+    }
+    if (ring.drain(consume) == 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  CHECK(ordered);
+  CHECK(ring.empty());
+  for (std::uint64_t count : next) {
+    CHECK(count == PER_PRODUCER);
+  }
+}
+
+/**
+ * @brief Sentence frames cross an MPSC ring intact.
+ */
+void mpsc_frames() {
+  static gps_lib::MpscRing<gps_lib::SentenceFrame<>, 16> ring;
+  constexpr std::string_view SENTENCE{
+      "$GNGLL,4024.98796,N,00340.22512,W,211041.00,A,D*6F"};
+
+  std::vector<std::jthread> producers;
+  for (std::uint64_t p = 0; p < PRODUCERS; ++p) {
+    producers.emplace_back([p] {
+      gps_lib::SentenceFrame<> frame;
+      frame.assign(p, SENTENCE);
+      for (std::size_t i = 0; i < 1000; ++i) {
+        ring.push(frame);
+      }
+    });
+  }
+
+  std::size_t received = 0;
+  bool intact = true;
+  while (received < PRODUCERS * 1000) {
+    std::size_t drained =
+        ring.drain([&](const gps_lib::SentenceFrame<> &frame) {
+          intact =
+              intact && frame.source < PRODUCERS && frame.view() == SENTENCE;
+        });
+    if (drained == 0) {
+      std::this_thread::yield();
+    }
+    received += drained;
+  }
+
+  CHECK(intact);
+}
+} // namespace
+
+int main() {
+  sentence_frame();
+  spsc_order();
+  spsc_full();
+  mpsc_many_producers();
+  mpsc_frames();
+
+  return gps_lib::test::result();
+}
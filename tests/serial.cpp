@@ -0,0 +1,153 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include "check.h"
+#include "serial.h"
+
+namespace {
+/// Two valid sentences around one with a corrupted checksum.
+constexpr std::string_view SENTENCES{
+    "$GNRMC,211041.00,A,4024.98796,N,00340.22512,W,0.027,,010218,,,D*7B\r\n"
+    "$GNGSA,A,3,86,74,85,75,84,,,,,,,,1.66,1.01,1.32*14\r\n"
+    "$GNGSA,A,3,86,74,85,75,84,,,,,,,,1.66,1.01,1.32*13\r\n"};
+
+/**
+ * @brief Waits until a condition holds, for at most two seconds.
+ */
+template <typename Condition> bool eventually(Condition &&condition) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{2};
+
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  return true;
+}
+
+/**
+ * @brief Collects what a reader hands to its handler, from its thread.
+ */
+struct Received {
+  std::atomic<std::size_t> count{0};
+  std::vector<std::string> addresses;
+
+  void operator()(std::string_view line, const gps_lib::Sample &) {
+    addresses.emplace_back(line.substr(0, 6));
+    count.fetch_add(1, std::memory_order_release);
+  }
+};
+
+/**
+ * @brief Sentences split across writes are framed and parsed, and closing
+ * the controlling side ends the reading like unplugging a receiver.
+ */
+void split_writes_then_hangup() {
+  auto terminal = gps_lib::PseudoTerminal::open();
+  CHECK(terminal.has_value());
+  if (!terminal) {
+    return;
+  }
+
+  auto reader = gps_lib::SerialReader::open(terminal->device());
+  CHECK(reader.has_value());
+  if (!reader) {
+    return;
+  }
+
+  Received received;
+  std::optional<std::expected<gps_lib::SerialStats, std::error_code>> result;
+  std::jthread thread{[&] { result = reader->run(std::ref(received)); }};
+
+  for (std::size_t i = 0; i < SENTENCES.size(); i += 5) {
+    CHECK(terminal->write(SENTENCES.substr(i, 5)));
+    std::this_thread::sleep_for(std::chrono::microseconds{100});
+  }
+
+  CHECK(eventually([&] {
+    return received.count.load(std::memory_order_acquire) == 2;
+  }));
+  terminal->close();
+  thread.join();
+
+  CHECK(result && result->has_value());
+  if (!result || !*result) {
+    return;
+  }
+
+  const gps_lib::SerialStats &stats = **result;
+  CHECK(received.addresses == std::vector<std::string>{"$GNRMC", "$GNGSA"});
+  CHECK(stats.sentences == 2);
+  CHECK(stats.errors == 1);
+  CHECK(stats.dropped == 0);
+  CHECK(stats.bytes == SENTENCES.size());
+  CHECK(stats.reads >= 2);
+  CHECK(stats.latency.count == 2);
+  CHECK(stats.latency.min <= stats.latency.max);
+}
+
+/**
+ * @brief A stop request ends a reader that is waiting for data.
+ */
+void stop_while_idle() {
+  auto terminal = gps_lib::PseudoTerminal::open();
+  auto reader = terminal ? gps_lib::SerialReader::open(terminal->device())
+                         : std::unexpected{std::error_code{}};
+  CHECK(reader.has_value());
+  if (!reader) {
+    return;
+  }
+
+  Received received;
+  std::stop_source stop;
+  std::optional<std::expected<gps_lib::SerialStats, std::error_code>> result;
+  std::jthread thread{
+      [&] { result = reader->run(std::ref(received), stop.get_token()); }};
+
+  CHECK(terminal->write(SENTENCES.substr(0, SENTENCES.find('\n') + 1)));
+  CHECK(eventually([&] {
+    return received.count.load(std::memory_order_acquire) == 1;
+  }));
+
+  stop.request_stop();
+  thread.join();
+
+  CHECK(result && result->has_value() && (*result)->sentences == 1);
+}
+
+/**
+ * @brief Unsupported line speeds are rejected before touching the device.
+ */
+void invalid_speed() {
+  auto terminal = gps_lib::PseudoTerminal::open();
+  CHECK(terminal.has_value());
+  if (!terminal) {
+    return;
+  }
+
+  auto reader = gps_lib::SerialReader::open(terminal->device(), {.baud = 1234});
+  CHECK(!reader &&
+        reader.error() == std::make_error_code(std::errc::invalid_argument));
+}
+} // namespace
+
+int main() {
+  split_writes_then_hangup();
+  stop_while_idle();
+  invalid_speed();
+
+  return gps_lib::test::result();
+}
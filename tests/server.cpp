@@ -0,0 +1,158 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <netinet/in.h>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <variant>
+
+#include "check.h"
+#include "detail/file_descriptor.h"
+#include "detail/socket.h"
+#include "server.h"
+#include "uring.h"
+
+namespace {
+/**
+ * @brief Returns the first line of data/samples.txt with a given address.
+ */
+std::string first_sentence(std::string_view address) {
+  std::ifstream file{"data/samples.txt"};
+  std::string line;
+
+  while (std::getline(file, line)) {
+    if (line.starts_with(address)) {
+      return line + "\r\n";
+    }
+  }
+
+  return {};
+}
+
+/**
+ * @brief Waits until a condition holds, for at most two seconds.
+ */
+template <typename Condition> bool eventually(Condition &&condition) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{2};
+
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  return true;
+}
+
+/**
+ * @brief Counts GLL sentences dated by the RMC sentence of their source.
+ */
+struct DatedCounter {
+  std::atomic<std::size_t> *dated;
+
+  void operator()(std::uint64_t, std::string_view,
+                  const gps_lib::Sample &sample) const {
+    using namespace std::chrono;
+
+    if (const auto *gll = std::get_if<gps_lib::GLL>(&sample)) {
+      year_month_day date{floor<days>(gll->utc_time)};
+      if (date.year() == year{2018}) {
+        dated->fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Many short-lived UDP senders, each sending an RMC and a GLL
+ * sentence in one datagram. Every GLL must be dated by its own sender's RMC,
+ * and the workers must keep no more parse states than configured.
+ */
+template <template <typename> typename Server> void udp_senders() {
+  constexpr std::size_t SENDERS{1000};
+  constexpr std::size_t SOURCES{64};
+
+  std::atomic<std::size_t> dated{0};
+  gps_lib::ServerOptions options;
+  options.port = 0;
+  options.threads = 2;
+  options.tcp = false;
+  options.receive_buffer = 1 << 20;
+  options.udp_sources = SOURCES;
+
+  Server<DatedCounter> server{options, DatedCounter{&dated}};
+  CHECK(server.start().has_value());
+
+  auto address = gps_lib::detail::make_address("127.0.0.1", server.port());
+  std::string datagram = first_sentence("$GNRMC") + first_sentence("$GNGLL");
+
+  for (std::size_t i = 0; i < SENDERS; ++i) {
+    // Each sender has its own loopback address, so all sources differ.
+    auto source = gps_lib::detail::make_address(
+        "127.0." + std::to_string(i / 250) + "." + std::to_string(i % 250 + 1),
+        0);
+    gps_lib::detail::FileDescriptor sender{::socket(AF_INET, SOCK_DGRAM, 0)};
+    CHECK(::bind(sender.get(), reinterpret_cast<const sockaddr *>(&*source),
+                 sizeof(*source)) == 0);
+    ::sendto(sender.get(), datagram.data(), datagram.size(), 0,
+             reinterpret_cast<const sockaddr *>(&*address), sizeof(*address));
+
+    // Pace the senders so the receive buffer never overflows.
+    if (i % 100 == 99) {
+      CHECK(eventually([&] { return server.stats().datagrams == i + 1; }));
+    }
+  }
+
+  gps_lib::ServerStats stats = server.stats();
+  CHECK(stats.datagrams == SENDERS);
+  CHECK(stats.sentences == 2 * SENDERS);
+  CHECK(stats.errors == 0);
+  CHECK(dated.load() == SENDERS);
+  CHECK(stats.evictions >= SENDERS - options.threads * SOURCES);
+}
+
+/**
+ * @brief A TCP sender whose sentences arrive split across writes.
+ */
+template <template <typename> typename Server> void tcp_stream() {
+  std::atomic<std::size_t> dated{0};
+  gps_lib::ServerOptions options;
+  options.port = 0;
+  options.udp = false;
+
+  Server<DatedCounter> server{options, DatedCounter{&dated}};
+  CHECK(server.start().has_value());
+
+  auto address = gps_lib::detail::make_address("127.0.0.1", server.port());
+  gps_lib::detail::FileDescriptor sender{::socket(AF_INET, SOCK_STREAM, 0)};
+  CHECK(::connect(sender.get(), reinterpret_cast<const sockaddr *>(&*address),
+                  sizeof(*address)) == 0);
+
+  std::string stream = first_sentence("$GNRMC") + first_sentence("$GNGLL");
+  for (std::size_t i = 0; i < stream.size(); i += 7) {
+    std::string_view part = std::string_view{stream}.substr(i, 7);
+    CHECK(::write(sender.get(), part.data(), part.size()) ==
+          static_cast<ssize_t>(part.size()));
+    std::this_thread::sleep_for(std::chrono::microseconds{200});
+  }
+
+  CHECK(eventually([&] { return server.stats().sentences == 2; }));
+  CHECK(server.stats().connections == 1);
+  CHECK(dated.load() == 1);
+}
+} // namespace
+
+int main() {
+  udp_senders<gps_lib::IngestServer>();
+  tcp_stream<gps_lib::IngestServer>();
+  udp_senders<gps_lib::UringIngestServer>();
+  tcp_stream<gps_lib::UringIngestServer>();
+
+  return gps_lib::test::result();
+}
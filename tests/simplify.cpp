@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "check.h"
+#include "simplify.h"
+
+namespace {
+constexpr double ORIGIN_LATITUDE{40.4};   ///< Latitude of the test area.
+constexpr double ORIGIN_LONGITUDE{-3.67}; ///< Longitude of the test area.
+
+/**
+ * @brief Returns a fix at an offset from the origin of the test area.
+ * @param second The time in seconds, which identifies the fix.
+ * @param east The offset towards the east in meters.
+ * @param north The offset towards the north in meters.
+ * @return  gps_lib::Fix    The fix.
+ */
+gps_lib::Fix fix_at(int second, double east, double north) {
+  double meters = gps_lib::detail::EARTH_RADIUS * gps_lib::detail::DEGTORAD;
+  return {gps_lib::Timestamp{std::chrono::seconds{second}},
+          ORIGIN_LATITUDE + north / meters,
+          ORIGIN_LONGITUDE +
+              east / (meters *
+                      std::cos(ORIGIN_LATITUDE * gps_lib::detail::DEGTORAD)),
+          1.0, 1.0};
+}
+
+/**
+ * @brief Runs a track through a simplifier.
+ * @param simplifier The simplifier.
+ * @param track The fixes.
+ * @param flush Whether to flush after the last fix.
+ * @return  std::vector<gps_lib::Fix>   The vertices of the simplified track.
+ */
+template <std::size_t Capacity>
+std::vector<gps_lib::Fix>
+simplify(gps_lib::TrackSimplifier<Capacity> &simplifier,
+         const std::vector<gps_lib::Fix> &track, bool flush = true) {
+  std::vector<gps_lib::Fix> vertices;
+  auto emit = [&](const gps_lib::Fix &fix) { vertices.push_back(fix); };
+
+  for (const gps_lib::Fix &fix : track) {
+    simplifier.push(fix, emit);
+  }
+  if (flush) {
+    simplifier.flush(emit);
+  }
+  return vertices;
+}
+
+/**
+ * @brief Returns the distance from a fix to a segment, on the tangent plane
+ * of the start of the segment.
+ * @param fix The fix.
+ * @param from The start of the segment.
+ * @param to The end of the segment.
+ * @return  double  The distance in meters.
+ */
+double distance_to_segment(const gps_lib::Fix &fix, const gps_lib::Fix &from,
+                           const gps_lib::Fix &to) {
+  auto offset = [&](const gps_lib::Fix &point) {
+    return gps_lib::detail::local_offset(from.latitude, from.longitude,
+                                         point.latitude, point.longitude);
+  };
+  gps_lib::detail::Offset point = offset(fix);
+  gps_lib::detail::Offset end = offset(to);
+
+  double length = end.east * end.east + end.north * end.north;
+  double t = 0.0;
+  if (length > 0.0) {
+    t = std::clamp((point.east * end.east + point.north * end.north) / length,
+                   0.0, 1.0);
+  }
+  return std::hypot(point.east - t * end.east, point.north - t * end.north);
+}
+
+/**
+ * @brief Every dropped fix of a winding track lies within the tolerance of
+ * the segment between the vertices around it, and the track keeps its ends.
+ */
+void within_tolerance() {
+  constexpr double TOLERANCE{5.0};
+
+  std::vector<gps_lib::Fix> track;
+  for (int second = 0; second < 600; ++second) {
+    double t = second;
+    double east = 10.0 * t + 40.0 * std::sin(t / 20.0);
+    double north = 3.0 * std::sin(t / 3.0) + 60.0 * std::cos(t / 45.0);
+    track.push_back(fix_at(second, east, north));
+  }
+
+  gps_lib::TrackSimplifier<> simplifier{TOLERANCE};
+  std::vector<gps_lib::Fix> vertices = simplify(simplifier, track);
+
+  CHECK(vertices.size() > 2);
+  CHECK(vertices.size() < track.size() / 4);
+  CHECK(vertices.front().utc_time == track.front().utc_time);
+  CHECK(vertices.back().utc_time == track.back().utc_time);
+
+  std::size_t next = 0;
+  for (std::size_t v = 0; v + 1 < vertices.size(); ++v) {
+    while (next < track.size() &&
+           track[next].utc_time <= vertices[v + 1].utc_time) {
+      CHECK(distance_to_segment(track[next], vertices[v], vertices[v + 1]) <=
+            TOLERANCE + 1e-6);
+      ++next;
+    }
+  }
+  CHECK(next == track.size());
+}
+
+/**
+ * @brief A stationary receiver, even with jitter below the tolerance, is a
+ * single vertex until the track is flushed, which emits its last fix.
+ */
+void stationary() {
+  std::vector<gps_lib::Fix> track;
+  for (int second = 0; second < 100; ++second) {
+    track.push_back(fix_at(second, std::sin(second), std::cos(second)));
+  }
+
+  gps_lib::TrackSimplifier<> simplifier{5.0};
+  std::vector<gps_lib::Fix> vertices = simplify(simplifier, track, false);
+  CHECK(vertices.size() == 1);
+
+  simplifier.flush([&](const gps_lib::Fix &fix) { vertices.push_back(fix); });
+  CHECK(vertices.size() == 2 &&
+        vertices.back().utc_time == track.back().utc_time);
+}
+
+/**
+ * @brief On a straight line, which never leaves the tolerance, a full
+ * buffer forces a vertex every Capacity fixes.
+ */
+void full_buffer() {
+  constexpr std::size_t CAPACITY{4};
+
+  std::vector<gps_lib::Fix> track;
+  for (int second = 0; second <= 12; ++second) {
+    track.push_back(fix_at(second, 10.0 * second, 0.0));
+  }
+
+  gps_lib::TrackSimplifier<CAPACITY> simplifier{5.0};
+  std::vector<gps_lib::Fix> vertices = simplify(simplifier, track, false);
+
+  if (CHECK(vertices.size() == 3)) {
+    CHECK(vertices[0].utc_time == track[0].utc_time);
+    CHECK(vertices[1].utc_time == track[CAPACITY].utc_time);
+    CHECK(vertices[2].utc_time == track[2 * CAPACITY].utc_time);
+  }
+
+  // Without the limit the whole line is one segment.
+  gps_lib::TrackSimplifier<> unbounded{5.0};
+  CHECK(simplify(unbounded, track).size() == 2);
+}
+
+/**
+ * @brief Flushing emits the pending last fix once, then starts a new track.
+ */
+void flush() {
+  gps_lib::TrackSimplifier<> simplifier{5.0};
+  std::vector<gps_lib::Fix> vertices;
+  auto emit = [&](const gps_lib::Fix &fix) { vertices.push_back(fix); };
+
+  simplifier.flush(emit);
+  CHECK(vertices.empty());
+
+  simplifier.push(fix_at(0, 0.0, 0.0), emit);
+  simplifier.flush(emit);
+  CHECK(vertices.size() == 1);
+
+  simplifier.push(fix_at(1, 0.0, 0.0), emit);
+  simplifier.push(fix_at(2, 100.0, 0.0), emit);
+  simplifier.push(fix_at(3, 200.0, 0.0), emit);
+  simplifier.flush(emit);
+  simplifier.flush(emit);
+
+  if (CHECK(vertices.size() == 3)) {
+    CHECK(vertices[1].utc_time == fix_at(1, 0.0, 0.0).utc_time);
+    CHECK(vertices[2].utc_time == fix_at(3, 0.0, 0.0).utc_time);
+  }
+}
+} // namespace
+
+int main() {
+  within_tolerance();
+  stationary();
+  full_buffer();
+  flush();
+
+  return gps_lib::test::result();
+}
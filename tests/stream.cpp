@@ -0,0 +1,123 @@
+#include <cstddef>
+#include <expected>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <variant>
+#include <vector>
+
+#include "check.h"
+#include "detail/file_descriptor.h"
+#include "stream.h"
+
+namespace {
+using Result = std::expected<gps_lib::Sample, gps_lib::ParseError>;
+
+/**
+ * @brief Reads the sample log.
+ * @return  std::string     Its bytes.
+ */
+std::string read_samples() {
+  std::ifstream file{"data/samples.txt"};
+  std::stringstream log;
+  log << file.rdbuf();
+  return log.str();
+}
+
+/**
+ * @brief Writes bytes to a pipe from another thread in small uneven chunks,
+ * so lines straddle reads, and parses what the read end yields.
+ * @param bytes The bytes to send.
+ * @return  std::vector<Result>     The parsed sentences.
+ */
+std::vector<Result> parse_pipe(std::string_view bytes) {
+  int ends[2];
+  CHECK(::pipe(ends) == 0);
+  gps_lib::detail::FileDescriptor reader{ends[0]};
+
+  std::jthread writer{[bytes, fd = gps_lib::detail::FileDescriptor{ends[1]}] {
+    for (std::size_t i = 0, chunk = 1; i < bytes.size(); i += chunk) {
+      chunk = 1 + i % 97;
+      std::string_view part = bytes.substr(i, chunk);
+      if (::write(fd.get(), part.data(), part.size()) !=
+          static_cast<ssize_t>(part.size())) {
+        return;
+      }
+    }
+  }};
+
+  std::vector<Result> results;
+  for (auto &&result : gps_lib::parse_stream(reader.get())) {
+    results.push_back(std::move(result));
+  }
+
+  return results;
+}
+
+/**
+ * @brief A log sent through a pipe parses the same as read from a stream,
+ * including a last line without its line feed.
+ */
+void same_as_istream() {
+  std::string log = read_samples();
+  CHECK(!log.empty());
+  if (log.ends_with('\n')) {
+    log.pop_back();
+  }
+  log.insert(log.find('\n') + 1, "\r\n$GNRMC,corrupted*00\r\n");
+
+  std::istringstream input{log};
+  std::vector<Result> expected;
+  for (auto &&result : gps_lib::parse_stream(input)) {
+    expected.push_back(std::move(result));
+  }
+  std::vector<Result> results = parse_pipe(log);
+
+  CHECK(results.size() == expected.size());
+  CHECK(results.size() > 1000);
+
+  bool same = results.size() == expected.size();
+  std::size_t errors = 0;
+  for (std::size_t i = 0; same && i < results.size(); ++i) {
+    same = results[i].has_value() == expected[i].has_value() &&
+           (!results[i] || results[i]->index() == expected[i]->index());
+    errors += results[i] ? 0 : 1;
+  }
+  CHECK(same);
+  CHECK(errors == 1);
+  CHECK(results.back().has_value());
+
+  std::size_t rmc = 0;
+  for (const gps_lib::RMC &sentence :
+       parse_pipe(log) | gps_lib::filter_type<gps_lib::RMC>) {
+    rmc += sentence.latitude.value != 0.0 ? 1 : 0;
+  }
+  CHECK(rmc > 0);
+}
+
+/**
+ * @brief A line longer than the read buffer loses its beginning and fails
+ * to parse, and the stream carries on with the next line.
+ */
+void oversized_line() {
+  std::string bytes(5000, 'x');
+  bytes += "\n$GNGLL,4025.00283,N,00340.22044,W,215102.00,A,D*68\n";
+
+  std::vector<Result> results = parse_pipe(bytes);
+
+  CHECK(results.size() == 2);
+  CHECK(!results.empty() && !results.front());
+  CHECK(results.size() == 2 && results.back() &&
+        std::holds_alternative<gps_lib::GLL>(*results.back()));
+}
+} // namespace
+
+int main() {
+  same_as_istream();
+  oversized_line();
+
+  return gps_lib::test::result();
+}
@@ -0,0 +1,156 @@
+#include <chrono>
+#include <string_view>
+#include <variant>
+
+#include "check.h"
+#include "detail/parse_utc_date.h"
+#include "detail/parse_utc_time.h"
+#include "detail/stamp_time.h"
+#include "parse.h"
+
+using gps_lib::ParseError;
+using gps_lib::detail::parse_utc_date;
+using gps_lib::detail::parse_utc_time;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+// The kernels are constexpr, so their contracts are checked at compile time
+// too.
+static_assert(parse_utc_time("123519").value() == 12h + 35min + 19s);
+static_assert(parse_utc_time("123519.5").value() == 12h + 35min + 19s + 500ms);
+static_assert(parse_utc_time("123519.12345").value() ==
+              12h + 35min + 19s + 123ms);
+static_assert(parse_utc_time("").error() == ParseError::MissingFields);
+static_assert(parse_utc_time("123456.00X0").error() ==
+              ParseError::InvalidFormat);
+static_assert(parse_utc_date("230394").value() == sys_days{1994y / March / 23});
+static_assert(parse_utc_date("010180").value() == sys_days{1980y / 1 / 1});
+static_assert(parse_utc_date("311279").value() == sys_days{2079y / 12 / 31});
+static_assert(parse_utc_date("").error() == ParseError::MissingFields);
+
+namespace {
+/**
+ * @brief Times of day: fractions of any length, leap seconds, and fields
+ * that are out of range or not digits.
+ */
+void times() {
+  CHECK(parse_utc_time("000000") == 0ms);
+  CHECK(parse_utc_time("235960.999") == 23h + 59min + 60s + 999ms);
+  CHECK(parse_utc_time("123519.") == 12h + 35min + 19s);
+  CHECK(parse_utc_time("123519.05") == 12h + 35min + 19s + 50ms);
+  CHECK(parse_utc_time("123519.0509999") == 12h + 35min + 19s + 50ms);
+
+  for (std::string_view bad :
+       {"240000", "126000", "123561", "12351", "1235190", "12a519",
+        "123519.x", "123519.00X0", "123519.123X", "123519.0000-", "-23519"}) {
+    CHECK(parse_utc_time(bad).error() == ParseError::InvalidFormat);
+  }
+}
+
+/**
+ * @brief Dates: the two-digit year pivot, ZDA's split fields, and dates
+ * that do not exist or are malformed.
+ */
+void dates() {
+  CHECK(parse_utc_date("290224") == sys_days{2024y / February / 29});
+  CHECK(parse_utc_date("31", "12", "2079") == sys_days{2079y / 12 / 31});
+  CHECK(parse_utc_date("1", "7", "2002") == sys_days{2002y / 7 / 1});
+
+  for (std::string_view bad :
+       {"290223", "310424", "001224", "011324", "0112245", "01122", "0a1224",
+        "01-224"}) {
+    CHECK(parse_utc_date(bad).error() == ParseError::InvalidFormat);
+  }
+  CHECK(parse_utc_date("", "12", "2024").error() ==
+        ParseError::MissingFields);
+  CHECK(parse_utc_date("01", "12", "24").error() ==
+        ParseError::InvalidFormat);
+  CHECK(parse_utc_date("32", "12", "2024").error() ==
+        ParseError::InvalidFormat);
+  CHECK(parse_utc_date("01", "12", "20x4").error() ==
+        ParseError::InvalidFormat);
+}
+
+/**
+ * @brief The date moves forward only when the time of day goes back by
+ * more than twelve hours.
+ */
+void rollover() {
+  using gps_lib::detail::stamp_time;
+
+  gps_lib::ParseContext context;
+  sys_days day{2024y / December / 31};
+
+  CHECK(stamp_time(context, day, 23h) == day + 23h);
+  CHECK(stamp_time(context, 11h) == day + 11h);
+  CHECK(stamp_time(context, 23h) == day + 23h);
+  CHECK(stamp_time(context, 10h + 59min) == day + days{1} + 10h + 59min);
+  CHECK(context.date == day + days{1});
+
+  // Small steps back, such as a reordered sentence, keep the date.
+  CHECK(stamp_time(context, 10h) == day + days{1} + 10h);
+  CHECK(context.date == day + days{1});
+}
+
+/**
+ * @brief Returns the UTC time of a parsed sentence.
+ * @param line The sentence.
+ * @param context The stream state.
+ * @return  Timestamp   The time, or the epoch if parsing failed or the
+ * sentence has no time.
+ */
+gps_lib::Timestamp time_of(std::string_view line,
+                           gps_lib::ParseContext &context) {
+  auto sample = gps_lib::parse(line, context);
+  if (!CHECK(sample.has_value())) {
+    return {};
+  }
+  return std::visit(
+      [](const auto &data) -> gps_lib::Timestamp {
+        if constexpr (requires { data.utc_time; }) {
+          return data.utc_time;
+        }
+        return {};
+      },
+      *sample);
+}
+
+/**
+ * @brief Sentences without a date take the date of the last RMC, roll over
+ * at midnight, and fall back to 1970-01-01 before any date is known. An RMC
+ * without a date is rejected.
+ */
+void stream() {
+  gps_lib::ParseContext context;
+  sys_days day{2024y / December / 31};
+
+  CHECK(time_of("$GNGLL,4025.00283,N,00340.22044,W,215102.00,A,D*68",
+                context) == sys_days{} + 21h + 51min + 2s);
+  CHECK(time_of("$GNRMC,235959.00,A,4024.98796,N,00340.22512,W,0.027,,"
+                "311224,,,D*70",
+                context) == day + 23h + 59min + 59s);
+  CHECK(time_of("$GNGLL,4025.00283,N,00340.22044,W,000001.00,A,D*6C",
+                context) == day + days{1} + 1s);
+  CHECK(time_of("$GNGLL,4025.00283,N,00340.22044,W,120001.00,A,D*6F",
+                context) == day + days{1} + 12h + 1s);
+  CHECK(time_of("$GNGLL,4025.00283,N,00340.22044,W,110000.00,A,D*6D",
+                context) == day + days{1} + 11h);
+
+  CHECK(gps_lib::parse("$GNRMC,235959.00,A,4024.98796,N,00340.22512,W,0.027,"
+                       ",,,,D*77",
+                       context)
+            .error() == ParseError::MissingFields);
+  CHECK(gps_lib::parse("$GNGLL,4025.00283,N,00340.22044,W,123456.00X0,A,D*02",
+                       context)
+            .error() == ParseError::InvalidFormat);
+}
+} // namespace
+
+int main() {
+  times();
+  dates();
+  rollover();
+  stream();
+
+  return gps_lib::test::result();
+}
@@ -0,0 +1,196 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "check.h"
+#include "parse.h"
+#include "trace.h"
+
+#ifndef GPS_LIB_TRACE
+#error "This test needs GPS_LIB_TRACE"
+#endif
+
+namespace {
+using gps_lib::detail::TraceRing;
+
+/**
+ * @brief A span as read back from the Chrome trace.
+ */
+struct Span {
+  std::string name;  ///< Span name.
+  std::uint32_t tid; ///< Index of the recording thread.
+  double ts;         ///< Start in microseconds.
+  double dur;        ///< Length in microseconds.
+};
+
+/**
+ * @brief Dumps the trace and reads back its Chrome trace conversion.
+ * @return  std::vector<Span>   The spans, in file order.
+ */
+std::vector<Span> dump() {
+  std::filesystem::path directory = std::filesystem::temp_directory_path();
+  std::filesystem::path binary = directory / "gps_lib_test_trace.bin";
+  std::filesystem::path json = directory / "gps_lib_test_trace.json";
+
+  std::vector<Span> spans;
+  if (!CHECK(gps_lib::save_trace(binary)) ||
+      !CHECK(gps_lib::trace_to_chrome_json(binary, json))) {
+    return spans;
+  }
+
+  std::ifstream in{json};
+  nlohmann::json trace = nlohmann::json::parse(in, nullptr, false);
+  if (CHECK(trace.is_object() && trace["traceEvents"].is_array())) {
+    for (const nlohmann::json &event : trace["traceEvents"]) {
+      CHECK(event["ph"] == "X" && event["pid"] == 1);
+      spans.push_back({event["name"].get<std::string>(),
+                       event["tid"].get<std::uint32_t>(),
+                       event["ts"].get<double>(), event["dur"].get<double>()});
+    }
+  }
+
+  std::filesystem::remove(binary);
+  std::filesystem::remove(json);
+  return spans;
+}
+
+/**
+ * @brief Counts the spans with a name, on any thread.
+ * @param spans The spans.
+ * @param name The span name.
+ * @return  std::size_t     The number of spans.
+ */
+std::size_t count(const std::vector<Span> &spans, std::string_view name) {
+  std::size_t total = 0;
+  for (const Span &span : spans) {
+    total += span.name == name;
+  }
+  return total;
+}
+
+/**
+ * @brief Parsing a sentence records the spans of its stages, nested inside
+ * the parse span.
+ */
+void parse_spans() {
+  CHECK(gps_lib::parse(
+            "$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,"
+            "M,,*76")
+            .has_value());
+
+  std::vector<Span> spans = dump();
+  CHECK(count(spans, "parse") == 1);
+  CHECK(count(spans, "is_valid_sample") == 1);
+  CHECK(count(spans, "tokenize") == 1);
+  CHECK(count(spans, "parse_gga") == 1);
+
+  const Span *parse = nullptr;
+  for (const Span &span : spans) {
+    if (span.name == "parse") {
+      parse = &span;
+    }
+  }
+  if (!CHECK(parse != nullptr)) {
+    return;
+  }
+  for (const Span &span : spans) {
+    CHECK(span.tid == parse->tid);
+    // The conversion rounds to the nanosecond.
+    CHECK(span.ts >= parse->ts);
+    CHECK(span.ts + span.dur <= parse->ts + parse->dur + 1e-6);
+  }
+}
+
+/**
+ * @brief A full ring keeps the most recent CAPACITY spans, oldest first.
+ */
+void wraparound() {
+  constexpr std::size_t TAIL{100};
+
+  std::jthread{[] {
+    for (std::size_t i = 0; i < TraceRing::CAPACITY; ++i) {
+      GPS_LIB_TRACE_SCOPE("old");
+    }
+    for (std::size_t i = 0; i < TAIL; ++i) {
+      GPS_LIB_TRACE_SCOPE("new");
+    }
+  }}.join();
+  std::vector<Span> spans = dump();
+
+  std::uint32_t tid = spans.empty() ? 0 : spans.back().tid;
+  std::vector<Span> ring;
+  for (const Span &span : spans) {
+    if (span.tid == tid) {
+      ring.push_back(span);
+    }
+  }
+
+  if (CHECK(ring.size() == TraceRing::CAPACITY)) {
+    CHECK(count(ring, "old") == TraceRing::CAPACITY - TAIL);
+    CHECK(count(ring, "new") == TAIL);
+    for (std::size_t i = 0; i < ring.size(); ++i) {
+      CHECK(ring[i].name == (i < TraceRing::CAPACITY - TAIL ? "old" : "new"));
+      CHECK(i == 0 || ring[i].ts >= ring[i - 1].ts);
+    }
+  }
+}
+
+/**
+ * @brief The ring of an exited thread is emptied by the dump and handed to
+ * the next thread, so its spans are not exported twice.
+ */
+void ring_reuse() {
+  std::jthread{[] { GPS_LIB_TRACE_SCOPE("first"); }}.join();
+  std::vector<Span> first = dump();
+
+  std::jthread{[] { GPS_LIB_TRACE_SCOPE("second"); }}.join();
+  std::vector<Span> second = dump();
+
+  if (CHECK(count(first, "first") == 1 && count(second, "second") == 1)) {
+    CHECK(count(second, "first") == 0);
+
+    std::uint32_t tid = 0;
+    for (const Span &span : second) {
+      if (span.name == "second") {
+        tid = span.tid;
+      }
+    }
+    for (const Span &span : first) {
+      if (span.name == "first") {
+        CHECK(span.tid == tid);
+      }
+    }
+  }
+}
+
+/**
+ * @brief A file that is not a binary trace is not converted.
+ */
+void malformed() {
+  std::filesystem::path directory = std::filesystem::temp_directory_path();
+  std::filesystem::path binary = directory / "gps_lib_test_trace.bin";
+  std::filesystem::path json = directory / "gps_lib_test_trace.json";
+
+  std::ofstream{binary} << "GPSTRAC0";
+  CHECK(!gps_lib::trace_to_chrome_json(binary, json));
+
+  std::filesystem::remove(binary);
+  std::filesystem::remove(json);
+}
+} // namespace
+
+int main() {
+  parse_spans();
+  wraparound();
+  ring_reuse();
+  malformed();
+
+  return gps_lib::test::result();
+}
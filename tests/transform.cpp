@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "check.h"
+#include "transform.h"
+
+namespace {
+/**
+ * @brief A position with its ECEF coordinates, from PROJ (EPSG:4979 to
+ * EPSG:4978).
+ */
+struct EcefPoint {
+  double latitude;  ///< Latitude in decimal degrees.
+  double longitude; ///< Longitude in decimal degrees.
+  double height;    ///< Height above the ellipsoid in meters.
+  double x;         ///< ECEF X in meters.
+  double y;         ///< ECEF Y in meters.
+  double z;         ///< ECEF Z in meters.
+};
+
+/**
+ * @brief ECEF reference values.
+ */
+constexpr std::array<EcefPoint, 4> ECEF_POINTS{
+    {{0.0, 0.0, 0.0, 6378137.0, 0.0, 0.0},
+     {90.0, 0.0, 0.0, 0.0, 0.0, 6356752.3142},
+     {40.4, -3.67, 650.0, 4854558.5567, -311377.8353, 4112331.0799},
+     {-33.8568, 151.2153, 40.0, -4646997.7502, 2553092.9150, -3533289.4123}}};
+
+/**
+ * @brief A position with its UTM coordinates. The CN Tower is the worked
+ * example of the UTM article on Wikipedia; the millimeters, and the other
+ * points, come from PROJ.
+ */
+struct UtmPoint {
+  double latitude;  ///< Latitude in decimal degrees.
+  double longitude; ///< Longitude in decimal degrees.
+  int zone;         ///< UTM zone number.
+  bool north;       ///< Northern hemisphere.
+  double easting;   ///< Easting in meters.
+  double northing;  ///< Northing in meters.
+};
+
+/**
+ * @brief UTM reference values, including a point in the widened zone 32.
+ */
+constexpr std::array<UtmPoint, 4> UTM_POINTS{
+    {{43.642567, -79.387139, 17, true, 630084.301, 4833438.586},
+     {-33.8568, 151.2153, 56, false, 334900.570, 6252288.753},
+     {48.8583, 2.2945, 31, true, 448251.898, 5411943.794},
+     {60.0, 11.9, 32, true, 661720.751, 6654956.720}}};
+
+/**
+ * @brief Geodetic positions convert to the reference ECEF coordinates and
+ * back.
+ */
+void ecef_reference() {
+  for (const EcefPoint &point : ECEF_POINTS) {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+    gps_lib::geodetic_to_ecef(std::span{&point.latitude, 1},
+                              std::span{&point.longitude, 1},
+                              std::span{&point.height, 1}, std::span{&x, 1},
+                              std::span{&y, 1}, std::span{&z, 1});
+    CHECK(std::abs(x - point.x) < 1e-3);
+    CHECK(std::abs(y - point.y) < 1e-3);
+    CHECK(std::abs(z - point.z) < 1e-3);
+
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double height = 0.0;
+    gps_lib::ecef_to_geodetic(std::span{&point.x, 1}, std::span{&point.y, 1},
+                              std::span{&point.z, 1}, std::span{&latitude, 1},
+                              std::span{&longitude, 1},
+                              std::span{&height, 1});
+    CHECK(std::abs(latitude - point.latitude) < 1e-9);
+    CHECK(std::abs(height - point.height) < 1e-3);
+    if (std::abs(point.latitude) < 90.0) {
+      CHECK(std::abs(longitude - point.longitude) < 1e-9);
+    }
+  }
+}
+
+/**
+ * @brief Geodetic to ECEF to geodetic returns the positions of a global
+ * grid, from below sea level to low Earth orbit.
+ */
+void ecef_round_trip() {
+  gps_lib::GeodeticBatch batch;
+  for (double latitude = -89.5; latitude <= 89.5; latitude += 7.0) {
+    for (double longitude = -179.5; longitude < 180.0; longitude += 11.0) {
+      for (double height : {-430.0, 0.0, 8848.0, 400000.0}) {
+        batch.push_back(latitude, longitude, height);
+      }
+    }
+  }
+
+  std::size_t size = batch.size();
+  std::vector<double> x(size), y(size), z(size);
+  std::vector<double> latitude(size), longitude(size), height(size);
+  gps_lib::geodetic_to_ecef(batch.latitude, batch.longitude, batch.height, x,
+                            y, z);
+  gps_lib::ecef_to_geodetic(x, y, z, latitude, longitude, height);
+
+  double worst_angle = 0.0;
+  double worst_height = 0.0;
+  for (std::size_t i = 0; i < size; ++i) {
+    worst_angle = std::max({worst_angle,
+                            std::abs(latitude[i] - batch.latitude[i]),
+                            std::abs(longitude[i] - batch.longitude[i])});
+    worst_height =
+        std::max(worst_height, std::abs(height[i] - batch.height[i]));
+  }
+
+  // 1e-9 degrees is about 0.1 mm on the ground.
+  CHECK(worst_angle < 1e-9);
+  CHECK(worst_height < 1e-4);
+}
+
+/**
+ * @brief ENU offsets convert to ECEF and back, keep their lengths, and a
+ * point straight above the reference is straight up.
+ */
+void enu_round_trip() {
+  gps_lib::EnuFrame frame{40.4, -3.67, 650.0};
+
+  std::vector<double> east{0.0, 100.0, -2500.0, 12.5, 0.0};
+  std::vector<double> north{0.0, -40.0, 3100.0, 0.0, 7.0};
+  std::vector<double> up{0.0, 3.0, -120.0, 0.0, -7.0};
+  std::size_t size = east.size();
+
+  std::vector<double> x(size), y(size), z(size);
+  std::vector<double> east2(size), north2(size), up2(size);
+  frame.to_ecef(east, north, up, x, y, z);
+  frame.from_ecef(x, y, z, east2, north2, up2);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    CHECK(std::abs(east2[i] - east[i]) < 1e-6);
+    CHECK(std::abs(north2[i] - north[i]) < 1e-6);
+    CHECK(std::abs(up2[i] - up[i]) < 1e-6);
+
+    double length = std::hypot(east[i], north[i], up[i]);
+    double distance = std::hypot(x[i] - x[0], y[i] - y[0], z[i] - z[0]);
+    CHECK(std::abs(distance - length) < 1e-6);
+  }
+
+  gps_lib::GeodeticBatch batch;
+  batch.push_back(40.4, -3.67, 650.0);
+  batch.push_back(40.4, -3.67, 750.0);
+  std::vector<double> e(2), n(2), u(2);
+  frame.from_geodetic(batch, e, n, u);
+
+  CHECK(std::abs(e[0]) < 1e-6 && std::abs(n[0]) < 1e-6 &&
+        std::abs(u[0]) < 1e-6);
+  CHECK(std::abs(e[1]) < 1e-6 && std::abs(n[1]) < 1e-6 &&
+        std::abs(u[1] - 100.0) < 1e-6);
+}
+
+/**
+ * @brief UTM forward and inverse projections match the reference values to
+ * the millimeter.
+ */
+void utm_reference() {
+  for (const UtmPoint &point : UTM_POINTS) {
+    gps_lib::UtmZone zone = gps_lib::UtmZone::containing(point.latitude,
+                                                         point.longitude);
+    CHECK(zone.zone() == point.zone);
+    CHECK(zone.north() == point.north);
+
+    double easting = 0.0;
+    double northing = 0.0;
+    zone.forward(std::span{&point.latitude, 1}, std::span{&point.longitude, 1},
+                 std::span{&easting, 1}, std::span{&northing, 1});
+    CHECK(std::abs(easting - point.easting) < 1e-3);
+    CHECK(std::abs(northing - point.northing) < 1e-3);
+
+    double latitude = 0.0;
+    double longitude = 0.0;
+    zone.inverse(std::span{&point.easting, 1}, std::span{&point.northing, 1},
+                 std::span{&latitude, 1}, std::span{&longitude, 1});
+    CHECK(std::abs(latitude - point.latitude) < 1e-8);
+    CHECK(std::abs(longitude - point.longitude) < 1e-8);
+  }
+}
+
+/**
+ * @brief Returns the zone number of a position.
+ * @param latitude The latitude in decimal degrees.
+ * @param longitude The longitude in decimal degrees.
+ * @return  int     The zone number.
+ */
+int zone_of(double latitude, double longitude) {
+  return gps_lib::UtmZone::containing(latitude, longitude).zone();
+}
+
+/**
+ * @brief Zones follow the 6 degree grid, except around south-west Norway,
+ * where zone 32 is widened, and Svalbard, which only uses zones 31, 33, 35
+ * and 37.
+ */
+void utm_zones() {
+  CHECK(zone_of(0.0, -180.0) == 1);
+  CHECK(zone_of(0.0, 179.99) == 60);
+  CHECK(zone_of(0.0, 180.0) == 60);
+  CHECK(zone_of(0.0, 2.99) == 31);
+  CHECK(zone_of(0.0, 3.0) == 31);
+  CHECK(zone_of(0.0, 6.0) == 32);
+
+  // Norway: zone 32 starts at 3 degrees between 56 and 64 degrees north.
+  CHECK(zone_of(55.99, 4.0) == 31);
+  CHECK(zone_of(56.0, 2.99) == 31);
+  CHECK(zone_of(56.0, 3.0) == 32);
+  CHECK(zone_of(63.99, 4.0) == 32);
+  CHECK(zone_of(64.0, 4.0) == 31);
+  CHECK(zone_of(60.0, 11.99) == 32);
+  CHECK(zone_of(60.0, 12.0) == 33);
+  CHECK(zone_of(-60.0, 4.0) == 31);
+
+  // Svalbard: 72 to 84 degrees north, 0 to 42 degrees east.
+  CHECK(zone_of(71.99, 10.0) == 32);
+  CHECK(zone_of(72.0, 8.99) == 31);
+  CHECK(zone_of(72.0, 9.0) == 33);
+  CHECK(zone_of(78.0, 20.99) == 33);
+  CHECK(zone_of(78.0, 21.0) == 35);
+  CHECK(zone_of(78.0, 32.99) == 35);
+  CHECK(zone_of(78.0, 33.0) == 37);
+  CHECK(zone_of(83.99, 41.99) == 37);
+  CHECK(zone_of(78.0, 42.0) == 38);
+  CHECK(zone_of(84.0, 10.0) == 32);
+  CHECK(zone_of(78.0, -0.01) == 30);
+}
+} // namespace
+
+int main() {
+  ecef_reference();
+  ecef_round_trip();
+  enu_round_trip();
+  utm_reference();
+  utm_zones();
+
+  return gps_lib::test::result();
+}